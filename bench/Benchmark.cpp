@@ -0,0 +1,263 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace bench {
+    namespace {
+        /**
+         * @brief Retrieves the registry of benchmarks.
+         * @return The registered benchmarks in registration order.
+         */
+        std::vector<std::unique_ptr<Registration> > &registry() {
+            static std::vector<std::unique_ptr<Registration> > registrations;
+            return registrations;
+        }
+
+        /**
+         * @brief Builds the display name of a benchmark instance.
+         * @param name Name of the benchmark function.
+         * @param arguments Arguments of the instance.
+         * @return The name followed by the arguments, separated by slashes.
+         */
+        std::string instanceName(const std::string &name, const std::vector<long> &arguments) {
+            std::string result = name;
+            for (const long argument: arguments) result += "/" + std::to_string(argument);
+            return result;
+        }
+
+        /**
+         * @brief Formats a rate with a metric suffix.
+         * @param perSecond The rate per second.
+         * @return The rate, e.g. "12.3M/s".
+         */
+        std::string formatRate(const double perSecond) {
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(2);
+            if (perSecond >= 1e9) text << perSecond / 1e9 << "G/s";
+            else if (perSecond >= 1e6) text << perSecond / 1e6 << "M/s";
+            else if (perSecond >= 1e3) text << perSecond / 1e3 << "k/s";
+            else text << perSecond << "/s";
+            return text.str();
+        }
+    }
+
+    /**
+     * @brief Constructs an iterator over the given number of iterations.
+     * @param state The owning state, or nullptr for the end iterator.
+     * @param remaining Iterations left to run.
+     */
+    State::Iterator::Iterator(State *state, const std::uint64_t remaining) : state(state), remaining(remaining) {}
+
+    /**
+     * @brief Advances to the next iteration.
+     * @return This iterator.
+     */
+    State::Iterator &State::Iterator::operator++() {
+        --remaining;
+        return *this;
+    }
+
+    /**
+     * @brief Checks whether iterations remain; stops the timer once they are exhausted.
+     * @param other The end iterator.
+     * @return True while iterations remain.
+     */
+    bool State::Iterator::operator!=(const Iterator &other) {
+        (void) other;
+        if (remaining != 0) return true;
+        state->pauseTiming();
+        return false;
+    }
+
+    /**
+     * @brief Constructs a state for one run.
+     * @param arguments Arguments of the benchmark instance.
+     * @param iterationCount Number of iterations to run.
+     */
+    State::State(std::vector<long> arguments, const std::uint64_t iterationCount)
+        : arguments(std::move(arguments)), iterationCount(iterationCount) {}
+
+    /**
+     * @brief Retrieves a benchmark argument.
+     * @param index Position of the argument.
+     * @return The argument value.
+     * @throw std::out_of_range If the benchmark has no argument at that position.
+     */
+    long State::range(const std::size_t index) const {
+        return arguments.at(index);
+    }
+
+    /**
+     * @brief Starts the benchmark loop and the timer.
+     * @return Iterator over the requested iterations.
+     */
+    State::Iterator State::begin() {
+        resumeTiming();
+        return {this, iterationCount};
+    }
+
+    /**
+     * @brief End sentinel of the benchmark loop.
+     * @return The end iterator.
+     */
+    State::Iterator State::end() {
+        return {nullptr, 0};
+    }
+
+    /**
+     * @brief Stops the timer, e.g. while rebuilding fixtures.
+     */
+    void State::pauseTiming() {
+        if (!timing) return;
+        elapsed += Clock::now() - startedAt;
+        timing = false;
+    }
+
+    /**
+     * @brief Restarts the timer after pauseTiming().
+     */
+    void State::resumeTiming() {
+        if (timing) return;
+        startedAt = Clock::now();
+        timing = true;
+    }
+
+    /**
+     * @brief Sets the number of items processed, reported as items per second.
+     * @param items Items processed over all iterations.
+     */
+    void State::setItemsProcessed(const std::uint64_t items) {
+        itemsProcessed = items;
+    }
+
+    /**
+     * @brief Sets a custom counter reported with the results.
+     * @param name Name of the counter.
+     * @param value Value of the counter.
+     */
+    void State::setCounter(const std::string &name, const double value) {
+        counters[name] = value;
+    }
+
+    /**
+     * @brief Constructs a registration.
+     * @param name Name of the benchmark function.
+     * @param function The benchmark function.
+     */
+    Registration::Registration(std::string name, std::function<void(State &)> function)
+        : name(std::move(name)), function(std::move(function)) {}
+
+    /**
+     * @brief Adds an instance with a single argument.
+     * @param argument The argument value.
+     * @return This registration, for chaining.
+     */
+    Registration *Registration::arg(const long argument) {
+        argumentSets.push_back({argument});
+        return this;
+    }
+
+    /**
+     * @brief Adds an instance with several arguments.
+     * @param arguments The argument values.
+     * @return This registration, for chaining.
+     */
+    Registration *Registration::args(std::vector<long> arguments) {
+        argumentSets.push_back(std::move(arguments));
+        return this;
+    }
+
+    /**
+     * @brief Registers a benchmark function.
+     * @param name Name of the benchmark.
+     * @param function The benchmark function.
+     * @return The registration, to add argument sets to.
+     */
+    Registration *registerBenchmark(const std::string &name, std::function<void(State &)> function) {
+        registry().push_back(std::make_unique<Registration>(name, std::move(function)));
+        return registry().back().get();
+    }
+
+    /**
+     * @brief Runs all registered benchmarks matching the command-line filter.
+     * @param argc Number of command-line arguments.
+     * @param argv Command-line arguments: --filter SUBSTRING, --min-time SECONDS.
+     * @return 0 on success, 1 on invalid arguments or a failing benchmark.
+     */
+    int runRegistered(const int argc, char *argv[]) {
+        std::string filter;
+        double minimumSeconds = 0.2;
+        for (int index = 1; index < argc; ++index) {
+            const std::string argument = argv[index];
+            if (argument == "--filter" && index + 1 < argc) {
+                filter = argv[++index];
+            } else if (argument == "--min-time" && index + 1 < argc) {
+                minimumSeconds = std::stod(argv[++index]);
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--filter SUBSTRING] [--min-time SECONDS]\n";
+                return 1;
+            }
+        }
+
+        // The simulation reports to std::cout; results go to the original buffer while it is silenced.
+        std::ostream results(std::cout.rdbuf());
+        std::cout.rdbuf(nullptr);
+
+        results << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(14) << "Time"
+                << std::setw(14) << "Iterations" << "  Counters\n" << std::string(96, '-') << "\n";
+        int status = 0;
+        for (const auto &registration: registry()) {
+            auto argumentSets = registration->getArgumentSets();
+            if (argumentSets.empty()) argumentSets.emplace_back();
+            for (const auto &arguments: argumentSets) {
+                const auto name = instanceName(registration->getName(), arguments);
+                if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+                try {
+                    std::uint64_t iterations = 1;
+                    while (true) {
+                        State state(arguments, iterations);
+                        registration->getFunction()(state);
+                        const double seconds = std::chrono::duration<double>(state.getElapsed()).count();
+                        if (seconds < minimumSeconds && iterations < 1000000000ULL) {
+                            const double target = seconds > 0 ? minimumSeconds / seconds * 1.4 : 10.0;
+                            iterations = static_cast<std::uint64_t>(
+                                static_cast<double>(iterations) * std::min(std::max(target, 2.0), 10.0));
+                            continue;
+                        }
+                        const double nanosecondsPerIteration = seconds * 1e9 / static_cast<double>(iterations);
+                        results << std::left << std::setw(48) << name << std::right << std::setw(11)
+                                << std::fixed << std::setprecision(1) << nanosecondsPerIteration << " ns"
+                                << std::setw(14) << iterations << " ";
+                        if (state.getItemsProcessed() > 0 && seconds > 0) {
+                            results << " items=" << formatRate(static_cast<double>(state.getItemsProcessed()) / seconds);
+                        }
+                        for (const auto &[counterName, value]: state.getCounters()) {
+                            results << " " << counterName << "=" << std::setprecision(3) << value;
+                        }
+                        results << "\n";
+                        break;
+                    }
+                } catch (const std::exception &e) {
+                    results << std::left << std::setw(48) << name << " ERROR: " << e.what() << "\n";
+                    status = 1;
+                }
+            }
+        }
+        std::cout.rdbuf(results.rdbuf());
+        return status;
+    }
+}
+
+/**
+ * @brief Entry point of the benchmark executable.
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments (see bench::runRegistered).
+ * @return 0 on success, 1 on failure.
+ */
+int main(const int argc, char *argv[]) {
+    return bench::runRegistered(argc, argv);
+}
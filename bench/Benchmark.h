@@ -0,0 +1,215 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal microbenchmark harness modelled on Google Benchmark.
+ *
+ * Benchmarks are functions taking a State and looping with `for (auto _ : state)`. The harness grows the
+ * iteration count until a run lasts at least the minimum time, then reports the time per iteration,
+ * the throughput and any custom counters. Benchmarks register themselves with the BENCHMARK macro.
+ */
+namespace bench {
+    /**
+     * @brief Per-run state handed to a benchmark function.
+     */
+    class State {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Iterator driving the benchmark loop; counts down the requested iterations.
+         */
+        class Iterator {
+        public:
+            /// @brief Value of the loop variable; marked unused so `for (auto _ : state)` does not warn.
+            struct
+#if defined(__GNUC__) || defined(__clang__)
+            __attribute__((unused))
+#endif
+            Value {
+            };
+
+        private:
+            State *state; ///< Owning state; null for the end iterator.
+            std::uint64_t remaining; ///< Iterations left to run.
+        public:
+            /**
+             * @brief Constructs an iterator over the given number of iterations.
+             * @param state The owning state, or nullptr for the end iterator.
+             * @param remaining Iterations left to run.
+             */
+            Iterator(State *state, std::uint64_t remaining);
+
+            /// @brief Dereferences to a dummy value; the loop variable is unused.
+            Value operator*() const { return {}; }
+
+            /**
+             * @brief Advances to the next iteration.
+             * @return This iterator.
+             */
+            Iterator &operator++();
+
+            /**
+             * @brief Checks whether iterations remain; stops the timer once they are exhausted.
+             * @param other The end iterator.
+             * @return True while iterations remain.
+             */
+            bool operator!=(const Iterator &other);
+        };
+
+    private:
+        std::vector<long> arguments; ///< Arguments of this benchmark instance.
+        std::uint64_t iterationCount; ///< Number of iterations requested.
+        Clock::duration elapsed{}; ///< Accumulated timed duration.
+        Clock::time_point startedAt{}; ///< Start of the current timed section.
+        bool timing = false; ///< Whether the timer is running.
+        std::uint64_t itemsProcessed = 0; ///< Items processed, used for throughput.
+        std::map<std::string, double> counters; ///< Custom counters reported alongside the timings.
+
+    public:
+        /**
+         * @brief Constructs a state for one run.
+         * @param arguments Arguments of the benchmark instance.
+         * @param iterationCount Number of iterations to run.
+         */
+        State(std::vector<long> arguments, std::uint64_t iterationCount);
+
+        /**
+         * @brief Retrieves a benchmark argument.
+         * @param index Position of the argument.
+         * @return The argument value.
+         * @throw std::out_of_range If the benchmark has no argument at that position.
+         */
+        [[nodiscard]] long range(std::size_t index) const;
+
+        /// @brief Number of iterations requested for this run.
+        [[nodiscard]] std::uint64_t iterations() const { return iterationCount; }
+
+        /**
+         * @brief Starts the benchmark loop and the timer.
+         * @return Iterator over the requested iterations.
+         */
+        Iterator begin();
+
+        /**
+         * @brief End sentinel of the benchmark loop.
+         * @return The end iterator.
+         */
+        Iterator end();
+
+        /// @brief Stops the timer, e.g. while rebuilding fixtures.
+        void pauseTiming();
+
+        /// @brief Restarts the timer after pauseTiming().
+        void resumeTiming();
+
+        /**
+         * @brief Sets the number of items processed, reported as items per second.
+         * @param items Items processed over all iterations.
+         */
+        void setItemsProcessed(std::uint64_t items);
+
+        /**
+         * @brief Sets a custom counter reported with the results.
+         * @param name Name of the counter.
+         * @param value Value of the counter.
+         */
+        void setCounter(const std::string &name, double value);
+
+        /// @brief Timed duration of the run.
+        [[nodiscard]] Clock::duration getElapsed() const { return elapsed; }
+
+        /// @brief Items processed over the run.
+        [[nodiscard]] std::uint64_t getItemsProcessed() const { return itemsProcessed; }
+
+        /// @brief Custom counters of the run.
+        [[nodiscard]] const std::map<std::string, double> &getCounters() const { return counters; }
+    };
+
+    /**
+     * @brief A registered benchmark function with its argument sets.
+     */
+    class Registration {
+    private:
+        std::string name; ///< Name of the benchmark function.
+        std::function<void(State &)> function; ///< The benchmark function.
+        std::vector<std::vector<long> > argumentSets; ///< Argument sets; each one is a separate instance.
+    public:
+        /**
+         * @brief Constructs a registration.
+         * @param name Name of the benchmark function.
+         * @param function The benchmark function.
+         */
+        Registration(std::string name, std::function<void(State &)> function);
+
+        /**
+         * @brief Adds an instance with a single argument.
+         * @param argument The argument value.
+         * @return This registration, for chaining.
+         */
+        Registration *arg(long argument);
+
+        /**
+         * @brief Adds an instance with several arguments.
+         * @param arguments The argument values.
+         * @return This registration, for chaining.
+         */
+        Registration *args(std::vector<long> arguments);
+
+        /// @brief Name of the benchmark function.
+        [[nodiscard]] const std::string &getName() const { return name; }
+
+        /// @brief The benchmark function.
+        [[nodiscard]] const std::function<void(State &)> &getFunction() const { return function; }
+
+        /// @brief Argument sets; empty means a single instance without arguments.
+        [[nodiscard]] const std::vector<std::vector<long> > &getArgumentSets() const { return argumentSets; }
+    };
+
+    /**
+     * @brief Registers a benchmark function.
+     * @param name Name of the benchmark.
+     * @param function The benchmark function.
+     * @return The registration, to add argument sets to.
+     */
+    Registration *registerBenchmark(const std::string &name, std::function<void(State &)> function);
+
+    /**
+     * @brief Runs all registered benchmarks matching the command-line filter.
+     * @param argc Number of command-line arguments.
+     * @param argv Command-line arguments: --filter SUBSTRING, --min-time SECONDS.
+     * @return 0 on success, 1 on invalid arguments or a failing benchmark.
+     */
+    int runRegistered(int argc, char *argv[]);
+
+    /**
+     * @brief Prevents the compiler from optimising away a value.
+     * @param value The value to keep alive.
+     */
+    template<typename T>
+    void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T *sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+
+/// @brief Registers a benchmark function; chain ->arg()/->args() to add instances.
+#define BENCHMARK(function) \
+    static bench::Registration *BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = \
+        bench::registerBenchmark(#function, function)
+
+#endif //BENCHMARK_H
@@ -0,0 +1,886 @@
+/**
+ * @file SchedulingBenchmarks.cpp
+ * @brief Microbenchmarks of the resource matching and scheduling hot path.
+ *
+ * Pool sizes count the resources in a process's pool; half of them are UsableResource units and half
+ * ConsumableResource counters. Requirements name the last resources of the pool so that name lookups
+ * scan the whole pool, which is the worst case of the current matching.
+ */
+
+#include "Benchmark.h"
+#include "CapacityPlan.h"
+#include "CapacitySweep.h"
+#include "ConsumableResource.h"
+#include "EligibilityKernel.h"
+#include "ExecutionMetrics.h"
+#include "ExecutionPlan.h"
+#include "FairShareScheduler.h"
+#include "Pipeline.h"
+#include "Process.h"
+#include "ResultCache.h"
+#include "ResourceIndex.h"
+#include "ResourceManager.h"
+#include "ShardedConsumableResource.h"
+#include "Task.h"
+#include "TaskQueue.h"
+#include "UsableResource.h"
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+    /**
+     * @brief Builds a pool of alternating usable and consumable resources.
+     * @param poolSize Number of resources in the pool.
+     * @return The resource pool.
+     */
+    std::vector<std::unique_ptr<Resource> > buildPool(const long poolSize) {
+        std::vector<std::unique_ptr<Resource> > pool;
+        for (long index = 0; index < poolSize; ++index) {
+            if (index % 2 == 0) {
+                pool.push_back(std::make_unique<UsableResource>("CPU" + std::to_string(index), 3));
+            } else {
+                pool.push_back(std::make_unique<ConsumableResource>("Memory" + std::to_string(index), INT_MAX));
+            }
+        }
+        return pool;
+    }
+
+    /**
+     * @brief Names the last usable and last consumable resource of a pool built by buildPool().
+     * @param poolSize Number of resources in the pool (at least 2).
+     * @return Requirement names that force a full scan of the pool.
+     */
+    std::vector<std::string> lastRequirements(const long poolSize) {
+        const long lastConsumable = poolSize % 2 == 0 ? poolSize - 1 : poolSize - 2;
+        const long lastUsable = poolSize % 2 == 0 ? poolSize - 2 : poolSize - 1;
+        return {"CPU" + std::to_string(lastUsable), "Memory" + std::to_string(lastConsumable)};
+    }
+
+    /**
+     * @brief Builds a process whose tasks all require one CPU and one unit of memory.
+     * @param taskCount Number of tasks.
+     * @param poolSize Number of resources in the pool (at least 2).
+     * @return The process, ready to run.
+     */
+    std::unique_ptr<Process> buildProcess(const long taskCount, const long poolSize) {
+        auto process = std::make_unique<Process>("BenchmarkProcess", "Benchmark workload",
+                                                 std::vector<std::string>{}, 1);
+        for (auto &resource: buildPool(poolSize)) process->addResource(std::move(resource));
+        const auto requirements = lastRequirements(poolSize);
+        for (long index = 0; index < taskCount; ++index) {
+            process->addTask(std::make_unique<Task>("Task" + std::to_string(index), "Benchmark task", requirements, 1));
+        }
+        return process;
+    }
+
+    /**
+     * @brief Measures Executable::canExecute against pools of increasing size.
+     * @param state Benchmark state; range(0) is the pool size.
+     */
+    void BM_CanExecute(bench::State &state) {
+        const auto pool = buildPool(state.range(0));
+        const Task task("Probe", "Eligibility probe", lastRequirements(state.range(0)), 1);
+        for (auto _: state) {
+            bench::doNotOptimize(task.canExecute(pool));
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_CanExecute)->arg(2)->arg(8)->arg(64)->arg(512);
+
+    /**
+     * @brief Measures the bitmask eligibility check of a ResourceIndex, to compare against BM_CanExecute.
+     * @param state Benchmark state; range(0) is the pool size.
+     */
+    void BM_CanExecuteBitmask(bench::State &state) {
+        const auto pool = buildPool(state.range(0));
+        ResourceIndex index;
+        for (const auto &resource: pool) index.addResource(*resource);
+        ResourceIndex::Mask required;
+        index.requirementMask(lastRequirements(state.range(0)), required);
+        for (auto _: state) {
+            bench::doNotOptimize(index.isSatisfied(required));
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_CanExecuteBitmask)->arg(2)->arg(8)->arg(64)->arg(256);
+
+    /**
+     * @brief Measures EligibilityKernel::selectReady over many tasks with two required groups each.
+     *
+     * Every fourth task requires a group that is not free, so three quarters of the tasks are ready.
+     * Instruction sets the processor lacks run on the widest supported one instead.
+     *
+     * @param state Benchmark state; range(0) is the instruction set (0 scalar, 1 SSE2, 2 AVX2), range(1)
+     *              the task count and range(2) the number of distinct resource names.
+     */
+    void BM_SelectReady(bench::State &state) {
+        const auto instructionSet = std::min(static_cast<EligibilityKernel::InstructionSet>(state.range(0)),
+                                             EligibilityKernel::supportedInstructionSet());
+        const auto groupCount = static_cast<std::size_t>(state.range(2));
+        EligibilityKernel::MaskTable masks;
+        ResourceIndex::Mask freeMask;
+        for (std::size_t group = 1; group < groupCount; ++group) freeMask.set(group);
+        for (long index = 0; index < state.range(1); ++index) {
+            ResourceIndex::Mask required;
+            required.set(index % 4 == 0 ? 0 : 1 + static_cast<std::size_t>(index) % (groupCount - 1));
+            required.set(groupCount - 1);
+            masks.push_back(required);
+        }
+        const std::size_t wordCount = (groupCount + 63) / 64;
+        std::vector<std::size_t> ready;
+        ready.reserve(masks.size());
+        for (auto _: state) {
+            EligibilityKernel::selectReady(masks, 0, freeMask, wordCount, ready, instructionSet);
+            bench::doNotOptimize(ready.data());
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(1)));
+    }
+
+    BENCHMARK(BM_SelectReady)->args({0, 100000, 64})->args({1, 100000, 64})->args({2, 100000, 64})
+            ->args({0, 100000, 256})->args({1, 100000, 256})->args({2, 100000, 256});
+
+    /**
+     * @brief Measures a full assignResources/releaseResources round trip.
+     * @param state Benchmark state; range(0) is the pool size.
+     */
+    void BM_AssignRelease(bench::State &state) {
+        const auto pool = buildPool(state.range(0));
+        Task task("Probe", "Assignment probe", lastRequirements(state.range(0)), 1);
+        for (auto _: state) {
+            task.assignResources(pool);
+            task.releaseResources();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_AssignRelease)->arg(2)->arg(8)->arg(64)->arg(512);
+
+    /**
+     * @brief Measures ConsumableResource::allocate of a single unit.
+     * @param state Benchmark state.
+     */
+    void BM_ConsumableAllocate(bench::State &state) {
+        auto memory = std::make_unique<ConsumableResource>("Memory", INT_MAX);
+        for (auto _: state) {
+            if (memory->getRemainingCapacity() == 0) {
+                state.pauseTiming();
+                memory = std::make_unique<ConsumableResource>("Memory", INT_MAX);
+                state.resumeTiming();
+            }
+            memory->allocate();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_ConsumableAllocate);
+
+    /**
+     * @brief Measures a UsableResource::allocate/release pair.
+     * @param state Benchmark state.
+     */
+    void BM_UsableAllocateRelease(bench::State &state) {
+        UsableResource processor("CPU", 3);
+        for (auto _: state) {
+            processor.allocate();
+            processor.release();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_UsableAllocateRelease);
+
+    /**
+     * @brief Measures Process::run over task counts and pool sizes; process construction is not timed.
+     * @param state Benchmark state; range(0) is the task count and range(1) the pool size.
+     */
+    void BM_ProcessRun(bench::State &state) {
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = buildProcess(state.range(0), state.range(1));
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRun)->args({10, 2})->args({1000, 2})->args({1000, 64})->args({100000, 8});
+
+    /**
+     * @brief Measures re-running an unchanged process with a warm ResultCache, filled by a first untimed run;
+     * construction and compilation are not timed.
+     * @param state Benchmark state; range(0) is the task count and range(1) the pool size.
+     */
+    void BM_ProcessRunCached(bench::State &state) {
+        const auto cache = std::make_shared<ResultCache>();
+        auto process = buildProcess(state.range(0), state.range(1));
+        process->setResultCache(cache);
+        process->run();
+        for (auto _: state) {
+            state.pauseTiming();
+            process = buildProcess(state.range(0), state.range(1));
+            process->setResultCache(cache);
+            process->compile();
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRunCached)->args({1000, 2})->args({1000, 64})->args({100000, 8});
+
+    /**
+     * @brief Measures Process::rerunChanged after one of the inputs of a process changed, to compare against
+     * BM_ProcessRun; every task reads an input of its own and the first, untimed run records their completion.
+     * @param state Benchmark state; range(0) is the task count and range(1) the pool size.
+     */
+    void BM_ProcessRerunChanged(bench::State &state) {
+        auto process = buildProcess(0, state.range(1));
+        const auto requirements = lastRequirements(state.range(1));
+        for (long index = 0; index < state.range(0); ++index) {
+            auto task = std::make_unique<Task>("Task" + std::to_string(index), "Benchmark task", requirements, 1);
+            task->addInput("input" + std::to_string(index));
+            task->addOutput("output" + std::to_string(index));
+            process->addTask(std::move(task));
+        }
+        process->run();
+        const std::vector<std::string> changed{"input" + std::to_string(state.range(0) / 2)};
+        for (auto _: state) {
+            bench::doNotOptimize(process->rerunChanged(changed));
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRerunChanged)->args({1000, 2})->args({100000, 8});
+
+    /**
+     * @brief Measures running the same process repeatedly, either rebuilding it before every run (variant 0)
+     * or restoring a snapshot taken before the first run (variant 1); both are timed.
+     * @param state Benchmark state; range(0) is the task count, range(1) the pool size and range(2) the variant.
+     */
+    void BM_ProcessRunRestored(bench::State &state) {
+        auto process = buildProcess(state.range(0), state.range(1));
+        process->compile();
+        const auto snapshot = process->snapshot();
+        for (auto _: state) {
+            if (state.range(2) == 0) {
+                process = buildProcess(state.range(0), state.range(1));
+            } else {
+                process->restore(snapshot);
+            }
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRunRestored)->args({1000, 64, 0})->args({1000, 64, 1})->args({100000, 8, 0})
+            ->args({100000, 8, 1});
+
+    /**
+     * @brief Measures Process::run pulling its tasks lazily from a TaskSource, to compare against BM_ProcessRun.
+     * Tasks are built while the process runs, so unlike in BM_ProcessRun their construction is measured.
+     * @param state Benchmark state; range(0) is the task count and range(1) the pool size.
+     */
+    void BM_ProcessRunPulled(bench::State &state) {
+        const auto taskCount = state.range(0);
+        const auto requirements = lastRequirements(state.range(1));
+        for (auto _: state) {
+            auto process = buildProcess(0, state.range(1));
+            long next = 0;
+            process->setTaskSource([&next, taskCount, &requirements]() -> std::unique_ptr<Executable> {
+                if (next == taskCount) return nullptr;
+                return std::make_unique<Task>("Task" + std::to_string(next++), "Benchmark task", requirements, 1);
+            });
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(taskCount));
+    }
+
+    BENCHMARK(BM_ProcessRunPulled)->args({1000, 2})->args({100000, 8});
+
+    /**
+     * @brief Measures many compilation units flowing through the five-stage compilation chain, with tasks
+     * holding their resources for 200 microseconds per duration unit.
+     *
+     * Variant 0 runs the chain as one stage whose duration is the sum of the stages, as a single process would.
+     * Variant 1 runs the five stages as a pipeline with one worker each, and variant 2 gives the slowest stage
+     * two workers, so throughput follows the slowest stage instead of the sum.
+     *
+     * @param state Benchmark state; range(0) is the number of inputs and range(1) the variant.
+     */
+    void BM_PipelineRun(bench::State &state) {
+        std::vector<std::unique_ptr<Resource> > pool;
+        for (int core = 0; core < 8; ++core) pool.push_back(std::make_unique<UsableResource>("CPU", 3));
+        pool.push_back(std::make_unique<ConsumableResource>("Memory", INT_MAX));
+        const std::vector<std::string> requirements{"CPU", "Memory"};
+        std::vector<Pipeline::Stage> stages;
+        if (state.range(1) == 0) {
+            stages.push_back({"CompileUnit", "Compile", requirements, 2 + 3 + 4 + 3 + 2, 1});
+        } else {
+            stages.push_back({"ScanSourceCode", "Tokenize", requirements, 2, 1});
+            stages.push_back({"ParseSyntax", "Parse", requirements, 3, 1});
+            stages.push_back({"PerformStaticAnalysis", "Analyse", requirements, 4,
+                              static_cast<std::size_t>(state.range(1) == 2 ? 2 : 1)});
+            stages.push_back({"GenerateCode", "Generate code for", requirements, 3, 1});
+            stages.push_back({"LinkBinary", "Link", requirements, 2, 1});
+        }
+        std::vector<std::string> inputs;
+        for (long input = 0; input < state.range(0); ++input) inputs.push_back("unit" + std::to_string(input) + ".c");
+        Pipeline::Options options;
+        options.unitTime = std::chrono::microseconds(200);
+        Pipeline pipeline(pool, stages, options);
+        for (auto _: state) {
+            bench::doNotOptimize(pipeline.run(inputs).completed);
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_PipelineRun)->args({64, 0})->args({64, 1})->args({64, 2});
+
+    /**
+     * @brief Measures Process::run with bitmask requirement matching, to compare against BM_ProcessRun.
+     * @param state Benchmark state; range(0) is the task count and range(1) the pool size.
+     */
+    void BM_ProcessRunBitmask(bench::State &state) {
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = buildProcess(state.range(0), state.range(1));
+            process->setRequirementMatching(Process::RequirementMatching::Bitmask);
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRunBitmask)->args({1000, 2})->args({1000, 64})->args({100000, 8});
+
+    /**
+     * @brief Measures Process::run when the process holds the CPU its tasks require and lends it to them.
+     * @param state Benchmark state; range(0) is the task count, range(1) the pool size and range(2) the
+     * Process::ResourceDelegation.
+     */
+    void BM_ProcessRunDelegated(bench::State &state) {
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = std::make_unique<Process>("BenchmarkProcess", "Benchmark workload",
+                                                std::vector<std::string>{lastRequirements(state.range(1)).front()}, 1);
+            for (auto &resource: buildPool(state.range(1))) process->addResource(std::move(resource));
+            const auto requirements = lastRequirements(state.range(1));
+            for (long index = 0; index < state.range(0); ++index) {
+                process->addTask(std::make_unique<Task>("Task" + std::to_string(index), "Benchmark task",
+                                                        requirements, 1));
+            }
+            process->setResourceDelegation(static_cast<Process::ResourceDelegation>(state.range(2)));
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRunDelegated)->args({1000, 2, 1})->args({1000, 64, 1})->args({1000, 64, 2})
+            ->args({100000, 8, 1});
+
+    /**
+     * @brief Measures Process::run with ExecutionMetrics attached, to compare against BM_ProcessRun.
+     * @param state Benchmark state; range(0) is the task count and range(1) the pool size.
+     */
+    void BM_ProcessRunWithMetrics(bench::State &state) {
+        const auto metrics = std::make_shared<ExecutionMetrics>();
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = buildProcess(state.range(0), state.range(1));
+            process->setMetrics(metrics);
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_ProcessRunWithMetrics)->args({1000, 2})->args({100000, 8});
+
+    /**
+     * @brief Measures Process::run on generated workloads; generation is not timed.
+     * @param state Benchmark state; range(0) is the WorkloadOptions::Shape and range(1) the task count.
+     */
+    void BM_ProcessRunGenerated(bench::State &state) {
+        WorkloadOptions options;
+        options.shape = static_cast<WorkloadOptions::Shape>(state.range(0));
+        options.taskCount = static_cast<std::size_t>(state.range(1));
+        options.usableResourceCount = 8;
+        const WorkloadGenerator generator(options);
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = generator.generate();
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * options.taskCount);
+    }
+
+    BENCHMARK(BM_ProcessRunGenerated)->args({0, 100000})->args({1, 100000})->args({2, 100000})->args({2, 1000000});
+
+    /**
+     * @brief Measures Process::compile on generated workloads; generation is not timed.
+     * @param state Benchmark state; range(0) is the WorkloadOptions::Shape and range(1) the task count.
+     */
+    void BM_ProcessCompile(bench::State &state) {
+        WorkloadOptions options;
+        options.shape = static_cast<WorkloadOptions::Shape>(state.range(0));
+        options.taskCount = static_cast<std::size_t>(state.range(1));
+        options.usableResourceCount = 8;
+        const WorkloadGenerator generator(options);
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = generator.generate();
+            state.resumeTiming();
+            bench::doNotOptimize(process->compile().getInfeasibleCount());
+        }
+        state.setItemsProcessed(state.iterations() * options.taskCount);
+    }
+
+    BENCHMARK(BM_ProcessCompile)->args({2, 100000})->args({2, 1000000});
+
+    /**
+     * @brief Measures Process::run on generated workloads compiled beforehand, to compare against
+     * BM_ProcessRunGenerated; generation and compilation are not timed.
+     * @param state Benchmark state; range(0) is the WorkloadOptions::Shape and range(1) the task count.
+     */
+    void BM_ProcessRunCompiled(bench::State &state) {
+        WorkloadOptions options;
+        options.shape = static_cast<WorkloadOptions::Shape>(state.range(0));
+        options.taskCount = static_cast<std::size_t>(state.range(1));
+        options.usableResourceCount = 8;
+        const WorkloadGenerator generator(options);
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = generator.generate();
+            process->compile();
+            state.resumeTiming();
+            process->run();
+        }
+        state.setItemsProcessed(state.iterations() * options.taskCount);
+    }
+
+    BENCHMARK(BM_ProcessRunCompiled)->args({2, 100000})->args({2, 1000000});
+
+    /**
+     * @brief Measures Process::simulate over generated workloads; generation is not timed.
+     * @param state Benchmark state; range(0) is the WorkloadOptions::Shape and range(1) the task count.
+     */
+    void BM_ProcessSimulate(bench::State &state) {
+        WorkloadOptions options;
+        options.shape = static_cast<WorkloadOptions::Shape>(state.range(0));
+        options.taskCount = static_cast<std::size_t>(state.range(1));
+        options.usableResourceCount = 8;
+        const WorkloadGenerator generator(options);
+        std::unique_ptr<Process> process;
+        for (auto _: state) {
+            state.pauseTiming();
+            process = generator.generate();
+            state.resumeTiming();
+            bench::doNotOptimize(process->simulate());
+        }
+        state.setItemsProcessed(state.iterations() * options.taskCount);
+    }
+
+    BENCHMARK(BM_ProcessSimulate)->args({0, 100000})->args({1, 100000})->args({2, 100000});
+
+    /**
+     * @brief Builds a process whose independent tasks require random numbers of CPUs and GPUs, as a vector
+     * bin-packing workload for the event-driven admissions.
+     * @param taskCount Number of tasks.
+     * @return The process, on 16 CPUs and 4 GPUs.
+     */
+    std::unique_ptr<Process> buildPackingWorkload(const std::size_t taskCount) {
+        auto process = std::make_unique<Process>("Packing", "Multi-unit tasks", std::vector<std::string>{}, 1);
+        for (int unit = 0; unit < 16; ++unit) process->addResource(std::make_unique<UsableResource>("CPU", 3));
+        for (int unit = 0; unit < 4; ++unit) process->addResource(std::make_unique<UsableResource>("GPU", 2));
+        std::mt19937_64 engine(42);
+        std::uniform_int_distribution<int> cpus(1, 8);
+        std::uniform_int_distribution<int> gpus(-2, 2);
+        std::uniform_int_distribution<int> duration(1, 10);
+        for (std::size_t index = 0; index < taskCount; ++index) {
+            std::vector<std::string> requirements(static_cast<std::size_t>(cpus(engine)), "CPU");
+            requirements.resize(requirements.size() + static_cast<std::size_t>(std::max(gpus(engine), 0)), "GPU");
+            process->addTask(std::make_unique<Task>("Task" + std::to_string(index), "Packed task", requirements,
+                                                    duration(engine)));
+        }
+        process->setScheduling(Process::Scheduling::EventDriven);
+        return process;
+    }
+
+    /**
+     * @brief Measures event-driven simulations under each admission policy, reporting the utilisation of the
+     * usable resources and the makespan they achieve; building the workload is not timed, so the time per item
+     * is the scheduling cost per task.
+     * @param state Benchmark state; range(0) is the EventDrivenScheduler::Admission and range(1) the task count.
+     */
+    void BM_PackedAdmission(bench::State &state) {
+        const auto taskCount = static_cast<std::size_t>(state.range(1));
+        EventDrivenScheduler::Report report;
+        for (auto _: state) {
+            state.pauseTiming();
+            auto process = buildPackingWorkload(taskCount);
+            process->setAdmission(static_cast<EventDrivenScheduler::Admission>(state.range(0)));
+            state.resumeTiming();
+            report = process->simulate();
+            bench::doNotOptimize(report);
+        }
+        state.setItemsProcessed(state.iterations() * taskCount);
+        state.setCounter("utilisation", report.utilisation);
+        state.setCounter("makespan", static_cast<double>(report.makespan));
+    }
+
+    BENCHMARK(BM_PackedAdmission)->args({0, 2000})->args({1, 2000})->args({2, 2000})->args({3, 2000})
+            ->args({0, 20000})->args({1, 20000})->args({2, 20000})->args({3, 20000});
+
+    /**
+     * @brief Builds a process in which every tenth task is wide and long and the others are narrow and short, so
+     * tasks started in arrival order leave CPUs idle while a wide task waits.
+     * @param taskCount Number of tasks.
+     * @return The process, on 16 CPUs.
+     */
+    std::unique_ptr<Process> buildBackfillWorkload(const std::size_t taskCount) {
+        auto process = std::make_unique<Process>("Backfill", "Wide and narrow tasks", std::vector<std::string>{}, 1);
+        for (int unit = 0; unit < 16; ++unit) process->addResource(std::make_unique<UsableResource>("CPU", 3));
+        std::mt19937_64 engine(7);
+        std::uniform_int_distribution<int> wideCpus(8, 16);
+        std::uniform_int_distribution<int> wideDuration(20, 50);
+        std::uniform_int_distribution<int> narrowCpus(1, 2);
+        std::uniform_int_distribution<int> narrowDuration(1, 5);
+        for (std::size_t index = 0; index < taskCount; ++index) {
+            const bool wide = index % 10 == 0;
+            const auto cpus = wide ? wideCpus(engine) : narrowCpus(engine);
+            const auto duration = wide ? wideDuration(engine) : narrowDuration(engine);
+            process->addTask(std::make_unique<Task>("Task" + std::to_string(index), "Mixed task",
+                                                    std::vector<std::string>(static_cast<std::size_t>(cpus), "CPU"),
+                                                    duration));
+        }
+        process->setScheduling(Process::Scheduling::EventDriven);
+        return process;
+    }
+
+    /**
+     * @brief Measures event-driven simulations of wide and narrow tasks started in arrival order, first come or
+     * with EASY backfilling, reporting the utilisation and makespan they achieve; building the workload is not
+     * timed.
+     * @param state Benchmark state; range(0) is the EventDrivenScheduler::Admission and range(1) the task count.
+     */
+    void BM_Backfill(bench::State &state) {
+        const auto taskCount = static_cast<std::size_t>(state.range(1));
+        EventDrivenScheduler::Report report;
+        for (auto _: state) {
+            state.pauseTiming();
+            auto process = buildBackfillWorkload(taskCount);
+            process->setAdmission(static_cast<EventDrivenScheduler::Admission>(state.range(0)));
+            state.resumeTiming();
+            report = process->simulate();
+            bench::doNotOptimize(report);
+        }
+        state.setItemsProcessed(state.iterations() * taskCount);
+        state.setCounter("utilisation", report.utilisation);
+        state.setCounter("makespan", static_cast<double>(report.makespan));
+    }
+
+    BENCHMARK(BM_Backfill)->args({0, 2000})->args({4, 2000})->args({0, 20000})->args({4, 20000});
+
+    /**
+     * @brief Builds a process whose tasks form a random dependency graph on 4 fast and 12 slow processors, with
+     * durations measured on a fast one.
+     * @param taskCount Number of tasks, each requiring one processor and depending on up to two recent tasks.
+     * @return The process, on 4 CPUs of 4 GHz listed after 12 CPUs of 1 GHz.
+     */
+    std::unique_ptr<Process> buildHeterogeneousWorkload(const std::size_t taskCount) {
+        auto process = std::make_unique<Process>("Heterogeneous", "Big and little cores", std::vector<std::string>{},
+                                                 1);
+        for (int unit = 0; unit < 12; ++unit) process->addResource(std::make_unique<UsableResource>("CPU", 1));
+        for (int unit = 0; unit < 4; ++unit) process->addResource(std::make_unique<UsableResource>("CPU", 4));
+        std::mt19937_64 engine(5);
+        std::uniform_int_distribution<int> duration(1, 20);
+        std::uniform_int_distribution<std::size_t> back(1, 50);
+        std::uniform_int_distribution<int> dependencyCount(0, 2);
+        for (std::size_t index = 0; index < taskCount; ++index) {
+            auto task = std::make_unique<Task>("Task" + std::to_string(index), "Graph task",
+                                               std::vector<std::string>{"CPU"}, duration(engine));
+            for (int dependency = dependencyCount(engine); dependency > 0 && index > 0; --dependency) {
+                task->addDependency("Task" + std::to_string(index - std::min(back(engine), index)));
+            }
+            process->addTask(std::move(task));
+        }
+        process->setScheduling(Process::Scheduling::EventDriven);
+        process->setReferenceCapacity(4);
+        return process;
+    }
+
+    /**
+     * @brief Measures event-driven simulations of a dependency graph on mixed fast and slow processors, placing
+     * tasks first come on the first free processor or by earliest finish time, and reports the makespan and
+     * utilisation they achieve; building the workload is not timed.
+     * @param state Benchmark state; range(0) is the EventDrivenScheduler::Admission and range(1) the task count.
+     */
+    void BM_HeterogeneousPlacement(bench::State &state) {
+        const auto taskCount = static_cast<std::size_t>(state.range(1));
+        EventDrivenScheduler::Report report;
+        for (auto _: state) {
+            state.pauseTiming();
+            auto process = buildHeterogeneousWorkload(taskCount);
+            process->setAdmission(static_cast<EventDrivenScheduler::Admission>(state.range(0)));
+            state.resumeTiming();
+            report = process->simulate();
+            bench::doNotOptimize(report);
+        }
+        state.setItemsProcessed(state.iterations() * taskCount);
+        state.setCounter("utilisation", report.utilisation);
+        state.setCounter("makespan", static_cast<double>(report.makespan));
+    }
+
+    BENCHMARK(BM_HeterogeneousPlacement)->args({0, 2000})->args({5, 2000})->args({0, 20000})->args({5, 20000});
+
+    /**
+     * @brief Measures a capacity sweep of 16 variants of a generated 10000-task workload, varying the capacity of
+     * one consumable and the unit count of one usable resource, on several worker threads.
+     * @param state Benchmark state; range(0) is the number of worker threads.
+     */
+    void BM_CapacitySweep(bench::State &state) {
+        WorkloadOptions options;
+        options.taskCount = 10000;
+        options.usableResourceCount = 8;
+        const auto prototype = WorkloadGenerator(options).generate();
+        CapacitySweep sweep(*prototype);
+        sweep.addDimension("Memory0", {1000, 2000, 5000, 10000, 20000, 50000, 100000, 1000000});
+        sweep.addDimension("CPU0", {1, 2});
+        for (auto _: state) {
+            bench::doNotOptimize(sweep.runGrid(static_cast<std::size_t>(state.range(0))).size());
+        }
+        state.setItemsProcessed(state.iterations() * sweep.getGridSize());
+    }
+
+    BENCHMARK(BM_CapacitySweep)->arg(1)->arg(2)->arg(4);
+
+    /**
+     * @brief Measures Process::planCapacities on a generated workload with random dependencies.
+     * @param state Benchmark state; range(0) is the number of tasks.
+     */
+    void BM_CapacityPlan(bench::State &state) {
+        WorkloadOptions options;
+        options.taskCount = static_cast<std::size_t>(state.range(0));
+        options.usableResourceCount = 8;
+        const auto process = WorkloadGenerator(options).generate();
+        for (auto _: state) {
+            bench::doNotOptimize(process->planCapacities().getRequirements().size());
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(state.range(0)));
+    }
+
+    BENCHMARK(BM_CapacityPlan)->arg(1000)->arg(100000);
+
+    /**
+     * @brief Measures ResourceManager acquire and release cycles from several threads, each thread cycling
+     * over names of its own so that contention only comes from shards shared between names.
+     * @param state Benchmark state; range(0) is the thread count and range(1) the shard count.
+     */
+    void BM_ResourceManagerAcquire(bench::State &state) {
+        constexpr int CyclesPerThread = 20000;
+        const auto threadCount = static_cast<int>(state.range(0));
+        ResourceManager manager(static_cast<std::size_t>(state.range(1)));
+        for (int thread = 0; thread < threadCount; ++thread) {
+            for (int core = 0; core < 4; ++core) {
+                manager.addResource(std::make_unique<UsableResource>("CPU" + std::to_string(thread), 3));
+            }
+            manager.addResource(std::make_unique<ConsumableResource>("Memory" + std::to_string(thread), INT_MAX));
+        }
+        for (auto _: state) {
+            std::vector<std::thread> workers;
+            for (int thread = 0; thread < threadCount; ++thread) {
+                workers.emplace_back([&manager, thread] {
+                    const std::vector<std::string> names{"CPU" + std::to_string(thread),
+                                                         "Memory" + std::to_string(thread)};
+                    for (int cycle = 0; cycle < CyclesPerThread; ++cycle) {
+                        auto lease = manager.acquire(names);
+                        bench::doNotOptimize(lease.getResources().size());
+                    }
+                });
+            }
+            for (auto &worker: workers) worker.join();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(threadCount) * CyclesPerThread);
+    }
+
+    BENCHMARK(BM_ResourceManagerAcquire)->args({1, 1})->args({4, 1})->args({4, 16})->args({8, 1})->args({8, 64});
+
+    /**
+     * @brief Measures many compilations running concurrently against one machine's shared processors and
+     * memory, each process lending its processor to its tasks.
+     * @param state Benchmark state; range(0) is the process count and range(1) the thread count.
+     */
+    void BM_SharedManagerRun(bench::State &state) {
+        const auto processCount = static_cast<std::size_t>(state.range(0));
+        const auto threadCount = static_cast<std::size_t>(state.range(1));
+        std::vector<std::unique_ptr<Process> > processes;
+        for (auto _: state) {
+            state.pauseTiming();
+            const auto machine = std::make_shared<ResourceManager>();
+            for (int core = 0; core < 8; ++core) machine->addResource(std::make_unique<UsableResource>("CPU", 3));
+            machine->addResource(std::make_unique<ConsumableResource>("Memory", INT_MAX));
+            processes.clear();
+            for (std::size_t index = 0; index < processCount; ++index) {
+                auto process = std::make_unique<Process>("Compile" + std::to_string(index), "Shared compilation",
+                                                         std::vector<std::string>{"CPU", "Memory"}, 1);
+                process->addResource(std::make_unique<ConsumableResource>("Scratch", INT_MAX));
+                for (int task = 0; task < 100; ++task) {
+                    process->addTask(std::make_unique<Task>("Task" + std::to_string(task), "Benchmark task",
+                                                            std::vector<std::string>{"CPU", "Scratch"}, 1));
+                }
+                process->setResourceManager(machine);
+                process->compile();
+                processes.push_back(std::move(process));
+            }
+            state.resumeTiming();
+            std::vector<std::thread> workers;
+            for (std::size_t worker = 0; worker < threadCount; ++worker) {
+                workers.emplace_back([&processes, worker, threadCount] {
+                    for (auto index = worker; index < processes.size(); index += threadCount) processes[index]->run();
+                });
+            }
+            for (auto &worker: workers) worker.join();
+        }
+        state.setItemsProcessed(state.iterations() * processCount * 100);
+    }
+
+    BENCHMARK(BM_SharedManagerRun)->args({256, 1})->args({256, 4})->args({256, 8});
+
+    /**
+     * @brief Measures fair-share simulations of one greedy process and three light ones on a 16-CPU machine: the
+     * greedy process has four times as many tasks, each holding twice as many CPUs. The counters report the mean
+     * latency of the greedy process's tasks and of the light processes' tasks; building the processes is not
+     * timed, so the time per item is the scheduling cost per task.
+     * @param state Benchmark state; range(0) is the FairShareScheduler::Policy and range(1) the tasks of each
+     * light process.
+     */
+    void BM_FairShare(bench::State &state) {
+        const auto lightTasks = static_cast<std::size_t>(state.range(1));
+        ResourceManager machine;
+        for (int core = 0; core < 16; ++core) machine.addResource(std::make_unique<UsableResource>("CPU", 3));
+        machine.addResource(std::make_unique<ConsumableResource>("Memory", INT_MAX));
+        std::vector<std::unique_ptr<Process> > processes;
+        std::mt19937_64 engine(11);
+        std::uniform_int_distribution<int> duration(1, 10);
+        for (std::size_t index = 0; index < 4; ++index) {
+            const bool greedy = index == 0;
+            auto process = std::make_unique<Process>((greedy ? "Greedy" : "Light") + std::to_string(index),
+                                                     "Tenant", std::vector<std::string>{}, 1);
+            const std::vector<std::string> requirements = greedy ? std::vector<std::string>{"CPU", "CPU", "Memory"}
+                                                                 : std::vector<std::string>{"CPU", "Memory"};
+            for (std::size_t task = 0; task < (greedy ? 4 * lightTasks : lightTasks); ++task) {
+                process->addTask(std::make_unique<Task>("Task" + std::to_string(task), "Tenant task", requirements,
+                                                        duration(engine)));
+            }
+            processes.push_back(std::move(process));
+        }
+        FairShareScheduler::Report report;
+        for (auto _: state) {
+            state.pauseTiming();
+            FairShareScheduler scheduler(machine, static_cast<FairShareScheduler::Policy>(state.range(0)));
+            for (const auto &process: processes) scheduler.addProcess(*process);
+            state.resumeTiming();
+            report = scheduler.run();
+            bench::doNotOptimize(report);
+        }
+        state.setItemsProcessed(state.iterations() * 7 * lightTasks);
+        double lightLatency = 0;
+        for (std::size_t index = 1; index < report.processes.size(); ++index) {
+            lightLatency += report.processes[index].meanLatency / 3;
+        }
+        state.setCounter("greedyLatency", report.processes.front().meanLatency);
+        state.setCounter("lightLatency", lightLatency);
+    }
+
+    BENCHMARK(BM_FairShare)->args({0, 1000})->args({1, 1000})->args({0, 100000})->args({1, 100000});
+
+    /**
+     * @brief Measures threads allocating units of one consumable, either a ConsumableResource guarded by a
+     * mutex or a ShardedConsumableResource drawing from per-thread quotas.
+     * @param state Benchmark state; range(0) is the thread count and range(1) the variant (0 mutex, 1 sharded).
+     */
+    void BM_ConcurrentConsumableAllocate(bench::State &state) {
+        constexpr int AllocationsPerThread = 200000;
+        const auto threadCount = static_cast<int>(state.range(0));
+        const bool sharded = state.range(1) != 0;
+        for (auto _: state) {
+            state.pauseTiming();
+            std::unique_ptr<ConsumableResource> memory;
+            if (sharded) {
+                memory = std::make_unique<ShardedConsumableResource>("Memory", INT_MAX);
+            } else {
+                memory = std::make_unique<ConsumableResource>("Memory", INT_MAX);
+            }
+            std::mutex memoryMutex;
+            state.resumeTiming();
+            std::vector<std::thread> workers;
+            for (int thread = 0; thread < threadCount; ++thread) {
+                workers.emplace_back([&memory, &memoryMutex, sharded] {
+                    for (int allocation = 0; allocation < AllocationsPerThread; ++allocation) {
+                        if (sharded) {
+                            memory->allocate();
+                        } else {
+                            const std::lock_guard<std::mutex> lock(memoryMutex);
+                            memory->allocate();
+                        }
+                    }
+                });
+            }
+            for (auto &worker: workers) worker.join();
+            bench::doNotOptimize(memory->getRemainingCapacity());
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(threadCount) * AllocationsPerThread);
+    }
+
+    BENCHMARK(BM_ConcurrentConsumableAllocate)->args({1, 0})->args({1, 1})->args({4, 0})->args({4, 1})
+            ->args({8, 0})->args({8, 1});
+
+    /**
+     * @brief Measures a running process executing the tasks that producer threads submit to its queue.
+     * @param state Benchmark state; range(0) is the producer count and range(1) the queue capacity.
+     */
+    void BM_ProcessRunSubmitted(bench::State &state) {
+        constexpr int TasksPerProducer = 20000;
+        const auto producerCount = static_cast<int>(state.range(0));
+        const auto process = buildProcess(0, 2);
+        const auto requirements = lastRequirements(2);
+        for (auto _: state) {
+            const auto queue = std::make_shared<TaskQueue>(static_cast<std::size_t>(state.range(1)));
+            process->setSubmissionQueue(queue);
+            std::vector<std::thread> producers;
+            for (int producer = 0; producer < producerCount; ++producer) {
+                producers.emplace_back([&queue, &requirements] {
+                    for (int index = 0; index < TasksPerProducer; ++index) {
+                        std::unique_ptr<Executable> task = std::make_unique<Task>("Submitted", "Benchmark task",
+                                                                                  requirements, 1);
+                        queue->push(task);
+                    }
+                });
+            }
+            std::thread closer([&producers, &queue] {
+                for (auto &producer: producers) producer.join();
+                queue->close();
+            });
+            process->run();
+            closer.join();
+        }
+        state.setItemsProcessed(state.iterations() * static_cast<std::uint64_t>(producerCount) * TasksPerProducer);
+    }
+
+    BENCHMARK(BM_ProcessRunSubmitted)->args({1, 64})->args({1, 1024})->args({4, 1024})->args({8, 1024});
+}
@@ -0,0 +1,93 @@
+#ifndef CAPACITY_PLAN_H
+#define CAPACITY_PLAN_H
+
+#include "Executable.h"
+#include "Pipeline.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Smallest resource capacities with which every task of a process can run, derived from its declarations.
+ *
+ * Consumable units are never given back, so a consumable name must offer as many units as the process and all
+ * its runnable tasks require of it in total. Usable resources are given back once a task completes, so a usable
+ * name needs the units the process holds for its whole run plus the most any single task requires at once.
+ * Requirements the process lends are borrowed instead of drawn from the pool, as during execution.
+ *
+ * Capacity cannot help a task that requires a name no resource carries, depends on a task name no task carries,
+ * or depends on such tasks only; these are reported as obstacles and left out of the demand. The analysis is a
+ * single pass over the tasks and their dependencies, without simulating, so it sizes processes of hundreds of
+ * thousands of tasks in milliseconds. It is exact for sequential execution and for event-driven simulations
+ * without replenishments; refills let a simulation get by with less, so consumable minimums are then upper bounds.
+ * Pipeline stages count once per input; pulled and submitted tasks, unknown in advance, are not counted.
+ */
+class CapacityPlan {
+public:
+    /**
+     * @brief Demand on the resources of one name.
+     */
+    struct Requirement {
+        std::string resourceName; ///< Name shared by the resources.
+        Resource::Type type = Resource::Type::Usable; ///< Type of the first resource of that name.
+        std::size_t resourceCount = 0; ///< Number of resources of that name in the pool.
+        long long available = 0; ///< Remaining consumable units, or number of usable resources, in the pool.
+        long long demand = 0; ///< Consumable units consumed in total, or usable resources held at once.
+        int minimum = 1; ///< Capacity of each consumable or number of usable resources that meets the demand.
+    };
+
+    /**
+     * @brief Executable that cannot run whatever the capacities.
+     */
+    struct Obstacle {
+        std::string executableName; ///< Name of the process, task or pipeline stage.
+        std::string reason; ///< Why it cannot run.
+    };
+
+private:
+    std::vector<Requirement> requirements; ///< Demand of each pool name, by first appearance in the pool.
+    std::vector<Obstacle> obstacles; ///< Process, tasks and stages that cannot run, in that order.
+
+public:
+    /**
+     * @brief Computes the demand of a process on its pool.
+     * @param resourcePool The pool of the process.
+     * @param tasks The tasks of the process.
+     * @param processName Name of the process, reported if its own requirements cannot be met.
+     * @param ownRequirements Names the process allocates from its pool for its whole run.
+     * @param lentNames Names of the resources the process lends to its tasks, once per loan.
+     * @param stages Pipeline stages of the process, each run once per pipeline input.
+     * @param inputCount Number of pipeline inputs.
+     */
+    CapacityPlan(const std::vector<std::unique_ptr<Resource> > &resourcePool,
+                 const std::vector<std::unique_ptr<Executable> > &tasks, const std::string &processName,
+                 const std::vector<std::string> &ownRequirements, const std::vector<std::string> &lentNames = {},
+                 const std::vector<Pipeline::Stage> &stages = {}, std::size_t inputCount = 0);
+
+    /**
+     * @brief Retrieves the demand on each resource name of the pool.
+     * @return The requirements, by first appearance of the name in the pool.
+     */
+    [[nodiscard]] const std::vector<Requirement> &getRequirements() const;
+
+    /**
+     * @brief Retrieves the process, tasks and pipeline stages that cannot run whatever the capacities.
+     * @return The obstacles, the process first, then the tasks and the stages in order.
+     */
+    [[nodiscard]] const std::vector<Obstacle> &getObstacles() const;
+
+    /**
+     * @brief Checks whether the pool already meets the demand of every name.
+     * @return True if no name offers fewer units than its demand.
+     */
+    [[nodiscard]] bool isSufficient() const;
+
+    /**
+     * @brief Lists the minimum of every name in the form Process::cloneProcess() takes.
+     * @return Capacity of each consumable and number of usable resources, by resource name.
+     */
+    [[nodiscard]] std::map<std::string, int> getCapacities() const;
+};
+
+#endif //CAPACITY_PLAN_H
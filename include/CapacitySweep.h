@@ -0,0 +1,96 @@
+#ifndef CAPACITY_SWEEP_H
+#define CAPACITY_SWEEP_H
+
+#include "Process.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs variants of a process with different resource capacities, in parallel, for capacity planning.
+ *
+ * Each dimension of the sweep names a resource of the prototype and lists the values to try: the capacity of
+ * a consumable, or the number of units of a usable resource. runGrid() runs every combination of values and
+ * runSamples() a number of combinations drawn at random. Every variant is a Process::cloneProcess() copy of
+ * the prototype with event-driven scheduling, run on one of several worker threads, so a sweep answers
+ * questions such as "how much Memory does this process need" with the makespan and the completed, skipped
+ * and failed task counts of each variant.
+ *
+ * Variants print their simulation to std::cout like any run, interleaved across threads; callers usually
+ * silence it. The prototype must not change while a sweep runs.
+ */
+class CapacitySweep {
+public:
+    /**
+     * @brief Values tried for one resource.
+     */
+    struct Dimension {
+        std::string resourceName; ///< Name of a resource of the prototype.
+        std::vector<int> values; ///< Capacities of a consumable, or unit counts of a usable resource.
+    };
+
+    /**
+     * @brief Outcome of one variant.
+     */
+    struct Result {
+        std::map<std::string, int> capacities; ///< Value of every dimension, by resource name.
+        bool started = false; ///< Whether the process could acquire its own requirements and run.
+        EventDrivenScheduler::Report report; ///< Makespan and task counts; all zero if the process did not start.
+    };
+
+private:
+    const Process &prototype; ///< Process every variant is cloned from.
+    std::vector<Dimension> dimensions; ///< Resources varied by the sweep.
+
+    /**
+     * @brief Runs variants on worker threads.
+     * @param variants Capacities of every variant.
+     * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+     * @return The outcome of every variant, in the order of variants.
+     */
+    std::vector<Result> runVariants(const std::vector<std::map<std::string, int> > &variants,
+                                    std::size_t threadCount) const;
+
+public:
+    /**
+     * @brief Constructs a sweep without dimensions over a prototype process.
+     * @param prototype Process every variant is cloned from; it must outlive the sweep.
+     */
+    explicit CapacitySweep(const Process &prototype);
+
+    /**
+     * @brief Adds a resource to vary.
+     * @param resourceName Name of a resource of the prototype.
+     * @param values Capacities of a consumable, or unit counts of a usable resource.
+     * @throw std::invalid_argument If the list is empty, a value is not positive or the resource is already varied.
+     */
+    void addDimension(const std::string &resourceName, std::vector<int> values);
+
+    /**
+     * @brief Retrieves the number of combinations runGrid() runs.
+     * @return The product of the dimensions' value counts.
+     */
+    [[nodiscard]] std::size_t getGridSize() const;
+
+    /**
+     * @brief Runs every combination of the dimensions' values.
+     * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+     * @return The outcome of every variant, the last dimension varying fastest.
+     * @throw std::invalid_argument If a dimension names a resource the prototype does not have.
+     */
+    [[nodiscard]] std::vector<Result> runGrid(std::size_t threadCount = 0) const;
+
+    /**
+     * @brief Runs combinations drawn at random, each dimension's value uniformly among its values.
+     * @param sampleCount Number of variants to run.
+     * @param seed Seed of the random generator; equal seeds draw the same variants.
+     * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+     * @return The outcome of every variant, in drawing order.
+     * @throw std::invalid_argument If a dimension names a resource the prototype does not have.
+     */
+    [[nodiscard]] std::vector<Result> runSamples(std::size_t sampleCount, std::uint64_t seed,
+                                                 std::size_t threadCount = 0) const;
+};
+
+#endif //CAPACITY_SWEEP_H
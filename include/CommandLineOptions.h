@@ -0,0 +1,67 @@
+#ifndef COMMAND_LINE_OPTIONS_H
+#define COMMAND_LINE_OPTIONS_H
+
+#include "CapacitySweep.h"
+#include "FairShareScheduler.h"
+#include "Process.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings of the cpp_oop_review command-line driver.
+ *
+ * Holds the scenario files to simulate, how often and on how many threads to run them, and how the
+ * results are reported. When no scenario file is given the driver runs the built-in compilation scenario.
+ * With a task stream, the first process of the scenario runs as a service executing the streamed tasks.
+ * With a cache file, tasks that completed in an earlier run and did not change are skipped. With changed
+ * artifacts, each process then runs again the tasks those artifacts invalidate. With sweep dimensions, every
+ * process is instead run under each combination of the swept capacities and a table of outcomes is printed.
+ * With capacity planning, the minimum capacities of every process are printed instead of running it. With a
+ * fair-share policy, the processes of each scenario are instead simulated together on its shared resources.
+ */
+struct CommandLineOptions {
+    /// @brief Enumeration defining how simulation output and statistics are reported.
+    enum class OutputMode { Verbose, Quiet, Json };
+
+    std::vector<std::string> scenarioFiles; ///< Scenario files to load; empty selects the built-in scenario.
+    int repeatCount = 1; ///< Number of times each scenario is loaded and run.
+    int threadCount = 1; ///< Number of worker threads sharing the repetitions.
+    OutputMode outputMode = OutputMode::Verbose; ///< Reporting mode for simulation output and statistics.
+    Process::RequirementMatching requirementMatching = Process::RequirementMatching::NameScan; ///< How tasks are matched to resources.
+    Process::Scheduling scheduling = Process::Scheduling::Sequential; ///< How processes schedule their tasks.
+    EventDrivenScheduler::Admission admission = EventDrivenScheduler::Admission::FirstCome; ///< Event-driven admission.
+    int referenceCapacity = 0; ///< Usable capacity event-driven durations are measured on; zero to not scale.
+    Process::ResourceDelegation delegation = Process::ResourceDelegation::Usable; ///< Which resources processes lend to their tasks.
+    std::string metricsFile; ///< File receiving per-task and per-resource metrics as JSON; empty disables them.
+    std::string traceFile; ///< File receiving a Chrome trace of all runs; empty disables tracing.
+    std::string streamFile; ///< Source of streamed task directives, "-" for standard input; empty disables streaming.
+    int queueCapacity = 1024; ///< Number of streamed tasks buffered ahead of the running process.
+    std::string cacheFile; ///< File storing the completed tasks processes skip when unchanged; empty disables caching.
+    std::vector<std::string> changedInputs; ///< Artifacts whose dependent tasks are rerun after each process run.
+    std::vector<CapacitySweep::Dimension> sweepDimensions; ///< Capacities swept instead of running; empty runs normally.
+    bool planCapacities = false; ///< Whether to print the minimum capacities of every process instead of running.
+    std::optional<FairShareScheduler::Policy> fairShare; ///< Policy sharing one machine; none runs normally.
+    bool showHelp = false; ///< Whether the usage text was requested.
+
+    /**
+     * @brief Parses the program arguments.
+     * @param argc Number of arguments, including the program name.
+     * @param argv Argument values, including the program name.
+     * @return The parsed options.
+     * @throw std::invalid_argument If an option is unknown, lacks its value or has an invalid value, or if a
+     * task stream is combined with several scenarios, repetitions or threads, or with a sweep, or if capacity
+     * planning is combined with a task stream or a sweep, or if fair sharing is combined with either or with
+     * capacity planning.
+     */
+    static CommandLineOptions parse(int argc, const char *const argv[]);
+
+    /**
+     * @brief Builds the usage text of the driver.
+     * @param programName Name the program was invoked with.
+     * @return The multi-line usage text.
+     */
+    static std::string usage(const std::string &programName);
+};
+
+#endif //COMMAND_LINE_OPTIONS_H
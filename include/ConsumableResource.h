@@ -2,17 +2,26 @@
 #define CONSUMABLE_RESOURCE_H
 
 #include "Resource.h"
+#include <atomic>
 
 /**
  * @brief Consumable resource that depletes upon use, such as memory.
  *
  * This class extends Resource to model resources with a finite capacity that decreases with each allocation.
  * Once depleted, the resource requires external replenishment to become available again.
+ *
+ * Thread safety: allocate(), isAvailableForUse(), getRemainingCapacity() and use() may run concurrently with
+ * each other; allocate() takes each unit with a compare-and-swap, so no unit is handed out twice. release(),
+ * replenish(), restoreState() and availability listeners are not synchronised: callers sharing the resource
+ * between threads serialise them, as ResourceManager does under its shard locks.
  */
-class ConsumableResource final : public Resource {
+class ConsumableResource : public Resource {
 private:
+    bool depletionReported = false; ///< Whether release() already warned about the current depletion.
+
+protected:
     int totalCapacity; ///< Total capacity of the resource (e.g., total memory in MB).
-    int remainingCapacity; ///< Remaining capacity of the resource available for use.
+    std::atomic<int> remainingCapacity; ///< Remaining capacity, decremented with a compare-and-swap by allocate().
 
 public:
     /**
@@ -33,12 +42,20 @@ public:
 
     /**
      * @brief Allocates one unit of the resource, reducing its remaining capacity.
+     *
+     * Safe to call from several threads at once; only the allocation that takes the last unit updates the
+     * availability.
+     *
      * @throw std::runtime_error If no capacity remains to allocate.
      */
     void allocate() override;
 
     /**
      * @brief Releases the resource, updating availability status.
+     *
+     * The first release after the resource is depleted warns on std::cerr; later ones stay silent until a
+     * replenishment or restoreState() restores capacity.
+     *
      * @note Does not restore capacity; external replenishment is required.
      */
     void release() override;
@@ -52,7 +69,41 @@ public:
      * @brief Retrieves the remaining capacity of the resource.
      * @return The current remaining capacity in units (e.g., MB).
      */
-    [[nodiscard]] int getRemainingCapacity() const;
+    [[nodiscard]] virtual int getRemainingCapacity() const;
+
+    /**
+     * @brief Restores capacity, up to the total capacity of the resource.
+     * @param units The number of units to restore.
+     * @throw std::invalid_argument If units is not positive.
+     */
+    virtual void replenish(int units);
+
+    /**
+     * @brief Captures the availability and remaining capacity of the resource.
+     * @return The state, to be passed back to restoreState().
+     */
+    [[nodiscard]] State saveState() const override;
+
+    /**
+     * @brief Puts back the availability and remaining capacity captured by saveState().
+     * @param state The state to restore.
+     * @throw std::invalid_argument If the remaining capacity is negative or above the total capacity.
+     */
+    void restoreState(const State &state) override;
+
+    /**
+     * @brief Creates an independent copy of the resource in its current state, without its listeners.
+     * @return The copy.
+     */
+    [[nodiscard]] std::unique_ptr<Resource> clone() const override;
+
+    /**
+     * @brief Creates a resource of the same kind and name with another capacity, fully available.
+     * @param capacity Total capacity of the new resource.
+     * @return The new resource.
+     * @throw std::invalid_argument If the capacity is not positive.
+     */
+    [[nodiscard]] virtual std::unique_ptr<ConsumableResource> cloneWithCapacity(int capacity) const;
 };
 
 #endif //CONSUMABLE_RESOURCE_H
@@ -0,0 +1,100 @@
+#ifndef ELIGIBILITY_KERNEL_H
+#define ELIGIBILITY_KERNEL_H
+
+#include "ResourceIndex.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Evaluates the requirement masks of many tasks against a free mask at once.
+ *
+ * Masks are stored as a MaskTable, one array per 64-bit mask word (structure of arrays), so a vector
+ * register holds the same word of consecutive tasks: AVX2 checks four tasks per instruction and SSE2 two.
+ * Only the words that can hold registered groups are read, which for pools of up to 64 distinct resource
+ * names is a single word per task. The widest instruction set the processor supports is picked at run
+ * time; other processors and compilers use the portable scalar loop.
+ */
+class EligibilityKernel {
+public:
+    /// @brief Enumeration defining the instruction sets the kernel can run on, from narrowest to widest.
+    enum class InstructionSet { Scalar, Sse2, Avx2 };
+
+    /**
+     * @brief Requirement masks of a sequence of tasks, stored one array per mask word.
+     */
+    class MaskTable {
+    private:
+        std::array<std::vector<std::uint64_t>, ResourceIndex::WordCount> words; ///< Mask words by word, then task.
+
+    public:
+        /**
+         * @brief Appends the mask of the next task.
+         * @param mask The requirement mask.
+         */
+        void push_back(const ResourceIndex::Mask &mask);
+
+        /**
+         * @brief Replaces the mask of a task.
+         * @param index Position of the task.
+         * @param mask The requirement mask.
+         */
+        void assign(std::size_t index, const ResourceIndex::Mask &mask);
+
+        /**
+         * @brief Resizes the table, giving new tasks an empty mask.
+         * @param count The number of tasks.
+         */
+        void resize(std::size_t count);
+
+        /**
+         * @brief Removes all masks.
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the number of masks.
+         * @return The number of tasks in the table.
+         */
+        [[nodiscard]] std::size_t size() const { return words[0].size(); }
+
+        /**
+         * @brief Retrieves one word of every mask.
+         * @param word The word to retrieve.
+         * @return The word of each task, by position.
+         */
+        [[nodiscard]] const std::uint64_t *wordData(const std::size_t word) const { return words[word].data(); }
+
+        /**
+         * @brief Checks a single task's mask against a free mask.
+         * @param index Position of the task.
+         * @param freeMask The groups currently available.
+         * @param wordCount Number of leading mask words that can hold set bits.
+         * @return True if every required group is free.
+         */
+        [[nodiscard]] bool isSatisfied(std::size_t index, const ResourceIndex::Mask &freeMask,
+                                       std::size_t wordCount) const;
+    };
+
+    /**
+     * @brief Retrieves the widest instruction set supported by the processor and the build.
+     * @return The instruction set selectReady() uses by default.
+     */
+    static InstructionSet supportedInstructionSet();
+
+    /**
+     * @brief Collects the tasks whose requirements are all satisfied by a free mask.
+     * @param masks The requirement masks of the tasks.
+     * @param begin Position of the first task to evaluate.
+     * @param freeMask The groups currently available.
+     * @param wordCount Number of leading mask words that can hold set bits (at most ResourceIndex::WordCount).
+     * @param ready Receives the positions of the satisfied tasks from begin onwards, in increasing order.
+     * @param instructionSet The instruction set to run on.
+     * @throw std::invalid_argument If the instruction set is not supported or wordCount is too large.
+     */
+    static void selectReady(const MaskTable &masks, std::size_t begin, const ResourceIndex::Mask &freeMask,
+                            std::size_t wordCount, std::vector<std::size_t> &ready,
+                            InstructionSet instructionSet = supportedInstructionSet());
+};
+
+#endif //ELIGIBILITY_KERNEL_H
@@ -0,0 +1,263 @@
+#ifndef EVENT_DRIVEN_SCHEDULER_H
+#define EVENT_DRIVEN_SCHEDULER_H
+
+#include "ConsumableResource.h"
+#include "Executable.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Discrete-event simulation of a process's tasks over simulated time.
+ *
+ * Unlike the sequential loop of Process::execute, a started task holds its resources for its duration in
+ * units, so tasks overlap and compete. Readiness is event driven: a task whose dependencies completed is
+ * evaluated once; if one of its required resource names has fewer available units than it requires, the task
+ * joins that name's waiter list and is evaluated again only when that name gains free units, when a task
+ * completes or a replenishment refills it, even a consumable that never ran out. Waiters are then evaluated in
+ * arrival order until the first one the name still cannot serve, so each scheduling step touches the tasks
+ * affected by the event instead of every pending task. Requirements a task borrows from the enclosing process
+ * are shared by every task borrowing them and never waited for.
+ *
+ * Tasks that never start (a dependency did not complete, or a required resource never became available)
+ * are reported as skipped once no events remain. Events at the same time are applied before any task is
+ * evaluated, and newly unblocked tasks are evaluated in the order they were added, so runs are deterministic.
+ *
+ * That first-come order is the default Admission. The packing admissions instead keep one list of ready tasks
+ * and, at each scheduling point where tasks arrived or resources were freed, choose which of them to start
+ * together as a vector bin-packing problem over the free units of every resource name, counting a name
+ * required twice as two units. Choosing costs a pass over the ready tasks per scheduling point; backfilling
+ * also sorts the running tasks by completion time when the first ready task does not fit. BestFit instead
+ * groups ready tasks with equal demands and weighs the first of each group once per task it starts.
+ *
+ * With a reference capacity, durations are measured on a usable resource of that capacity, and a task runs at
+ * the pace of the slowest usable resource it is assigned: its duration is scaled by the reference capacity over
+ * that resource's capacity, rounded up. Mixed fast and slow processors then yield different makespans
+ * depending on where tasks are placed.
+ */
+class EventDrivenScheduler final : public Resource::AvailabilityListener {
+public:
+    /**
+     * @brief A consumable resource refill applied at a point of simulated time.
+     */
+    struct Replenishment {
+        std::string resourceName; ///< Name of the consumable resource to refill.
+        int units; ///< Units restored, up to the resource's total capacity.
+        int time; ///< Simulated time of the refill.
+    };
+
+    /**
+     * @brief Enumeration defining which ready tasks start when they compete for resources.
+     *
+     * FirstCome starts tasks in the order they became ready, a task that lacks a resource waiting for that
+     * name while later tasks may start. The packing admissions measure a task's demand on each name relative
+     * to the units the pool offers of it. FirstFitDecreasing starts every task that fits, in decreasing order
+     * of its summed relative demand. BestFit repeatedly starts the fitting task that leaves the least free
+     * capacity, as the Euclidean norm of the relative free units. DominantResource starts every task that fits,
+     * in decreasing order of its largest relative demand. Ties go to the task added first.
+     *
+     * Backfill is EASY backfilling on task durations: tasks start in the order they became ready until one
+     * does not fit; that task gets a reservation at the earliest time running tasks free enough units for it,
+     * and later tasks start now only if they complete by then or use units the reservation leaves spare.
+     *
+     * EarliestFinish is list scheduling in the manner of HEFT: ready tasks go in decreasing order of their
+     * upward rank, their expected duration plus the largest rank of the tasks depending on them, and each is
+     * placed on the fastest free usable resources of the names it requires. A task requiring one unit of a
+     * single usable name instead waits for a faster busy resource of that name when it would finish earlier
+     * there, counting from the completion of the task holding it and of the tasks already waiting for it.
+     */
+    enum class Admission { FirstCome, FirstFitDecreasing, BestFit, DominantResource, Backfill, EarliestFinish };
+
+    /**
+     * @brief Outcome of a simulation.
+     */
+    struct Report {
+        std::int64_t makespan = 0; ///< Simulated time at which the last task completed.
+        std::size_t completed = 0; ///< Number of tasks that completed.
+        std::size_t skipped = 0; ///< Number of tasks that never started.
+        std::size_t failed = 0; ///< Number of tasks that raised an error.
+        double utilisation = 0; ///< Share of the usable resources' time held by tasks until the makespan.
+    };
+
+private:
+    static constexpr std::size_t NoGroup = static_cast<std::size_t>(-1); ///< Stands for no resource group.
+
+    /// @brief Enumeration defining the progress of a task through the simulation.
+    enum class TaskState { Blocked, Waiting, Running, Completed, Failed };
+
+    /**
+     * @brief A task completion or a replenishment due at a point of simulated time.
+     */
+    struct Event {
+        std::int64_t time; ///< Simulated time of the event.
+        std::uint64_t sequence; ///< Scheduling order, breaking ties between events at the same time.
+        bool replenishment; ///< True for a replenishment, false for a task completion.
+        std::size_t index; ///< Position of the completing task or of the replenishment.
+    };
+
+    const std::vector<std::unique_ptr<Resource> > &resourcePool; ///< Resources the tasks compete for.
+    const std::vector<std::unique_ptr<Executable> > &tasks; ///< Tasks to simulate.
+    const std::vector<Replenishment> &replenishments; ///< Refills applied during the simulation.
+    Admission admission; ///< Which ready tasks start when they compete for resources.
+    int referenceCapacity; ///< Capacity durations are measured on; zero leaves durations unscaled.
+    std::vector<std::size_t> requirementOffsets; ///< Start of each task's groups in requirementGroups.
+    std::vector<std::size_t> requirementGroups; ///< Required resource groups of all tasks, task after task.
+    std::vector<std::size_t> demandOffsets; ///< Start of each task's demands in demands.
+    std::vector<std::pair<std::size_t, int> > demands; ///< Units required of each distinct group, task after task.
+    std::vector<std::size_t> poolGroups; ///< Group of each resource of the pool, by position.
+    std::vector<int> availableCounts; ///< Number of available resources per group.
+    std::vector<std::vector<const ConsumableResource *> > consumables; ///< Consumables of each group, none if usable.
+    std::vector<double> groupUnits; ///< Units each group offered at the start, which relative demands divide.
+    std::vector<double> admissionKeys; ///< Size or upward rank of each task, larger first, for the admissions.
+    std::vector<char> unattainable; ///< Whether each task requires more usable units than its groups offer.
+    std::vector<std::size_t> ready; ///< Ready tasks the packing admissions choose from, in admission order.
+    std::vector<std::size_t> demandClasses; ///< Class of each task, shared by tasks of equal demands, for BestFit.
+    std::vector<std::vector<std::size_t> > readyByClass; ///< Ready tasks of each class, as min-heaps on position.
+    std::vector<std::size_t> activeClasses; ///< Classes with ready tasks, for BestFit.
+    bool capacityFreed = false; ///< Whether units were released or refilled since the ready tasks were last packed.
+    double usableUnits = 0; ///< Usable resources available to the tasks at the start.
+    double heldUnitTime = 0; ///< Sum over started tasks of their usable units times their duration.
+    std::vector<std::vector<Resource *> > placementOrder; ///< Resources of each group, fastest first if placing.
+    std::vector<const std::vector<Resource *> *> placements; ///< Candidates of each requirement of a started task.
+    std::unordered_map<const Resource *, std::int64_t> releaseTimes; ///< When each assigned usable is released.
+    std::unordered_map<const Resource *, std::int64_t> reservations; ///< Until when waiting tasks claim busy ones.
+    std::vector<std::deque<std::size_t> > waiters; ///< Tasks waiting for each group, in arrival order.
+    std::vector<std::size_t> wokenGroups; ///< Groups that became available since waiters were last moved.
+    std::vector<TaskState> states; ///< State of each task.
+    std::vector<Event> events; ///< Pending events, as a min-heap on time and sequence.
+    std::uint64_t nextSequence = 0; ///< Sequence number of the next scheduled event.
+
+    /**
+     * @brief Adds an event to the pending events.
+     * @param time Simulated time of the event.
+     * @param replenishment True for a replenishment, false for a task completion.
+     * @param index Position of the completing task or of the replenishment.
+     */
+    void schedule(std::int64_t time, bool replenishment, std::size_t index);
+
+    /**
+     * @brief Starts a task if all its required groups have enough free units, or queues it on the first short one.
+     * @param task Position of the task.
+     * @param time Current simulated time.
+     * @param report Report receiving failures.
+     */
+    void evaluate(std::size_t task, std::int64_t time, Report &report);
+
+    /**
+     * @brief Assigns a task's resources and schedules its completion, or records its failure.
+     * @param task Position of the task.
+     * @param time Current simulated time.
+     * @param report Report receiving failures.
+     */
+    void start(std::size_t task, std::int64_t time, Report &report);
+
+    /**
+     * @brief Retrieves the units a group can serve right now.
+     * @param group The group.
+     * @return The remaining units of its consumables, or its number of available usable resources.
+     */
+    [[nodiscard]] long long freeUnits(std::size_t group) const;
+
+    /**
+     * @brief Orders the resources of each group fastest first and sets each task's key to its upward rank.
+     */
+    void rankByEarliestFinish();
+
+    /**
+     * @brief Scales a duration to the pace of a usable resource.
+     * @param duration Duration on a resource of the reference capacity.
+     * @param capacity Capacity of the resource.
+     * @return The duration rounded up, or unchanged without a reference capacity.
+     */
+    [[nodiscard]] std::int64_t scaleDuration(std::int64_t duration, double capacity) const;
+
+    /**
+     * @brief Bounds the duration of a task started now, whichever free resources it is assigned.
+     * @param task Position of the task, which fits right now.
+     * @return Its duration scaled to the slowest free usable resource of the groups it requires.
+     */
+    [[nodiscard]] std::int64_t longestDuration(std::size_t task) const;
+
+    /**
+     * @brief Checks whether a task would finish earlier on a faster busy resource than on the free ones, and if so
+     * reserves that resource for it until the next scheduling point.
+     * @param task Position of the task, which fits right now.
+     * @param time Current simulated time.
+     * @return True if the task requires one unit of a single usable group and one of its busy resources, faster
+     * than its fastest free one, would complete the task earlier once released and once the tasks that reserved
+     * it before complete.
+     */
+    bool waitsForFasterUnit(std::size_t task, std::int64_t time);
+
+    /**
+     * @brief Finds the first group that cannot serve a task's demand right now.
+     * @param task Position of the task.
+     * @return The first group with fewer free units than the task requires of it, or NoGroup if it fits.
+     */
+    [[nodiscard]] std::size_t findShortage(std::size_t task) const;
+
+    /**
+     * @brief Adds newly ready tasks to the ready list and starts the tasks the packing admission chooses.
+     * @param arrivals Tasks whose dependencies completed since the last call; emptied.
+     * @param time Current simulated time.
+     * @param report Report receiving failures.
+     */
+    void admit(std::vector<std::size_t> &arrivals, std::int64_t time, Report &report);
+
+    /**
+     * @brief Adds newly ready tasks to their demand classes and repeatedly starts the fitting task that leaves the
+     * least free capacity.
+     * @param arrivals Tasks whose dependencies completed since the last call; emptied.
+     * @param time Current simulated time.
+     * @param report Report receiving failures.
+     */
+    void packBestFit(std::vector<std::size_t> &arrivals, std::int64_t time, Report &report);
+
+    /**
+     * @brief Starts ready tasks in order, then backfills around a reservation for the first that does not fit.
+     * @param time Current simulated time.
+     * @param report Report receiving failures.
+     */
+    void backfill(std::int64_t time, Report &report);
+
+public:
+    /**
+     * @brief Prepares a simulation and starts observing the pool's availability.
+     * @param resourcePool Resources the tasks compete for; they must outlive the scheduler.
+     * @param tasks Tasks to simulate.
+     * @param replenishments Refills applied during the simulation.
+     * @param admission Which ready tasks start when they compete for resources.
+     * @param referenceCapacity Capacity durations are measured on; zero leaves durations unscaled.
+     */
+    EventDrivenScheduler(const std::vector<std::unique_ptr<Resource> > &resourcePool,
+                         const std::vector<std::unique_ptr<Executable> > &tasks,
+                         const std::vector<Replenishment> &replenishments,
+                         Admission admission = Admission::FirstCome, int referenceCapacity = 0);
+
+    /**
+     * @brief Stops observing the pool.
+     */
+    ~EventDrivenScheduler() override;
+
+    EventDrivenScheduler(const EventDrivenScheduler &) = delete;
+    EventDrivenScheduler &operator=(const EventDrivenScheduler &) = delete;
+
+    /**
+     * @brief Runs the simulation until no event remains.
+     * @return The outcome of the simulation.
+     */
+    Report run();
+
+    /**
+     * @brief Updates the available count of a group, waking its waiters when it becomes available.
+     * @param tag The group of the resource.
+     * @param available True if the resource became available, false if it became unavailable.
+     */
+    void availabilityChanged(std::size_t tag, bool available) override;
+};
+
+#endif //EVENT_DRIVEN_SCHEDULER_H
@@ -2,6 +2,8 @@
 #define EXECUTABLE_H
 
 #include "Resource.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,7 +20,25 @@ protected:
     std::string description; ///< Descriptive text explaining the entity's purpose.
     std::vector<std::string> requiredResourcesNames; ///< Names of resources required for execution.
     int durationInUnits; ///< Duration of execution in abstract time units.
+    std::vector<std::string> dependencyNames; ///< Names of executables that must complete before this one.
+    std::vector<std::string> inputNames; ///< Artifacts, such as source files, the entity reads.
+    std::vector<std::string> outputNames; ///< Artifacts, such as object files, the entity produces.
     std::vector<Resource*> assignedResources; ///< Pointers to resources currently assigned.
+    std::vector<std::uint64_t> holdSpanIds; ///< Trace span of each assigned resource's hold, or 0 when not traced.
+    std::vector<Resource*> borrowedResources; ///< Resources lent per requirement by the enclosing process, or nullptr.
+    std::size_t borrowedCount = 0; ///< Number of requirements met by borrowed resources.
+
+    /**
+     * @brief Displays the usage of the assigned and borrowed resources, in requirement order.
+     */
+    void useResources() const;
+
+    /**
+     * @brief Copies the dependencies and the input and output artifacts another executable declares.
+     * @param other The executable to copy the declarations of.
+     */
+    void copyDeclarationsFrom(const Executable &other);
+
 public:
     /**
      * @brief Constructs an Executable entity.
@@ -42,6 +62,12 @@ public:
     */
     [[nodiscard]] std::string getName() const;
 
+    /**
+     * @brief Retrieves the description of the entity's purpose.
+     * @return The description.
+     */
+    [[nodiscard]] const std::string& getDescription() const;
+
     /**
      * @brief Retrieves the names of required resources.
      * @return A constant reference to the vector of resource names.
@@ -54,6 +80,45 @@ public:
      */
     [[nodiscard]] int getDurationInUnits() const;
 
+    /**
+     * @brief Declares that another executable of the same process must complete before this one.
+     * @param executableName Name of the executable this one depends on.
+     * @throw std::invalid_argument If the name is empty or names this executable.
+     */
+    void addDependency(const std::string &executableName);
+
+    /**
+     * @brief Retrieves the names of executables this one depends on.
+     * @return A constant reference to the vector of dependency names.
+     */
+    [[nodiscard]] const std::vector<std::string>& getDependencyNames() const;
+
+    /**
+     * @brief Declares an artifact the entity reads, so that a change to it invalidates the entity.
+     * @param inputName Name of the artifact, such as a source file.
+     * @throw std::invalid_argument If the name is empty.
+     */
+    void addInput(const std::string &inputName);
+
+    /**
+     * @brief Retrieves the artifacts the entity reads.
+     * @return A constant reference to the vector of input names.
+     */
+    [[nodiscard]] const std::vector<std::string>& getInputNames() const;
+
+    /**
+     * @brief Declares an artifact the entity produces, so that entities reading it are invalidated with it.
+     * @param outputName Name of the artifact, such as an object file.
+     * @throw std::invalid_argument If the name is empty.
+     */
+    void addOutput(const std::string &outputName);
+
+    /**
+     * @brief Retrieves the artifacts the entity produces.
+     * @return A constant reference to the vector of output names.
+     */
+    [[nodiscard]] const std::vector<std::string>& getOutputNames() const;
+
     /**
      * @brief Assigns required resources from a pool.
      * @param resourcePool The pool of available resources.
@@ -62,20 +127,77 @@ public:
     void assignResources(const std::vector<std::unique_ptr<Resource>>& resourcePool);
 
     /**
-     * @brief Releases all assigned resources.
+     * @brief Assigns required resources from groups already resolved for each requirement.
+     *
+     * Allocates, for each requirement in order, the first available resource of its group, exactly as the
+     * name-based overload does for the pool's resources of that name, but without comparing names.
+     *
+     * @param requirementGroups Candidate resources of each required name, in requirement order.
+     * @throw std::runtime_error If a group has no available resource or the groups do not match the requirements.
+     */
+    void assignResources(const std::vector<const std::vector<Resource*>*>& requirementGroups);
+
+    /**
+     * @brief Releases all assigned resources; borrowed resources stay with their lender.
      */
     void releaseResources();
 
+    /**
+     * @brief Borrows resources an enclosing process holds instead of allocating them from the pool.
+     *
+     * Each requirement takes the first unclaimed loan carrying its name. Borrowed requirements are skipped
+     * by canExecute() and assignResources(), and releaseResources() leaves them allocated to the lender.
+     *
+     * @param loans Names and resources the enclosing process lends.
+     */
+    void borrowResources(const std::vector<std::pair<std::string, Resource*>>& loans);
+
+    /**
+     * @brief Gives back every borrowed resource.
+     */
+    void returnBorrowedResources();
+
+    /**
+     * @brief Forgets every assigned and borrowed resource without releasing it, as when the resources' own
+     * state is restored from a snapshot.
+     */
+    void forgetResources();
+
+    /**
+     * @brief Checks whether a requirement is met by a borrowed resource.
+     * @param requirement Position of the requirement.
+     * @return True if the requirement is borrowed.
+     */
+    [[nodiscard]] bool isBorrowed(std::size_t requirement) const;
+
+    /**
+     * @brief Retrieves the number of borrowed requirements.
+     * @return The number of requirements met by borrowed resources.
+     */
+    [[nodiscard]] std::size_t getBorrowedCount() const;
+
+    /**
+     * @brief Retrieves the resources currently assigned to the entity.
+     * @return A constant reference to the assigned resources, in requirement order, without borrowed ones.
+     */
+    [[nodiscard]] const std::vector<Resource*>& getAssignedResources() const;
+
     /**
      * @brief Executes the entity using assigned resources.
      * @throw std::runtime_error If resources are not properly assigned.
      */
     virtual void execute() const = 0;
 
+    /**
+     * @brief Creates an independent copy of the entity's definition, without assigned or borrowed resources.
+     * @return The copy.
+     */
+    [[nodiscard]] virtual std::unique_ptr<Executable> clone() const = 0;
+
     /**
      * @brief Checks if the entity can be executed with the given resource pool.
      * @param resourcePool The pool of available resources.
-     * @return True if all required resources are available, false otherwise.
+     * @return True if all required resources that are not borrowed are available, false otherwise.
      */
     [[nodiscard]] bool canExecute(const std::vector<std::unique_ptr<Resource>>& resourcePool) const;
 };
@@ -0,0 +1,189 @@
+#ifndef EXECUTION_METRICS_H
+#define EXECUTION_METRICS_H
+
+#include "ThreadShards.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Low-overhead counters and latency histograms of process executions.
+ *
+ * Tasks and resources are identified by their position in the process (task order and resource pool
+ * order). Every thread records into its own shard without locking; shards are merged when the metrics are
+ * read, so recording costs a few increments on the hot path. One instance may be shared by several
+ * processes with the same layout, e.g. the repetitions of a scenario, to aggregate their executions.
+ */
+class ExecutionMetrics {
+public:
+    /**
+     * @brief Histogram of nanosecond latencies with power-of-two buckets.
+     *
+     * Buckets are allocated up to the largest one holding a sample, so a histogram of short latencies takes a few
+     * dozen words and one can be kept per task.
+     */
+    struct Histogram {
+        static constexpr std::size_t BucketCount = 64; ///< Bucket i holds values in [2^(i-1), 2^i).
+        std::vector<std::uint64_t> buckets; ///< Number of samples per bucket, up to the last non-empty one.
+        std::uint64_t count = 0; ///< Number of samples.
+        std::uint64_t sum = 0; ///< Sum of all samples.
+        std::uint64_t max = 0; ///< Largest sample.
+
+        /**
+         * @brief Records one sample.
+         * @param nanoseconds The latency to record.
+         */
+        void record(std::uint64_t nanoseconds);
+
+        /**
+         * @brief Adds the samples of another histogram.
+         * @param other The histogram to add.
+         */
+        void merge(const Histogram &other);
+
+        /**
+         * @brief Estimates a percentile as the upper bound of the bucket containing it.
+         * @param fraction The percentile as a fraction in [0, 1].
+         * @return The estimated latency in nanoseconds; 0 if the histogram is empty.
+         */
+        [[nodiscard]] std::uint64_t percentile(double fraction) const;
+    };
+
+    /**
+     * @brief Counters of one task.
+     */
+    struct TaskCounters {
+        std::uint64_t executions = 0; ///< Completed executions.
+        std::uint64_t skips = 0; ///< Executions skipped for missing resources or dependencies.
+        std::uint64_t failures = 0; ///< Executions that raised an error.
+        Histogram waitTime; ///< Time between the start of the process and the task.
+        Histogram runTime; ///< Time from resource assignment to release.
+    };
+
+    /**
+     * @brief Counters of one resource of the pool.
+     */
+    struct ResourceCounters {
+        std::uint64_t acquisitions = 0; ///< Successful allocations.
+        std::uint64_t contentionFailures = 0; ///< Times a requester found the resource unavailable.
+        Histogram holdTime; ///< Time between allocation and release.
+    };
+
+    /**
+     * @brief Merged view of all shards.
+     */
+    struct Snapshot {
+        std::vector<TaskCounters> tasks; ///< Counters per task position.
+        std::vector<ResourceCounters> resources; ///< Counters per resource position.
+        Histogram taskWait; ///< Wait times of all tasks.
+        Histogram taskRun; ///< Run times of all tasks.
+        std::uint64_t processRuns = 0; ///< Number of process executions.
+        std::uint64_t processNanoseconds = 0; ///< Total time spent executing the process.
+    };
+
+private:
+    /**
+     * @brief Counters recorded by a single thread.
+     */
+    struct Shard {
+        Snapshot data; ///< Counters of this thread.
+    };
+
+    ThreadShards<Shard> shards; ///< Shards by recording thread.
+
+    /**
+     * @brief Retrieves the counters of a task in the calling thread's shard.
+     * @param task Position of the task.
+     * @return The task counters.
+     */
+    TaskCounters &taskCounters(std::size_t task);
+
+    /**
+     * @brief Retrieves the counters of a resource in the calling thread's shard.
+     * @param resource Position of the resource.
+     * @return The resource counters.
+     */
+    ResourceCounters &resourceCounters(std::size_t resource);
+
+public:
+    /**
+     * @brief Constructs an empty set of metrics.
+     */
+    ExecutionMetrics();
+
+    /**
+     * @brief Records that a task started after waiting since the start of its process.
+     * @param task Position of the task.
+     * @param waitNanoseconds Time since the process started executing.
+     */
+    void recordTaskStarted(std::size_t task, std::uint64_t waitNanoseconds);
+
+    /**
+     * @brief Records that a task completed.
+     * @param task Position of the task.
+     * @param runNanoseconds Time from resource assignment to release.
+     */
+    void recordTaskCompleted(std::size_t task, std::uint64_t runNanoseconds);
+
+    /**
+     * @brief Records that a task was skipped.
+     * @param task Position of the task.
+     */
+    void recordTaskSkipped(std::size_t task);
+
+    /**
+     * @brief Records that a task raised an error.
+     * @param task Position of the task.
+     */
+    void recordTaskFailed(std::size_t task);
+
+    /**
+     * @brief Records a successful allocation of a resource.
+     * @param resource Position of the resource.
+     */
+    void recordAcquisition(std::size_t resource);
+
+    /**
+     * @brief Records that a requester found a resource unavailable.
+     * @param resource Position of the resource.
+     */
+    void recordContention(std::size_t resource);
+
+    /**
+     * @brief Records how long a resource was held.
+     * @param resource Position of the resource.
+     * @param nanoseconds Time between allocation and release.
+     */
+    void recordHold(std::size_t resource, std::uint64_t nanoseconds);
+
+    /**
+     * @brief Records one execution of the process.
+     * @param nanoseconds Duration of the execution.
+     */
+    void recordProcessRun(std::uint64_t nanoseconds);
+
+    /**
+     * @brief Merges the shards of all threads.
+     * @return The merged counters.
+     * @note Reads shards without synchronising with recording threads; call it once they are quiescent.
+     */
+    [[nodiscard]] Snapshot snapshot() const;
+
+    /**
+     * @brief Discards all recorded values.
+     */
+    void reset();
+
+    /**
+     * @brief Writes the merged metrics as a JSON object.
+     * @param output The stream to write to.
+     * @param processName Name of the measured process.
+     * @param taskNames Names of the tasks by position.
+     * @param resourceNames Names of the resources by position.
+     */
+    void writeJson(std::ostream &output, const std::string &processName, const std::vector<std::string> &taskNames,
+                   const std::vector<std::string> &resourceNames) const;
+};
+
+#endif //EXECUTION_METRICS_H
@@ -0,0 +1,133 @@
+#ifndef EXECUTION_PLAN_H
+#define EXECUTION_PLAN_H
+
+#include "Executable.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Requirements and dependencies of a process's tasks, resolved once against its resource pool.
+ *
+ * Every distinct resource name of the pool becomes a group listing its resources in pool order, and each
+ * requirement points to the group of its name, so executing the plan never compares names. Dependencies are
+ * resolved to the first task carrying the dependency's name; the others follow through getNextWithSameName().
+ *
+ * Tasks that can never run are flagged with the reason: a required name no resource carries or the process
+ * lends, a name required more often than the pool and the loans can supply (one per usable resource or loan
+ * plus the remaining capacity of consumable ones), a dependency on a name no task carries, or a dependency
+ * whose tasks are all flagged.
+ * The plan reflects the pool and tasks at the time it was built.
+ */
+class ExecutionPlan {
+public:
+    using ResourceGroup = std::vector<Resource *>; ///< Resources sharing a name, in pool order.
+
+    static constexpr std::size_t NoTask = static_cast<std::size_t>(-1); ///< Position standing for no task.
+
+    /**
+     * @brief Resolved requirements and dependencies of one task.
+     */
+    struct Step {
+        std::vector<const ResourceGroup *> requirements; ///< Group of each required name, in requirement order.
+        std::vector<std::size_t> dependencies; ///< First task named by each dependency, or NoTask.
+        std::string infeasibility; ///< Why the task can never run; empty if it can.
+    };
+
+private:
+    std::vector<ResourceGroup> groups; ///< Resource groups, by first appearance in the pool, then lent-only names.
+    std::vector<long long> loans; ///< Number of loans of each group.
+    std::vector<std::size_t> nextWithSameName; ///< Next task sharing each task's name, or NoTask.
+    std::vector<Step> steps; ///< Steps of the tasks, by position.
+    Step ownStep; ///< Resolved requirements of the process itself.
+    std::size_t infeasibleCount = 0; ///< Number of tasks that can never run.
+
+    /**
+     * @brief Resolves a list of required names.
+     * @param names The required resource names.
+     * @param groupsByName Position of the group of each name.
+     * @param supply Units each group can supply.
+     * @param step Step receiving the requirements and, if they cannot be met, the reason.
+     * @param lending True to count the loans of the process, false to count the pool alone.
+     */
+    void resolveRequirements(const std::vector<std::string> &names,
+                             const std::unordered_map<std::string, std::size_t> &groupsByName,
+                             const std::vector<long long> &supply, Step &step, bool lending) const;
+
+public:
+    /**
+     * @brief Resolves the requirements and dependencies of a process.
+     * @param resourcePool The pool of the process.
+     * @param tasks The tasks of the process.
+     * @param ownRequirements The resource names the process itself requires.
+     * @param lentNames Names of the resources the process lends to its tasks, once per loan.
+     */
+    ExecutionPlan(const std::vector<std::unique_ptr<Resource> > &resourcePool,
+                  const std::vector<std::unique_ptr<Executable> > &tasks,
+                  const std::vector<std::string> &ownRequirements,
+                  const std::vector<std::string> &lentNames = {});
+
+    /**
+     * @brief Retrieves the step of a task.
+     * @param index Position of the task.
+     * @return The resolved step.
+     */
+    [[nodiscard]] const Step &getStep(std::size_t index) const { return steps[index]; }
+
+    /**
+     * @brief Retrieves the next task carrying the same name as a task.
+     * @param index Position of the task.
+     * @return Position of the next task with that name, or NoTask if it is the last one.
+     */
+    [[nodiscard]] std::size_t getNextWithSameName(std::size_t index) const;
+
+    /**
+     * @brief Checks whether any task of a dependency matches a condition.
+     * @param first First task named by the dependency, as stored in Step::dependencies.
+     * @param predicate Condition on a task position.
+     * @return True if some task carrying the name matches.
+     */
+    template<typename Predicate>
+    [[nodiscard]] bool anyNamed(std::size_t first, Predicate predicate) const {
+        for (auto index = first; index != NoTask; index = nextWithSameName[index]) {
+            if (predicate(index)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Retrieves the number of steps.
+     * @return The number of tasks the plan was built for.
+     */
+    [[nodiscard]] std::size_t getStepCount() const;
+
+    /**
+     * @brief Retrieves the resolved requirements of the process itself.
+     * @return The step of the process; its infeasibility tells whether the process can ever start.
+     */
+    [[nodiscard]] const Step &getOwnStep() const;
+
+    /**
+     * @brief Retrieves the number of tasks that can never run.
+     * @return The number of flagged tasks.
+     */
+    [[nodiscard]] std::size_t getInfeasibleCount() const;
+
+    /**
+     * @brief Checks whether every requirement of a step currently has an available resource.
+     * @param step The step to check.
+     * @return True if each required group has an available resource.
+     */
+    [[nodiscard]] static bool isSatisfied(const Step &step);
+
+    /**
+     * @brief Checks whether every requirement of a step that the task does not borrow has an available resource.
+     * @param step The step to check.
+     * @param task The task of the step, with its loans already borrowed.
+     * @return True if each required group that is not borrowed has an available resource.
+     */
+    [[nodiscard]] static bool isSatisfied(const Step &step, const Executable &task);
+};
+
+#endif //EXECUTION_PLAN_H
@@ -0,0 +1,120 @@
+#ifndef FAIR_SHARE_SCHEDULER_H
+#define FAIR_SHARE_SCHEDULER_H
+
+#include "Process.h"
+#include "ResourceManager.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Discrete-event simulation of several processes whose tasks compete for the resources of one machine.
+ *
+ * Each process contributes its tasks and its weight. A task draws the names its process's pool carries from
+ * that pool and every other name from the machine, a ResourceManager shared by all the processes; usable units
+ * return when the task completes, consumable units never do. The processes themselves hold nothing, so their
+ * own requirements are not drawn. Tasks of one process start in the order they became ready, the first one
+ * waiting for resources holding back the others, like a queue per process.
+ *
+ * At each scheduling point the policy chooses which process starts its next task. FirstCome takes the task
+ * that became ready first, so a process with many ready tasks takes the machine until they have all started.
+ * DominantResource is weighted dominant resource fairness: each process's share of a machine name is the
+ * units its tasks hold or consumed over the units the machine offered, its dominant share is its largest one,
+ * and the process with the smallest dominant share divided by its weight goes next. Ties go to the process
+ * added first. The simulation accounts units by name, without allocating the resources themselves, so neither
+ * the machine nor the processes' pools are changed.
+ */
+class FairShareScheduler {
+public:
+    /**
+     * @brief Enumeration defining which process starts its next task when several can.
+     */
+    enum class Policy { FirstCome, DominantResource };
+
+    /**
+     * @brief Outcome of a simulation for one process.
+     */
+    struct ProcessReport {
+        std::string processName; ///< Name of the process.
+        double weight = 1; ///< Weight of the process.
+        std::size_t completed = 0; ///< Number of its tasks that completed.
+        std::size_t skipped = 0; ///< Number of its tasks that never started.
+        std::int64_t finishTime = 0; ///< Simulated time at which its last task completed.
+        double throughput = 0; ///< Completed tasks per unit of simulated time until its finish time.
+        double meanLatency = 0; ///< Mean time from one of its tasks becoming ready to its completion.
+        std::int64_t maxLatency = 0; ///< Longest time from one of its tasks becoming ready to its completion.
+        double peakShare = 0; ///< Largest dominant share of the machine its tasks held at once.
+    };
+
+    /**
+     * @brief Outcome of a simulation.
+     */
+    struct Report {
+        std::int64_t makespan = 0; ///< Simulated time at which the last task completed.
+        std::vector<ProcessReport> processes; ///< Outcome of each process, in the order they were added.
+    };
+
+private:
+    /**
+     * @brief A task of one of the processes, with its demand resolved to groups.
+     */
+    struct TaskInfo {
+        std::string name; ///< Name of the task.
+        std::vector<std::string> dependencyNames; ///< Names of the tasks of its process it depends on.
+        std::int64_t duration; ///< Simulated time the task holds its resources.
+        std::size_t process; ///< Position of its process.
+        bool attainable; ///< Whether every group it requires can ever serve its demand.
+    };
+
+    /**
+     * @brief A process competing for the machine.
+     */
+    struct Tenant {
+        std::string name; ///< Name of the process.
+        double weight; ///< Weight dividing its dominant share.
+        std::size_t taskCount; ///< Number of its tasks.
+    };
+
+    /**
+     * @brief A task completion due at a point of simulated time.
+     */
+    struct Event {
+        std::int64_t time; ///< Simulated time of the completion.
+        std::uint64_t sequence; ///< Scheduling order, breaking ties between completions at the same time.
+        std::size_t task; ///< Position of the completing task.
+    };
+
+    Policy policy; ///< Which process starts its next task when several can.
+    std::size_t machineGroupCount; ///< Number of machine names, which come first among the groups.
+    std::unordered_map<std::string, std::size_t> machineGroups; ///< Group of each machine name.
+    std::vector<long long> offeredUnits; ///< Units each group offered at the start.
+    std::vector<char> consumableGroups; ///< Whether each group's units are consumed rather than given back.
+    std::vector<TaskInfo> taskInfos; ///< Tasks of all processes, process after process.
+    std::vector<std::size_t> demandOffsets{0}; ///< Start of each task's demands in demands.
+    std::vector<std::pair<std::size_t, long long> > demands; ///< Units required of each distinct group.
+    std::vector<Tenant> tenants; ///< Processes, in the order they were added.
+
+public:
+    /**
+     * @brief Prepares a simulation over the units a machine can serve right now.
+     * @param machine The machine the processes share.
+     * @param policy Which process starts its next task when several can.
+     */
+    explicit FairShareScheduler(ResourceManager &machine, Policy policy = Policy::DominantResource);
+
+    /**
+     * @brief Adds the tasks of a process, resolving their requirements against its pool and the machine.
+     * @param process The process; its tasks are copied, so it need not outlive the scheduler.
+     */
+    void addProcess(const Process &process);
+
+    /**
+     * @brief Runs the simulation until every task that can start has completed.
+     * @return The outcome of the simulation.
+     */
+    [[nodiscard]] Report run() const;
+};
+
+#endif //FAIR_SHARE_SCHEDULER_H
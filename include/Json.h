@@ -0,0 +1,25 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+
+/**
+ * @brief Helpers shared by the machine-readable (JSON) reports.
+ */
+namespace Json {
+    /**
+     * @brief Escapes a string for inclusion in a JSON document.
+     * @param text The text to escape.
+     * @return The escaped text, without surrounding quotes.
+     */
+    std::string escape(const std::string &text);
+
+    /**
+     * @brief Quotes and escapes a string as a JSON string literal.
+     * @param text The text to quote.
+     * @return The JSON string literal.
+     */
+    std::string quote(const std::string &text);
+}
+
+#endif //JSON_H
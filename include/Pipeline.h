@@ -0,0 +1,144 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "Resource.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pipeline-parallel execution of many input items through a chain of stages sharing one resource pool.
+ *
+ * Each stage is a task template: for every input item, such as a source file, the stage instantiates a Task
+ * named after the stage and the item, with the stage's requirements and duration. Stages run concurrently on
+ * worker threads of their own, as many per stage as its parallelism, and pass items downstream through
+ * bounded queues, so a stage that falls behind stops the stages feeding it instead of letting items pile up.
+ * Once the pipeline is full, throughput is set by the slowest stage rather than by the sum of the stages.
+ *
+ * Workers take resources from the pool under one lock and wait while the resources a task requires are held
+ * by other workers; loans of the enclosing process are borrowed by every task and shared between workers. An
+ * item whose task can never get its resources (nothing is running that could release them) fails at that
+ * stage and goes no further. With a positive unit time, a task holds its resources for its duration
+ * multiplied by the unit time, which makes stage costs observable in wall-clock time.
+ */
+class Pipeline {
+public:
+    /**
+     * @brief Task template of one stage.
+     */
+    struct Stage {
+        std::string name; ///< Stage name, such as ScanSourceCode; tasks are named "<name>(<item>)".
+        std::string description; ///< Description of the stage's tasks.
+        std::vector<std::string> requiredResourcesNames; ///< Resources every task of the stage requires.
+        int durationInUnits = 1; ///< Duration of every task of the stage.
+        std::size_t parallelism = 1; ///< Number of worker threads running the stage.
+    };
+
+    /**
+     * @brief Settings of a pipeline run.
+     */
+    struct Options {
+        std::size_t queueCapacity = 16; ///< Items buffered between two stages.
+        std::chrono::nanoseconds unitTime{0}; ///< Wall-clock time a task holds its resources per duration unit.
+    };
+
+    /**
+     * @brief Outcome of a pipeline run.
+     */
+    struct Report {
+        std::size_t completed = 0; ///< Items that went through every stage.
+        std::size_t failed = 0; ///< Items stopped at a stage that could not run.
+        std::uint64_t elapsedNanoseconds = 0; ///< Wall-clock time of the run.
+    };
+
+private:
+    /**
+     * @brief Bounded blocking queue of item positions between two stages.
+     */
+    class Channel {
+    private:
+        std::mutex mutex; ///< Guards the items and the producer count.
+        std::condition_variable changed; ///< Signalled when an item is added or removed, or a producer finishes.
+        std::deque<std::size_t> items; ///< Positions of the queued items.
+        std::size_t capacity; ///< Maximum number of queued items.
+        std::size_t openProducers; ///< Producers still writing; the channel closes when the last one finishes.
+
+    public:
+        /**
+         * @brief Constructs an empty channel.
+         * @param capacity Maximum number of queued items.
+         * @param producers Number of producers writing to the channel.
+         */
+        Channel(std::size_t capacity, std::size_t producers);
+
+        /**
+         * @brief Adds an item, waiting while the channel is full.
+         * @param item Position of the item.
+         */
+        void push(std::size_t item);
+
+        /**
+         * @brief Takes the oldest item, waiting until one arrives or every producer finished.
+         * @param item Receives the position of the item.
+         * @return False once every producer finished and the channel is empty.
+         */
+        bool pop(std::size_t &item);
+
+        /**
+         * @brief Records that one producer finished writing.
+         */
+        void finishProducer();
+    };
+
+    const std::vector<std::unique_ptr<Resource> > &resourcePool; ///< Resources the stages share.
+    std::vector<Stage> stages; ///< Stages, in pipeline order.
+    Options options; ///< Settings of the runs.
+    std::mutex poolMutex; ///< Guards every allocation and release of pool resources.
+    std::condition_variable poolReleased; ///< Signalled whenever a task releases its resources.
+    std::size_t runningTasks = 0; ///< Tasks holding resources; guarded by poolMutex.
+    std::mutex outputMutex; ///< Keeps the output lines of concurrent tasks apart.
+
+    /**
+     * @brief Runs the items of one stage until its input channel is drained.
+     * @param stage Position of the stage.
+     * @param items The input items.
+     * @param input Channel the stage reads from.
+     * @param output Channel of the next stage, or nullptr for the last stage.
+     * @param loans The resources lent to every task.
+     * @param report Report receiving the completed and failed items; guarded by outputMutex.
+     */
+    void runStage(std::size_t stage, const std::vector<std::string> &items, Channel &input, Channel *output,
+                  const std::vector<std::pair<std::string, Resource *> > &loans, Report &report);
+
+public:
+    /**
+     * @brief Constructs a pipeline over a resource pool.
+     * @param resourcePool Resources the stages share; nothing else may use them while the pipeline runs.
+     * @param stages Stages, in pipeline order.
+     * @param options Settings of the runs.
+     * @throw std::invalid_argument If there is no stage, a stage has no name, a non-positive duration or no
+     * worker, or the queue capacity is zero.
+     */
+    Pipeline(const std::vector<std::unique_ptr<Resource> > &resourcePool, std::vector<Stage> stages,
+             Options options);
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    /**
+     * @brief Pushes every item through the stages and waits until all of them left the pipeline.
+     * @param items The input items, such as source file names.
+     * @param loans The resources the enclosing process lends to every task.
+     * @return The outcome of the run.
+     */
+    Report run(const std::vector<std::string> &items,
+               const std::vector<std::pair<std::string, Resource *> > &loans = {});
+};
+
+#endif //PIPELINE_H
@@ -2,18 +2,200 @@
 #define PROCESS_H
 
 #include "Executable.h"
+#include "EligibilityKernel.h"
+#include "EventDrivenScheduler.h"
+#include "Pipeline.h"
+#include "ResourceIndex.h"
+#include <functional>
+#include <map>
+#include <optional>
+#include <ostream>
+
+class CapacityPlan;
+class ExecutionMetrics;
+class ExecutionPlan;
+class ResourceManager;
+class ResultCache;
+class TaskQueue;
 
 /**
  * @brief Concrete implementation of Executable for managing a sequence of tasks.
  *
- * This class represents a process that orchestrates a series of tasks, such as a compilation pipeline.
- * It maintains a resource pool and executes tasks sequentially, supporting hierarchical composition
- * where a Process can act as a Task within another Process.
+ * This class represents a process that orchestrates a series of tasks, such as a compilation pipeline. It
+ * maintains a resource pool and executes tasks sequentially, supporting hierarchical composition where a
+ * Process can act as a Task within another Process. With bitmask matching, execution evaluates the requirements
+ * of all pending tasks in one EligibilityKernel batch and only rechecks the ready ones. Tasks run in the order
+ * they were added, so a task's dependencies must be added before it; a task whose dependencies did not complete
+ * is skipped. Once compiled into an ExecutionPlan, execution uses resolved resource groups instead of name
+ * lookups and skips tasks the plan flags as never runnable. Execution then runs the tasks pulled one at a time
+ * from a TaskSource, if any, and the tasks other threads submit to an attached TaskQueue until the queue is
+ * closed. Finally, if the process has pipeline stages, its pipeline inputs flow through them on worker threads.
+ * With a ResultCache attached, sequential execution skips the tasks that already completed unchanged. Tasks can
+ * declare the artifacts they read and produce; rerunChanged() then runs again only the tasks a change to some
+ * inputs invalidates, like an incremental build.
  */
 class Process final : public Executable {
+public:
+    /**
+     * @brief Enumeration defining how tasks' required resources are matched against the pool.
+     *
+     * NameScan searches the pool for every required name. Bitmask keeps a ResourceIndex of the pool and
+     * checks a requirement mask precomputed for each task; it falls back to NameScan when the pool and the
+     * requirements use more than ResourceIndex::MaxGroups distinct names.
+     */
+    enum class RequirementMatching { NameScan, Bitmask };
+
+    /**
+     * @brief Enumeration defining how execute() schedules the tasks.
+     *
+     * Sequential runs tasks one after another in the order they were added, each releasing its resources
+     * before the next starts. EventDriven simulates time with an EventDrivenScheduler: tasks hold their
+     * resources for their duration and start as soon as their dependencies and resources allow.
+     */
+    enum class Scheduling { Sequential, EventDriven };
+
+    /**
+     * @brief Enumeration defining which of its own resources a process lends to its tasks while it executes.
+     *
+     * A lent resource stays allocated to the process; a task requiring its name borrows it instead of
+     * allocating one from the pool, and never releases it. None lends nothing, so tasks compete with the
+     * process for its resources. Usable lends exclusive resources such as a processor, which the process
+     * would otherwise hold away from its own tasks. All also lends consumable units, so tasks share the
+     * process's allocation instead of consuming their own. Nested processes pass borrowed resources on.
+     * Event-driven runs share a lent resource between all tasks running at the same time.
+     */
+    enum class ResourceDelegation { None, Usable, All };
+
+    /**
+     * @brief Resource and task state of a process, captured by snapshot() and put back by restore().
+     */
+    struct Snapshot {
+        std::vector<Resource::State> resources; ///< State of each pool resource, by position.
+        std::vector<char> completedTasks; ///< Tasks completed in the last sequential execution, by position.
+    };
+
+    /**
+     * @brief Generator the process pulls tasks from lazily; it returns nullptr once exhausted.
+     */
+    using TaskSource = std::function<std::unique_ptr<Executable>()>;
+
+    /**
+     * @brief Builds a task source creating one task per element of a range, as the process pulls them.
+     * @param first Iterator to the first element; the elements must outlive the source.
+     * @param last Iterator past the last element.
+     * @param makeTask Callable building the task of an element.
+     * @return The task source.
+     */
+    template<typename Iterator, typename Factory>
+    static TaskSource taskRange(Iterator first, Iterator last, Factory makeTask) {
+        return [first, last, makeTask]() mutable -> std::unique_ptr<Executable> {
+            if (first == last) return nullptr;
+            return makeTask(*first++);
+        };
+    }
+
 private:
+    /**
+     * @brief Run configuration of a process, which cloneProcess() copies as a whole.
+     */
+    struct RunOptions {
+        Scheduling scheduling = Scheduling::Sequential; ///< How execute() schedules the tasks.
+        /// Which ready tasks event-driven runs start when they compete for resources.
+        EventDrivenScheduler::Admission admission = EventDrivenScheduler::Admission::FirstCome;
+        int referenceCapacity = 0; ///< Usable capacity event-driven durations are measured on; zero to not scale.
+        std::vector<EventDrivenScheduler::Replenishment> replenishments; ///< Refills applied by event-driven runs.
+        ResourceDelegation delegation = ResourceDelegation::Usable; ///< Which own resources tasks borrow.
+        std::vector<Pipeline::Stage> pipelineStages; ///< Stages the pipeline inputs flow through, in order.
+        std::vector<std::string> pipelineInputs; ///< Items pushed through the pipeline stages.
+        Pipeline::Options pipelineOptions; ///< Queue capacity and unit time of pipeline runs.
+        double shareWeight = 1; ///< Weight of the process when it shares a machine with other processes.
+    };
+
     std::vector<std::unique_ptr<Resource> > resourcePool; ///< Pool of resources available to tasks.
     std::vector<std::unique_ptr<Executable> > tasks; ///< Sequence of tasks to execute.
+    std::shared_ptr<ExecutionMetrics> metrics; ///< Optional metrics recording task and resource activity.
+    std::unique_ptr<ResourceIndex> resourceIndex; ///< Free mask of the pool; null while matching by name.
+    EligibilityKernel::MaskTable requirementMasks; ///< Requirement mask of each task, by position.
+    ResourceIndex::Mask ownRequirementMask; ///< Requirement mask of the process itself.
+    RunOptions runOptions; ///< Scheduling, admission, delegation, pipeline and sharing settings.
+    std::unique_ptr<ExecutionPlan> executionPlan; ///< Resolved requirements; null until compiled or after changes.
+    std::shared_ptr<ResourceManager> resourceManager; ///< Shared pool run() acquires the process's own resources from.
+    std::shared_ptr<TaskQueue> submissionQueue; ///< Queue execute() drains after its own tasks; null if none.
+    TaskSource taskSource; ///< Generator execute() pulls tasks from after its own tasks; empty if none.
+    std::shared_ptr<ResultCache> resultCache; ///< Completed tasks execute() skips; null if none.
+    mutable std::vector<char> lastRunCompleted; ///< Tasks that completed in the last sequential execution, by position.
+    std::vector<char> rerunSelection; ///< Tasks rerunChanged() runs again, by position; empty to run all of them.
+    mutable std::optional<EventDrivenScheduler::Report> lastSimulation; ///< Outcome of the last event-driven execution.
+
+    /**
+     * @brief Builds the resource index and requirement masks, or drops them if the index overflows.
+     */
+    void buildResourceIndex();
+
+    /**
+     * @brief Detaches the pool from the resource index and discards the index and masks.
+     */
+    void dropResourceIndex();
+
+    /**
+     * @brief Retrieves the number of mask words that can hold registered resource names.
+     * @return The number of leading words of a mask worth checking.
+     */
+    [[nodiscard]] std::size_t maskWordCount() const;
+
+    /**
+     * @brief Checks whether the pool currently satisfies a task's requirements.
+     * @param index Position of the task, with its loans already borrowed.
+     * @param lentMask Groups the process lends, counted as free in bitmask matching.
+     * @return True if every resource the task requires and does not borrow has an available unit in the pool.
+     */
+    [[nodiscard]] bool canRunTask(std::size_t index, const ResourceIndex::Mask &lentMask) const;
+
+    /**
+     * @brief Checks whether the delegation mode lends resources of a type.
+     * @param type The resource type.
+     * @return True if resources of that type are lent to tasks.
+     */
+    [[nodiscard]] bool lends(Resource::Type type) const;
+
+    /**
+     * @brief Lists the names of the process's own requirements that it lends to its tasks.
+     * @return One name per loan, in requirement order; names the process cannot allocate are left out.
+     */
+    [[nodiscard]] std::vector<std::string> collectLentNames() const;
+
+    /**
+     * @brief Lists the resources the process holds and lends to its tasks.
+     * @return The required name and resource of each loan, in requirement order.
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, Resource *> > collectLoans() const;
+
+    /**
+     * @brief Records contention for every pool resource that kept an executable from running.
+     * @param executable The executable that could not acquire its resources.
+     */
+    void recordContention(const Executable &executable) const;
+
+    /**
+     * @brief Runs a task that is not part of the plan, such as a pulled or submitted one, against the pool.
+     * @param task The task to run.
+     * @param loans The resources the process lends, borrowed by the task.
+     * @param origin How the task reached the process, used in messages.
+     */
+    void runDetachedTask(Executable &task, const std::vector<std::pair<std::string, Resource *> > &loans,
+                         const char *origin) const;
+
+    /**
+     * @brief Runs the tasks pulled from the task source, then those submitted to the queue until it is closed.
+     * @param loans The resources the process lends, borrowed by each task.
+     */
+    void runDetachedTasks(const std::vector<std::pair<std::string, Resource *> > &loans) const;
+
+    /**
+     * @brief Pushes the pipeline inputs through the pipeline stages and reports the outcome.
+     * @param loans The resources the process lends, borrowed by every stage task.
+     */
+    void runPipeline(const std::vector<std::pair<std::string, Resource *> > &loans) const;
 public:
     /**
      * @brief Constructs a Process to manage a sequence of tasks.
@@ -26,6 +208,11 @@ public:
     Process(const std::string &name, const std::string &description,
             const std::vector<std::string> &requiredResourcesNames, int durationInUnits);
 
+    /**
+     * @brief Destroys the process, its resources and tasks.
+     */
+    ~Process() override;
+
     /**
      * @brief Adds a resource to the process's resource pool.
      * @param resource A unique pointer to the resource to add.
@@ -38,6 +225,277 @@ public:
      */
     void addTask(std::unique_ptr<Executable> task);
 
+    /**
+     * @brief Retrieves the number of tasks in the process's sequence.
+     * @return The number of tasks added to the process.
+     */
+    [[nodiscard]] std::size_t getTaskCount() const;
+
+    /**
+     * @brief Retrieves the process's sequence of tasks.
+     * @return The tasks, in the order they were added.
+     */
+    [[nodiscard]] const std::vector<std::unique_ptr<Executable> > &getTasks() const;
+
+    /**
+     * @brief Retrieves the process's resource pool.
+     * @return The resources, in the order they were added.
+     */
+    [[nodiscard]] const std::vector<std::unique_ptr<Resource> > &getResourcePool() const;
+
+    /**
+     * @brief Selects how tasks' required resources are matched against the pool.
+     * @param matching The matching mode; Bitmask falls back to NameScan if the pool has too many names.
+     */
+    void setRequirementMatching(RequirementMatching matching);
+
+    /**
+     * @brief Retrieves the matching mode in effect.
+     * @return Bitmask if a resource index is maintained, NameScan otherwise.
+     */
+    [[nodiscard]] RequirementMatching getRequirementMatching() const;
+
+    /**
+     * @brief Resolves the requirements and dependencies of the process and its tasks into an ExecutionPlan.
+     *
+     * run() compiles automatically when no plan exists; adding resources or tasks discards the plan.
+     * Dependencies added to tasks afterwards are only taken into account after compiling again.
+     *
+     * @return The plan execute() follows, listing the tasks that can never run.
+     */
+    const ExecutionPlan &compile();
+
+    /**
+     * @brief Retrieves the plan execute() follows.
+     * @return The current plan, or nullptr if the process is not compiled.
+     */
+    [[nodiscard]] const ExecutionPlan *getExecutionPlan() const;
+
+    /**
+     * @brief Computes the smallest capacities with which the process and all its tasks can run without skips.
+     *
+     * The result comes from the requirements, loans and dependencies alone, without running anything (see
+     * CapacityPlan), and its capacities can be passed to cloneProcess() to build a process sized to them.
+     * Requirements a shared ResourceManager serves are not drawn from the pool and not counted.
+     *
+     * @return The demand and minimum of every resource name of the pool, and the tasks no capacity lets run.
+     */
+    [[nodiscard]] CapacityPlan planCapacities() const;
+
+    /**
+     * @brief Selects which of its own resources the process lends to its tasks.
+     * @param mode The delegation mode; the plan is discarded as the loans change what tasks can run.
+     */
+    void setResourceDelegation(ResourceDelegation mode);
+
+    /**
+     * @brief Retrieves which of its own resources the process lends to its tasks.
+     * @return The delegation mode.
+     */
+    [[nodiscard]] ResourceDelegation getResourceDelegation() const;
+
+    /**
+     * @brief Makes run() acquire the process's own requirements from a pool shared with other processes.
+     *
+     * run() then waits until the manager can serve every own requirement instead of allocating from the
+     * process's pool, so processes running on different threads contend for the same resources. Tasks still
+     * allocate from the process's pool, apart from the shared resources the process lends them.
+     *
+     * @param manager The shared pool, or nullptr to allocate from the process's pool again.
+     */
+    void setResourceManager(std::shared_ptr<ResourceManager> manager);
+
+    /**
+     * @brief Retrieves the shared pool run() acquires the process's own resources from.
+     * @return The attached manager, or nullptr if none is attached.
+     */
+    [[nodiscard]] const std::shared_ptr<ResourceManager>& getResourceManager() const;
+
+    /**
+     * @brief Makes execute() run the tasks other threads submit to a queue after the process's own tasks.
+     *
+     * Submitted tasks run in arrival order, matched against the pool by name and borrowing the process's
+     * loans like its own tasks; each is destroyed once it ran. execute() returns when the queue is closed and
+     * empty. Submitted tasks are not part of the plan or the metrics, and must not declare dependencies, since
+     * their arrival order across producers is not defined.
+     *
+     * @param queue The queue to drain, or nullptr to run the process's own tasks only.
+     */
+    void setSubmissionQueue(std::shared_ptr<TaskQueue> queue);
+
+    /**
+     * @brief Retrieves the queue execute() drains after the process's own tasks.
+     * @return The attached queue, or nullptr if none is attached.
+     */
+    [[nodiscard]] const std::shared_ptr<TaskQueue> &getSubmissionQueue() const;
+
+    /**
+     * @brief Makes sequential execution skip the tasks that already completed with the same declaration.
+     *
+     * Before acquiring a task's resources, execute() looks up its ResultCache key, which folds in the keys of
+     * the tasks it depends on: a hit reports the task as up to date and counts it as completed without
+     * acquiring resources or executing it, and a task that executes is stored once it completed. Pulled and
+     * submitted tasks are cached the same way; event-driven simulations and pipelines always run every task.
+     *
+     * @param cache The cache to consult, or nullptr to run every task.
+     */
+    void setResultCache(std::shared_ptr<ResultCache> cache);
+
+    /**
+     * @brief Retrieves the cache execute() consults.
+     * @return The attached cache, or nullptr if none is attached.
+     */
+    [[nodiscard]] const std::shared_ptr<ResultCache> &getResultCache() const;
+
+    /**
+     * @brief Makes execute() pull tasks from a generator after the process's own tasks, one at a time.
+     *
+     * Each pulled task is built only when the previous one has run and is destroyed right after it ran, so a
+     * process can run millions of tasks while holding one. Like submitted tasks, pulled tasks are matched by
+     * name, borrow the process's loans, stay out of the plan and the metrics, and must not declare dependencies.
+     * The source is consumed by the first execution. taskRange() adapts an iterator range.
+     *
+     * @param source Generator returning the next task, or nullptr once exhausted; an empty function detaches it.
+     */
+    void setTaskSource(TaskSource source);
+
+    /**
+     * @brief Appends a stage to the pipeline that execute() runs the pipeline inputs through.
+     *
+     * Every stage is a task template instantiated once per input; stages run concurrently on their own worker
+     * threads, connected by bounded queues (see Pipeline). The pipeline runs after all other tasks; its tasks
+     * share the process's pool and loans, and stay out of its metrics and plan.
+     *
+     * @param stage The stage.
+     * @throw std::invalid_argument If the stage has no name, a non-positive duration or no worker.
+     */
+    void addPipelineStage(Pipeline::Stage stage);
+
+    /**
+     * @brief Adds an item, such as a source file, to push through the pipeline stages.
+     * @param item The item.
+     */
+    void addPipelineInput(const std::string &item);
+
+    /**
+     * @brief Sets the queue capacity and unit time of pipeline runs.
+     * @param options The pipeline settings.
+     * @throw std::invalid_argument If the queue capacity is zero.
+     */
+    void setPipelineOptions(const Pipeline::Options &options);
+
+    /**
+     * @brief Retrieves the number of stage tasks the pipeline instantiates per execution.
+     * @return The number of pipeline stages times the number of pipeline inputs.
+     */
+    [[nodiscard]] std::size_t getPipelineTaskCount() const;
+
+    /**
+     * @brief Selects how execute() schedules the tasks.
+     * @param mode The scheduling mode.
+     */
+    void setScheduling(Scheduling mode);
+
+    /**
+     * @brief Retrieves how execute() schedules the tasks.
+     * @return The scheduling mode.
+     */
+    [[nodiscard]] Scheduling getScheduling() const;
+
+    /**
+     * @brief Selects which ready tasks event-driven runs start when they compete for resources.
+     *
+     * The packing admissions choose the tasks that run together to fill the free units of every resource name,
+     * instead of starting them in the order they became ready; backfilling keeps that order but lets later
+     * tasks start early when they cannot delay the first waiting one. Sequential runs start one task at a time
+     * and are not affected.
+     *
+     * @param mode The admission policy.
+     */
+    void setAdmission(EventDrivenScheduler::Admission mode);
+
+    /**
+     * @brief Retrieves which ready tasks event-driven runs start when they compete for resources.
+     * @return The admission policy.
+     */
+    [[nodiscard]] EventDrivenScheduler::Admission getAdmission() const;
+
+    /**
+     * @brief Sets the usable resource capacity, such as 3 GHz, that task durations are measured on.
+     *
+     * Event-driven runs then scale each task's duration by this capacity over the capacity of the slowest
+     * usable resource it is assigned, so tasks run faster on faster processors. Sequential runs and pipelines
+     * are not affected.
+     *
+     * @param capacity The reference capacity, or zero to leave durations unscaled.
+     * @throw std::invalid_argument If capacity is negative.
+     */
+    void setReferenceCapacity(int capacity);
+
+    /**
+     * @brief Retrieves the usable resource capacity that task durations are measured on.
+     * @return The reference capacity, or zero if durations are not scaled.
+     */
+    [[nodiscard]] int getReferenceCapacity() const;
+
+    /**
+     * @brief Sets the weight of the process when it shares a machine with other processes.
+     *
+     * A FairShareScheduler divides each process's dominant share of the machine by its weight, so a process
+     * of weight 2 may hold twice the share of a process of weight 1 before it yields to it.
+     *
+     * @param weight The weight.
+     * @throw std::invalid_argument If weight is not a positive finite number.
+     */
+    void setShareWeight(double weight);
+
+    /**
+     * @brief Retrieves the weight of the process when it shares a machine with other processes.
+     * @return The weight, 1 unless set.
+     */
+    [[nodiscard]] double getShareWeight() const;
+
+    /**
+     * @brief Schedules a refill of a consumable resource for event-driven runs.
+     * @param resourceName Name of the consumable resource in the pool.
+     * @param units Units restored, up to the resource's total capacity.
+     * @param time Simulated time of the refill.
+     * @throw std::invalid_argument If units is not positive or time is negative.
+     */
+    void addReplenishment(const std::string &resourceName, int units, int time);
+
+    /**
+     * @brief Simulates the tasks over time with an EventDrivenScheduler, whatever the scheduling mode.
+     *
+     * Resources the process holds itself stay unavailable to its tasks. Metrics and traces are not recorded.
+     *
+     * @return The outcome of the simulation.
+     */
+    EventDrivenScheduler::Report simulate() const;
+
+    /**
+     * @brief Attaches metrics that record the executions of this process.
+     *
+     * Tasks and resources are recorded by position, so one ExecutionMetrics may be shared by processes
+     * with the same tasks and resource pool to aggregate their runs.
+     *
+     * @param executionMetrics The metrics to record into, or nullptr to stop recording.
+     */
+    void setMetrics(std::shared_ptr<ExecutionMetrics> executionMetrics);
+
+    /**
+     * @brief Retrieves the metrics attached to this process.
+     * @return The attached metrics, or nullptr if none are attached.
+     */
+    [[nodiscard]] const std::shared_ptr<ExecutionMetrics> &getMetrics() const;
+
+    /**
+     * @brief Writes the attached metrics as JSON, labelled with this process's task and resource names.
+     * @param output The stream to write to.
+     * @throw std::logic_error If no metrics are attached.
+     */
+    void writeMetricsJson(std::ostream &output) const;
+
     /**
      * @brief Executes the process by running its sequence of tasks.
      * @throw std::runtime_error If resources are not properly assigned or tasks fail.
@@ -45,7 +503,81 @@ public:
     void execute() const override;
 
     /**
-     * @brief Runs the process standalone, managing its own resource pool.
+     * @brief Creates an independent copy of the process's definition, as cloneProcess() does.
+     * @return The copy.
+     */
+    [[nodiscard]] std::unique_ptr<Executable> clone() const override;
+
+    /**
+     * @brief Creates an independent copy of the process's definition, optionally with other capacities.
+     *
+     * The copy has clones of the resources and tasks, the same dependencies, artifacts, replenishments,
+     * pipeline and scheduling, matching and delegation settings. Attachments (resource manager, submission
+     * queue, task source, metrics and result cache) are not copied, and the copy is compiled on its first run.
+     * For each entry of capacities, a consumable of that name is replaced by one of the given capacity, and
+     * the usable resources of that name by as many clones of the first of them as the given count.
+     *
+     * @param capacities Capacity of consumables and unit count of usable resources, by resource name.
+     * @return The copy.
+     * @throw std::invalid_argument If a name is not in the pool or a capacity is not positive.
+     */
+    [[nodiscard]] std::unique_ptr<Process> cloneProcess(const std::map<std::string, int> &capacities = {}) const;
+
+    /**
+     * @brief Retrieves the outcome of the last event-driven execution.
+     * @return The report of the simulation, or nothing if the last run did not simulate.
+     */
+    [[nodiscard]] const std::optional<EventDrivenScheduler::Report> &getLastSimulation() const;
+
+    /**
+     * @brief Captures the state of the pool resources and of the tasks.
+     *
+     * Together with restore(), this lets the same process run many times, for benchmarks or Monte Carlo
+     * sweeps, without rebuilding its resources and tasks or recompiling its plan: only the few fields a run
+     * changes, such as availability flags and remaining consumable units, are saved and put back. Resources
+     * of a shared ResourceManager and of nested processes are not included, and neither are task sources or
+     * submission queues, which a run consumes.
+     *
+     * @return The snapshot.
+     */
+    [[nodiscard]] Snapshot snapshot() const;
+
+    /**
+     * @brief Puts back a state captured by snapshot(), so the next run starts from it.
+     *
+     * The process and its tasks forget any resource still assigned, as after a failed task, and resource
+     * listeners such as the bitmask index are notified of every availability change.
+     *
+     * @param snapshot A snapshot of this process.
+     * @throw std::invalid_argument If the snapshot does not match the pool or the tasks of the process.
+     */
+    void restore(const Snapshot &snapshot);
+
+    /**
+     * @brief Runs again only the tasks affected by changed inputs, reusing the previous run for the others.
+     *
+     * A task is dirty if it did not complete in the last sequential execution, reads a changed input, reads an
+     * output of a dirty task, or depends on a dirty task. run() then executes the dirty tasks in order and
+     * reports the others as reused, counting them as completed for their dependents. Before any sequential
+     * execution, or after an event-driven one, every task is dirty; without any dirty task nothing runs.
+     *
+     * @param changedInputs Names of the artifacts that changed since the previous run.
+     * @return The number of tasks selected to run again.
+     */
+    std::size_t rerunChanged(const std::vector<std::string> &changedInputs);
+
+    /**
+     * @brief Lists the artifacts produced by the tasks that completed in the last sequential execution.
+     * @return The output names of the completed tasks, in task order.
+     */
+    [[nodiscard]] std::vector<std::string> getProducedOutputs() const;
+
+    /**
+     * @brief Runs the process standalone, managing its own resource pool; compiles it first if needed.
+     *
+     * With a ResourceManager attached, the process's own requirements are acquired from it, waiting as long
+     * as other processes hold them, and returned once the tasks are done. Errors are reported, not thrown.
+     *
      * @throw std::runtime_error If insufficient resources are available to start.
      */
     void run();
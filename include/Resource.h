@@ -1,7 +1,11 @@
 #ifndef RESOURCE_H
 #define RESOURCE_H
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Abstract base class for resources used in executable tasks or processes.
@@ -15,10 +19,40 @@ public:
     /// @brief Enumeration defining the type of resource.
     enum class Type { Consumable, Usable };
 
+    /**
+     * @brief Observer notified whenever a resource becomes available or unavailable.
+     */
+    class AvailabilityListener {
+    public:
+        virtual ~AvailabilityListener() = default;
+
+        /**
+         * @brief Called after the availability of an observed resource changed.
+         * @param tag The tag the listener was attached with.
+         * @param available True if the resource became available, false if it became unavailable.
+         */
+        virtual void availabilityChanged(std::size_t tag, bool available) = 0;
+    };
+
+    /**
+     * @brief Mutable state of a resource, captured by saveState() and put back by restoreState().
+     */
+    struct State {
+        bool available = true; ///< Availability flag.
+        int units = 0; ///< Remaining units of a consumable; unused by other resources.
+    };
+
 protected:
     std::string name; ///< Unique name of the resource.
     bool isAvailable; ///< Indicates whether the resource is available for use.
     Type resourceType; ///< Specifies the type of resource (Consumable or Usable).
+    std::vector<std::pair<AvailabilityListener *, std::size_t> > availabilityListeners; ///< Observers and their tags.
+
+    /**
+     * @brief Updates the availability flag, notifying the listeners if it changed.
+     * @param available The new availability of the resource.
+     */
+    void setAvailability(bool available);
 public:
     /**
      * @brief Constructor for the Resource class.
@@ -68,5 +102,37 @@ public:
      * @return The type of the resource (Consumable or Usable).
      */
     [[nodiscard]] Type getResourceType() const;
+
+    /**
+     * @brief Attaches an observer notified of availability changes.
+     * @param listener The observer; it must be detached before it is destroyed.
+     * @param tag Value passed back to the observer to identify this resource.
+     */
+    void addAvailabilityListener(AvailabilityListener *listener, std::size_t tag = 0);
+
+    /**
+     * @brief Detaches an observer; detaching one that is not attached has no effect.
+     * @param listener The observer to detach.
+     */
+    void removeAvailabilityListener(const AvailabilityListener *listener);
+
+    /**
+     * @brief Captures the mutable state of the resource.
+     * @return The state, to be passed back to restoreState().
+     */
+    [[nodiscard]] virtual State saveState() const;
+
+    /**
+     * @brief Puts back a state captured by saveState(), notifying the listeners if availability changes.
+     * @param state The state to restore.
+     * @throw std::invalid_argument If the state does not fit the resource.
+     */
+    virtual void restoreState(const State &state);
+
+    /**
+     * @brief Creates an independent copy of the resource in its current state, without its listeners.
+     * @return The copy.
+     */
+    [[nodiscard]] virtual std::unique_ptr<Resource> clone() const = 0;
 };
 #endif //RESOURCE_H
@@ -0,0 +1,129 @@
+#ifndef RESOURCE_INDEX_H
+#define RESOURCE_INDEX_H
+
+#include "Resource.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Bitmask view of which resource names of a pool currently have an available resource.
+ *
+ * Every distinct resource name (a group) gets one bit. The index observes the resources added to it and
+ * keeps a live free mask in which a group's bit is set while at least one of its resources is available.
+ * A requirement list then becomes a mask, and checking it is `(required & free) == required`, which gives
+ * the same answer as scanning the pool for each required name. Names that no resource carries get a bit
+ * that is never set, so requirements on them are never satisfied, as with a scan.
+ *
+ * Up to MaxGroups distinct names are supported; registering more marks the index as overflowed and its
+ * owner must fall back to name scans.
+ */
+class ResourceIndex final : public Resource::AvailabilityListener {
+public:
+    static constexpr std::size_t MaxGroups = 256; ///< Number of distinct resource names a mask can hold.
+    static constexpr std::size_t WordCount = MaxGroups / 64; ///< Number of 64-bit words in a mask.
+
+    /**
+     * @brief Set of resource groups, one bit per group.
+     */
+    struct Mask {
+        std::array<std::uint64_t, WordCount> words{}; ///< Bits of the groups, 64 per word.
+
+        /**
+         * @brief Adds a group to the set.
+         * @param group The group to add.
+         */
+        void set(const std::size_t group) { words[group / 64] |= std::uint64_t{1} << (group % 64); }
+
+        /**
+         * @brief Removes a group from the set.
+         * @param group The group to remove.
+         */
+        void reset(const std::size_t group) { words[group / 64] &= ~(std::uint64_t{1} << (group % 64)); }
+
+        /**
+         * @brief Adds every group of another set to this one.
+         * @param other The groups to add.
+         */
+        void setAll(const Mask &other) {
+            for (std::size_t word = 0; word < words.size(); ++word) words[word] |= other.words[word];
+        }
+
+        /**
+         * @brief Checks whether every group of another set is also in this one.
+         * @param required The groups to look for.
+         * @return True if all groups of required are in this set.
+         */
+        [[nodiscard]] bool containsAll(const Mask &required) const {
+            std::uint64_t missing = 0;
+            for (std::size_t word = 0; word < words.size(); ++word) missing |= required.words[word] & ~words[word];
+            return missing == 0;
+        }
+    };
+
+private:
+    std::unordered_map<std::string, std::size_t> groupsByName; ///< Group of every registered name.
+    std::vector<int> availableCounts; ///< Number of available resources in each group.
+    Mask freeMask; ///< Groups with at least one available resource.
+    bool overflowed = false; ///< Whether more than MaxGroups names were registered.
+
+    /**
+     * @brief Retrieves the group of a name, registering it if it is new.
+     * @param name The resource name.
+     * @param group Receives the group of the name.
+     * @return False if the name is new and no group is left.
+     */
+    bool registerName(const std::string &name, std::size_t &group);
+
+public:
+    /**
+     * @brief Adds a resource to its name's group and starts observing its availability.
+     * @param resource The resource to observe; it must outlive the index or be detached first.
+     * @return False if the index overflowed; the resource is then not observed.
+     */
+    bool addResource(Resource &resource);
+
+    /**
+     * @brief Builds the mask of a list of required resource names.
+     * @param names The required resource names.
+     * @param mask Receives the groups of the names.
+     * @return False if the index overflowed.
+     */
+    bool requirementMask(const std::vector<std::string> &names, Mask &mask);
+
+    /**
+     * @brief Checks whether every required group currently has an available resource.
+     * @param required The mask of the required groups.
+     * @return True if all required groups are free.
+     */
+    [[nodiscard]] bool isSatisfied(const Mask &required) const { return freeMask.containsAll(required); }
+
+    /**
+     * @brief Retrieves the groups that currently have an available resource.
+     * @return The live free mask.
+     */
+    [[nodiscard]] const Mask &getFreeMask() const;
+
+    /**
+     * @brief Retrieves the number of distinct names registered so far.
+     * @return The number of groups in use; only bits below it can be set.
+     */
+    [[nodiscard]] std::size_t getGroupCount() const;
+
+    /**
+     * @brief Checks whether more distinct names were registered than a mask can hold.
+     * @return True if the index can no longer answer requirement checks.
+     */
+    [[nodiscard]] bool isOverflowed() const;
+
+    /**
+     * @brief Updates the available count and free bit of a resource's group.
+     * @param tag The group of the resource.
+     * @param available True if the resource became available, false if it became unavailable.
+     */
+    void availabilityChanged(std::size_t tag, bool available) override;
+};
+
+#endif //RESOURCE_INDEX_H
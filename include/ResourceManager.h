@@ -0,0 +1,179 @@
+#ifndef RESOURCE_MANAGER_H
+#define RESOURCE_MANAGER_H
+
+#include "Resource.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Thread-safe pool of resources shared by many processes, such as one machine's processors and memory.
+ *
+ * Resources are grouped by name, and every name belongs to one of a fixed number of shards chosen by hashing
+ * the name. Each shard has its own mutex and condition variable, so processes acquiring different names do
+ * not serialize on a global lock. An acquisition is all or nothing: the shards of the requested names are
+ * locked in increasing order, which rules out deadlocks between acquisitions, and resources are only
+ * allocated once every requested name can be served. A blocked acquisition waits on the shard of the first
+ * name it could not serve and retries after a resource of that shard is released.
+ *
+ * Resources added to the manager belong to it; processes only see them through a Lease, which releases
+ * them when it is destroyed.
+ */
+class ResourceManager {
+public:
+    /**
+     * @brief Resources held by one acquisition, released when the lease is destroyed.
+     */
+    class Lease {
+    private:
+        ResourceManager *manager; ///< Manager the resources return to; null once released or moved from.
+        std::vector<Resource *> resources; ///< Resources held, in requirement order.
+
+    public:
+        /**
+         * @brief Constructs a lease over resources the manager already allocated.
+         * @param manager The manager the resources return to, or nullptr for an empty lease.
+         * @param resources The resources, in requirement order.
+         */
+        explicit Lease(ResourceManager *manager = nullptr, std::vector<Resource *> resources = {});
+
+        /**
+         * @brief Releases the resources still held.
+         */
+        ~Lease();
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        /**
+         * @brief Takes over the resources of another lease.
+         * @param other The lease to move from; it no longer holds anything.
+         */
+        Lease(Lease &&other) noexcept;
+
+        /**
+         * @brief Releases the resources held, then takes over those of another lease.
+         * @param other The lease to move from; it no longer holds anything.
+         * @return This lease.
+         */
+        Lease &operator=(Lease &&other) noexcept;
+
+        /**
+         * @brief Retrieves the resources held.
+         * @return The resources, in requirement order; empty once released.
+         */
+        [[nodiscard]] const std::vector<Resource *> &getResources() const;
+
+        /**
+         * @brief Returns the resources to the manager before the lease is destroyed.
+         */
+        void release();
+    };
+
+    /**
+     * @brief Units the resources of one name can serve.
+     */
+    struct UnitCount {
+        std::string resourceName; ///< Name shared by the resources.
+        Resource::Type type = Resource::Type::Usable; ///< Type of the first resource of that name.
+        long long available = 0; ///< Remaining consumable units, or number of available usable resources.
+    };
+
+private:
+    /**
+     * @brief Resources of the names hashed to one shard, with the lock guarding them.
+     */
+    struct Shard {
+        std::mutex mutex; ///< Guards the groups and every allocation or release of their resources.
+        std::condition_variable released; ///< Signalled whenever a resource of the shard is released.
+        std::uint64_t releaseCount = 0; ///< Number of releases, so waiters detect releases they did not see.
+        std::unordered_map<std::string, std::vector<std::unique_ptr<Resource> > > groups; ///< Resources by name.
+    };
+
+    std::vector<Shard> shards; ///< Shards, indexed by the hash of a name.
+
+    /**
+     * @brief Retrieves the shard of a name.
+     * @param name The resource name.
+     * @return Position of the shard holding the resources of that name.
+     */
+    [[nodiscard]] std::size_t shardOf(const std::string &name) const;
+
+    /**
+     * @brief Allocates a resource for every name if all of them can be served right now.
+     * @param names The required resource names.
+     * @param resources Receives the allocated resources, in requirement order, on success.
+     * @param blockedShard Receives the shard of the first name that could not be served.
+     * @param seenReleases Receives the release count of that shard when it was checked.
+     * @return True if the resources were allocated.
+     * @throw std::invalid_argument If a name is unknown or required more often than its group can ever supply.
+     */
+    bool tryAllocate(const std::vector<std::string> &names, std::vector<Resource *> &resources,
+                     std::size_t &blockedShard, std::uint64_t &seenReleases);
+
+    /**
+     * @brief Releases resources and wakes the acquisitions waiting on their shards.
+     * @param resources The resources to release.
+     */
+    void release(const std::vector<Resource *> &resources);
+
+public:
+    /**
+     * @brief Constructs an empty manager.
+     * @param shardCount Number of shards the names are spread over.
+     * @throw std::invalid_argument If shardCount is zero.
+     */
+    explicit ResourceManager(std::size_t shardCount = 16);
+
+    ResourceManager(const ResourceManager &) = delete;
+    ResourceManager &operator=(const ResourceManager &) = delete;
+
+    /**
+     * @brief Adds a resource to the group of its name.
+     * @param resource The resource; the manager takes ownership.
+     */
+    void addResource(std::unique_ptr<Resource> resource);
+
+    /**
+     * @brief Waits until every required name can be served, then allocates one resource per name.
+     * @param names The required resource names; a name required twice takes two units.
+     * @return A lease holding the resources.
+     * @throw std::invalid_argument If a name is unknown or required more often than its group can ever supply.
+     */
+    Lease acquire(const std::vector<std::string> &names);
+
+    /**
+     * @brief Allocates one resource per name only if all of them can be served right now.
+     * @param names The required resource names; a name required twice takes two units.
+     * @param lease Receives the lease on success.
+     * @return True if the resources were allocated.
+     * @throw std::invalid_argument If a name is unknown or required more often than its group can ever supply.
+     */
+    bool tryAcquire(const std::vector<std::string> &names, Lease &lease);
+
+    /**
+     * @brief Looks up the type of the resources carrying a name.
+     * @param name The resource name.
+     * @param type Receives the type of the first resource with that name.
+     * @return False if no resource carries the name.
+     */
+    bool findResourceType(const std::string &name, Resource::Type &type);
+
+    /**
+     * @brief Counts the units every name can serve right now, locking one shard at a time.
+     * @return The unit count of each name, sorted by name.
+     */
+    std::vector<UnitCount> countAvailableUnits();
+
+    /**
+     * @brief Retrieves the number of shards.
+     * @return The number of shards the names are spread over.
+     */
+    [[nodiscard]] std::size_t getShardCount() const;
+};
+
+#endif //RESOURCE_MANAGER_H
@@ -0,0 +1,98 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "Executable.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Remembers which tasks already completed, keyed by a content hash of what they do.
+ *
+ * A task's key is a 64-bit FNV-1a hash of its name, description, required resource names, declared input and
+ * output artifacts and duration, so any change to one of them yields a new key. Processes fold the keys of a
+ * task's dependencies into its own, so a change upstream also invalidates every task downstream of it. A
+ * process consults the cache before acquiring a task's resources: a task whose key is stored is reported as
+ * up to date and neither acquires resources nor executes.
+ *
+ * The cache is shared by every process of a run and is safe to use from several threads. It can be saved to
+ * and loaded from a text file, one "<key in hex> <task name>" line per entry, so unchanged tasks are also
+ * skipped across program runs.
+ */
+class ResultCache {
+public:
+    /// @brief Content hash identifying a task.
+    using Key = std::uint64_t;
+
+private:
+    mutable std::mutex entriesMutex; ///< Guards the entries.
+    std::unordered_map<Key, std::string> entries; ///< Names of the completed tasks, by key.
+    std::atomic<std::uint64_t> hits{0}; ///< Lookups that found their key.
+    std::atomic<std::uint64_t> misses{0}; ///< Lookups that did not find their key.
+
+public:
+    /**
+     * @brief Computes the key of an executable from its name, description, requirements, artifacts and duration.
+     * @param executable The executable to hash.
+     * @return The FNV-1a hash of the executable's declaration.
+     */
+    static Key key(const Executable &executable);
+
+    /**
+     * @brief Folds the key of a dependency into the key of the task depending on it.
+     * @param key The key of the dependent task.
+     * @param dependencyKey The key of the dependency.
+     * @return The combined key.
+     */
+    static Key combine(Key key, Key dependencyKey);
+
+    /**
+     * @brief Checks whether a task with the given key already completed, counting a hit or a miss.
+     * @param key The key of the task.
+     * @return True if the key is stored.
+     */
+    bool lookup(Key key);
+
+    /**
+     * @brief Records that a task completed.
+     * @param key The key of the task.
+     * @param taskName Name of the task, kept to make the stored file readable.
+     */
+    void store(Key key, const std::string &taskName);
+
+    /**
+     * @brief Retrieves the number of lookups that found their key.
+     * @return The number of hits.
+     */
+    [[nodiscard]] std::uint64_t getHits() const;
+
+    /**
+     * @brief Retrieves the number of lookups that did not find their key.
+     * @return The number of misses.
+     */
+    [[nodiscard]] std::uint64_t getMisses() const;
+
+    /**
+     * @brief Retrieves the number of stored entries.
+     * @return The number of completed tasks remembered.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Adds the entries of a cache file; a missing file leaves the cache unchanged.
+     * @param path The file to read.
+     * @throw std::runtime_error If the file exists but is not a cache file or has a malformed line.
+     */
+    void load(const std::string &path);
+
+    /**
+     * @brief Writes all entries to a cache file, replacing it.
+     * @param path The file to write.
+     * @throw std::runtime_error If the file cannot be written.
+     */
+    void save(const std::string &path) const;
+};
+
+#endif //RESULT_CACHE_H
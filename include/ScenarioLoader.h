@@ -0,0 +1,76 @@
+#ifndef SCENARIO_LOADER_H
+#define SCENARIO_LOADER_H
+
+#include "Process.h"
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Builds Process instances from line-oriented scenario descriptions.
+ *
+ * A scenario is a plain-text file where each non-empty line is a directive. Tokens are separated by
+ * whitespace, double quotes group tokens containing spaces, and '#' starts a comment:
+ *
+ * @code
+ * process CompileMain "Compile main.c to main.exe" 15 CentralProcessingUnit Memory
+ * usable CentralProcessingUnit 3
+ * consumable Memory 4096
+ * task ScanSourceCode "Tokenize main.c" 2 CentralProcessingUnit Memory
+ * @endcode
+ *
+ * A 'process' directive starts a new process; 'usable', 'consumable' and 'task' directives add to the
+ * most recently declared process. 'after <task>...' makes the preceding task depend on earlier tasks,
+ * 'reads <artifact>...' and 'writes <artifact>...' declare the artifacts it reads and produces (see
+ * Process::rerunChanged),
+ * 'replenish <consumable> <units> <time>' refills a consumable during event-driven runs,
+ * 'shared usable|consumable <name> <capacity>' adds a resource to a ResourceManager that every process of
+ * the file acquires its own requirements from,
+ * 'weight <weight>' sets the share of that machine the process is entitled to (see FairShareScheduler),
+ * 'stage <name> <description> <duration> <parallelism> <requirement>...' appends a pipeline stage that every
+ * 'input <item>...' of the process flows through (see Pipeline), and
+ * 'generate <name> key=value...' adds a synthetic process built by WorkloadGenerator (see WorkloadOptions::set):
+ *
+ * @code
+ * generate Synthetic tasks=1000000 shape=random fanout=2 usable=8 consumable=4 seed=7
+ * @endcode
+ */
+class ScenarioLoader {
+public:
+    /**
+     * @brief Loads all processes declared in a scenario file.
+     * @param path Path of the scenario file.
+     * @return The processes in declaration order.
+     * @throw std::runtime_error If the file cannot be opened or contains an invalid directive.
+     */
+    static std::vector<std::unique_ptr<Process> > loadFile(const std::string &path);
+
+    /**
+     * @brief Loads all processes declared in a scenario stream.
+     * @param input The stream to read directives from.
+     * @param sourceName Name used to identify the source in error messages.
+     * @return The processes in declaration order.
+     * @throw std::runtime_error If the stream contains an invalid directive.
+     */
+    static std::vector<std::unique_ptr<Process> > loadStream(std::istream &input, const std::string &sourceName);
+
+    /**
+     * @brief Splits a scenario line into tokens, honouring double quotes and '#' comments.
+     * @param line The line to split.
+     * @return The tokens of the line; empty for blank or comment-only lines.
+     * @throw std::runtime_error If a quoted token is not terminated.
+     */
+    static std::vector<std::string> tokenize(const std::string &line);
+
+    /**
+     * @brief Parses a positive integer token.
+     * @param token The token to parse.
+     * @param what Description of the value used in error messages.
+     * @return The parsed value.
+     * @throw std::runtime_error If the token is not a positive integer.
+     */
+    static int parsePositive(const std::string &token, const std::string &what);
+};
+
+#endif //SCENARIO_LOADER_H
@@ -0,0 +1,127 @@
+#ifndef SHARDED_CONSUMABLE_RESOURCE_H
+#define SHARDED_CONSUMABLE_RESOURCE_H
+
+#include "ConsumableResource.h"
+#include "ThreadShards.h"
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Consumable resource that many threads allocate from without contending on one counter.
+ *
+ * Every allocating thread keeps a local quota of units in a shard of its own and allocates from it with an
+ * uncontended atomic decrement. A thread whose quota is empty refills it with a batch of units taken from
+ * the global remaining capacity, and once that is exhausted steals half the quota of another shard, so
+ * every unit stays allocatable even when the thread holding it stopped allocating.
+ *
+ * The remaining capacity is the global capacity plus all quotas; getRemainingCapacity() and use() add them
+ * up under the shard registry lock. Availability only changes when the last unit is taken and when the
+ * resource is replenished; both happen under that lock, so listeners are never notified concurrently.
+ */
+class ShardedConsumableResource final : public ConsumableResource {
+private:
+    /**
+     * @brief Units reserved for one thread, on a cache line of their own.
+     */
+    struct alignas(64) Shard {
+        std::atomic<int> quota{0}; ///< Units the thread can allocate without taking from the global capacity.
+    };
+
+    int batchSize; ///< Units moved from the global capacity to a shard per refill.
+    ThreadShards<Shard> shards; ///< Shards by allocating thread; their lock also guards stealing and availability.
+
+    /**
+     * @brief Takes one unit from a quota if it has any.
+     * @param quota The quota to take from.
+     * @return True if a unit was taken.
+     */
+    static bool takeUnit(std::atomic<int> &quota);
+
+    /**
+     * @brief Moves up to a batch of units from the global capacity to a shard and takes one of them.
+     * @param shard The shard to refill.
+     * @return True if a unit was taken.
+     */
+    bool refill(Shard &shard);
+
+    /**
+     * @brief Moves half the quota of another shard to a shard and takes one unit of it.
+     * @param shard The shard that ran dry.
+     * @return True if a unit was taken.
+     */
+    bool steal(Shard &shard);
+
+    /**
+     * @brief Adds up the global capacity and every quota.
+     * @return The remaining capacity; the caller holds the lock of the shards.
+     */
+    [[nodiscard]] int countRemaining() const;
+
+public:
+    /**
+     * @brief Constructs a sharded consumable resource.
+     * @param name Name of the resource.
+     * @param capacity Total capacity of the resource.
+     * @param batchSize Units a thread takes from the global capacity when its quota runs dry.
+     * @throw std::invalid_argument If capacity or batchSize is not positive.
+     */
+    ShardedConsumableResource(const std::string &name, int capacity, int batchSize = 64);
+
+    /**
+     * @brief Checks if any unit remains, in the calling thread's quota, the global capacity or another quota.
+     * @return True if a unit can be allocated.
+     */
+    [[nodiscard]] bool isAvailableForUse() const override;
+
+    /**
+     * @brief Allocates one unit from the calling thread's quota, refilling or stealing when it is empty.
+     * @throw std::runtime_error If no unit remains anywhere.
+     */
+    void allocate() override;
+
+    /**
+     * @brief Releases the resource; as with any consumable, capacity is not restored.
+     */
+    void release() override;
+
+    /**
+     * @brief Displays the resource usage details, including remaining capacity.
+     */
+    void use() const override;
+
+    /**
+     * @brief Retrieves the remaining capacity of the resource.
+     * @return The global capacity plus every thread's quota.
+     */
+    [[nodiscard]] int getRemainingCapacity() const override;
+
+    /**
+     * @brief Restores capacity to the global capacity, up to the total capacity of the resource.
+     * @param units The number of units to restore.
+     * @throw std::invalid_argument If units is not positive.
+     */
+    void replenish(int units) override;
+
+    /**
+     * @brief Captures the availability and the remaining capacity, global and in every thread's quota.
+     * @return The state, to be passed back to restoreState().
+     */
+    [[nodiscard]] State saveState() const override;
+
+    /**
+     * @brief Puts back a state captured by saveState(), moving every unit to the global capacity.
+     * @param state The state to restore.
+     * @throw std::invalid_argument If the remaining capacity is negative or above the total capacity.
+     */
+    void restoreState(const State &state) override;
+
+    /**
+     * @brief Creates a sharded resource of the same name and batch size with another capacity, fully available.
+     * @param capacity Total capacity of the new resource.
+     * @return The new resource.
+     * @throw std::invalid_argument If the capacity is not positive.
+     */
+    [[nodiscard]] std::unique_ptr<ConsumableResource> cloneWithCapacity(int capacity) const override;
+};
+
+#endif //SHARDED_CONSUMABLE_RESOURCE_H
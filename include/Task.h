@@ -27,5 +27,11 @@ public:
      * @throw std::runtime_error If resources are not properly assigned.
      */
     void execute() const override;
+
+    /**
+     * @brief Creates an independent copy of the task's definition, without assigned or borrowed resources.
+     * @return The copy.
+     */
+    [[nodiscard]] std::unique_ptr<Executable> clone() const override;
 };
 #endif //TASK_H
@@ -0,0 +1,172 @@
+#ifndef TASK_QUEUE_H
+#define TASK_QUEUE_H
+
+#include "Executable.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Bounded lock-free queue through which many threads submit executables to running processes.
+ *
+ * The queue is a ring of cells, each carrying a sequence number that tells producers and consumers whether
+ * the cell is free for the current lap or holds a task (the Vyukov bounded multi-producer/multi-consumer
+ * design). Producers and consumers claim positions with a compare-and-swap on their own counter, so neither
+ * side takes a lock and a stalled thread only holds up the cell it claimed.
+ *
+ * When the queue is full, the backpressure policy decides what push() does: Block waits for room, Drop
+ * discards the task and counts it, and Reject throws so that the producer keeps the task. Once closed, the
+ * queue accepts nothing more and consumers stop waiting as soon as it is empty. Tasks still queued when the
+ * queue is destroyed are destroyed with it.
+ *
+ * A waiting pop(), or a push() blocked on a full queue, retries SpinCount times, yielding in between, and then
+ * parks on a condition variable. Pushes, pops and close() only take the lock to wake parked threads when a
+ * counter shows there are some, so the lock-free fast path stays free of locks while an idle service sleeps.
+ */
+class TaskQueue {
+public:
+    /**
+     * @brief Enumeration defining what push() does when the queue is full.
+     */
+    enum class Backpressure { Block, Drop, Reject };
+
+    static constexpr int SpinCount = 64; ///< Retries of a waiting push or pop, yielding in between, before parking.
+
+private:
+    /**
+     * @brief Slot of the ring, on a cache line of its own.
+     */
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{0}; ///< Position the cell expects next; tells free from filled cells.
+        Executable *task = nullptr; ///< Task held by a filled cell, owned by the queue.
+    };
+
+    std::unique_ptr<Cell[]> cells; ///< The ring; its size is a power of two.
+    std::size_t positionMask; ///< Ring size minus one, mapping positions to cells.
+    Backpressure backpressure; ///< What push() does when the queue is full.
+    alignas(64) std::atomic<std::size_t> enqueuePosition{0}; ///< Next position producers claim.
+    alignas(64) std::atomic<std::size_t> dequeuePosition{0}; ///< Next position consumers claim.
+    std::atomic<bool> closed{false}; ///< Set once no more tasks are accepted.
+    std::atomic<std::size_t> activePushes{0}; ///< Pushes in progress, which may still land after close().
+    std::atomic<std::uint64_t> droppedCount{0}; ///< Tasks discarded under the Drop policy.
+    std::atomic<std::size_t> parkedConsumers{0}; ///< Consumers parked, or about to park, on notEmpty.
+    std::atomic<std::size_t> parkedProducers{0}; ///< Block producers parked, or about to park, on notFull.
+    std::mutex parkingMutex; ///< Guards parking on and waking from the condition variables.
+    std::condition_variable notEmpty; ///< Wakes consumers when a task arrives or the queue may be drained.
+    std::condition_variable notFull; ///< Wakes Block producers when a cell frees up or the queue is closed.
+
+    /**
+     * @brief Stores a task in the next free cell if there is one.
+     * @param task The task; the queue owns it on success.
+     * @return False if the queue is full.
+     */
+    bool tryEnqueue(Executable *task);
+
+    /**
+     * @brief Takes the task of the oldest filled cell if there is one.
+     * @return The task, now owned by the caller, or nullptr if the queue is empty.
+     */
+    Executable *tryDequeue();
+
+    /**
+     * @brief Checks whether the next cell producers claim is free, without claiming it.
+     * @return True if a push may succeed.
+     */
+    [[nodiscard]] bool hasRoom() const;
+
+    /**
+     * @brief Checks whether the next cell consumers claim holds a task, without claiming it.
+     * @return True if a pop may succeed.
+     */
+    [[nodiscard]] bool hasTask() const;
+
+    /**
+     * @brief Wakes parked consumers, if any, after a task arrived or a push ended.
+     */
+    void wakeConsumers();
+
+    /**
+     * @brief Wakes parked producers, if any, after a cell freed up.
+     */
+    void wakeProducers();
+
+    /**
+     * @brief Checks whether consumers can stop waiting: the queue is closed and no push can still land.
+     * @return True if no task will arrive anymore.
+     */
+    [[nodiscard]] bool isDrained() const;
+
+public:
+    /**
+     * @brief Constructs an empty queue.
+     * @param capacity Minimum number of tasks the queue holds; rounded up to a power of two.
+     * @param backpressure What push() does when the queue is full.
+     * @throw std::invalid_argument If capacity is zero.
+     */
+    explicit TaskQueue(std::size_t capacity, Backpressure backpressure = Backpressure::Block);
+
+    /**
+     * @brief Destroys the queue and the tasks still queued.
+     */
+    ~TaskQueue();
+
+    TaskQueue(const TaskQueue &) = delete;
+    TaskQueue &operator=(const TaskQueue &) = delete;
+
+    /**
+     * @brief Submits a task, applying the backpressure policy if the queue is full.
+     * @param task The task; null once queued or dropped, still set if rejected.
+     * @return True if the task was queued, false if it was dropped.
+     * @throw std::invalid_argument If task is null.
+     * @throw std::runtime_error If the queue is full under the Reject policy.
+     * @throw std::logic_error If the queue is closed, including while a Block push waits.
+     */
+    bool push(std::unique_ptr<Executable> &task);
+
+    /**
+     * @brief Takes the oldest task without waiting.
+     * @param task Receives the task on success.
+     * @return False if the queue is empty.
+     */
+    bool tryPop(std::unique_ptr<Executable> &task);
+
+    /**
+     * @brief Takes the oldest task, waiting until one arrives or the queue is closed.
+     * @param task Receives the task on success.
+     * @return False once the queue is closed and empty.
+     */
+    bool pop(std::unique_ptr<Executable> &task);
+
+    /**
+     * @brief Stops accepting tasks; consumers drain the tasks already queued.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether the queue was closed.
+     * @return True if no more tasks are accepted.
+     */
+    [[nodiscard]] bool isClosed() const;
+
+    /**
+     * @brief Retrieves the number of tasks the queue holds.
+     * @return The capacity, a power of two.
+     */
+    [[nodiscard]] std::size_t getCapacity() const;
+
+    /**
+     * @brief Retrieves the policy applied when the queue is full.
+     * @return The backpressure policy.
+     */
+    [[nodiscard]] Backpressure getBackpressure() const;
+
+    /**
+     * @brief Retrieves the number of tasks discarded under the Drop policy.
+     * @return The number of dropped tasks.
+     */
+    [[nodiscard]] std::uint64_t getDroppedCount() const;
+};
+
+#endif //TASK_QUEUE_H
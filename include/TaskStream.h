@@ -0,0 +1,51 @@
+#ifndef TASK_STREAM_H
+#define TASK_STREAM_H
+
+#include "TaskQueue.h"
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Feeds a process running as a service with the tasks read from an unbounded stream.
+ *
+ * The stream holds one 'task' directive per line, in the scenario syntax of ScenarioLoader:
+ *
+ * @code
+ * task ScanSourceCode "Tokenize main.c" 2 CentralProcessingUnit Memory
+ * @endcode
+ *
+ * Each task is built as soon as its line is read and pushed into the TaskQueue that the process drains, so
+ * memory stays bounded by the queue capacity however many tasks pass through: with the Block policy, reading
+ * stops while the process is behind. A malformed line is reported and skipped rather than ending the
+ * service. The queue is closed when the stream ends, and reading stops early if the process closes it first.
+ */
+class TaskStream {
+public:
+    /**
+     * @brief Counts of a finished stream.
+     */
+    struct Totals {
+        std::uint64_t submitted = 0; ///< Tasks pushed into the queue.
+        std::uint64_t dropped = 0; ///< Tasks the queue discarded or rejected.
+        std::uint64_t invalid = 0; ///< Lines that were not valid task directives.
+    };
+
+    /**
+     * @brief Reads task directives until the stream ends or the queue is closed, submitting them, then closes
+     * the queue.
+     * @param input The stream to read directives from, such as standard input or a pipe.
+     * @param sourceName Name used to identify the source in error and progress messages.
+     * @param queue The queue the running process drains.
+     * @param progress Stream receiving a throughput line every reportInterval, or nullptr for none.
+     * @param reportInterval Time between progress lines.
+     * @return The counts of the stream.
+     */
+    static Totals submit(std::istream &input, const std::string &sourceName, TaskQueue &queue,
+                         std::ostream *progress = nullptr,
+                         std::chrono::steady_clock::duration reportInterval = std::chrono::seconds(1));
+};
+
+#endif //TASK_STREAM_H
@@ -0,0 +1,102 @@
+#ifndef THREAD_SHARDS_H
+#define THREAD_SHARDS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @brief Registry of per-thread shards, each thread reaching its own through a one-entry thread-local cache.
+ *
+ * Classes that let many threads record or allocate without contention keep a Shard per thread here. A thread
+ * finds its shard under the registry lock once; later calls compare the registry's identifier with the one its
+ * cache holds and skip the lock entirely. Identifiers are never reused, so a cache entry of a destroyed registry
+ * never matches another. Shards live as long as the registry, and readers visit them under getMutex().
+ *
+ * @tparam Shard Data kept per thread; it must be default-constructible.
+ */
+template<typename Shard>
+class ThreadShards {
+private:
+    std::uint64_t instanceId; ///< Unique identifier used to validate the per-thread cache.
+    mutable std::mutex registryMutex; ///< Guards the registry and whatever its owner guards with it.
+    std::unordered_map<std::thread::id, std::unique_ptr<Shard> > shards; ///< Shards by thread.
+
+    /**
+     * @brief Issues registry identifiers; identifiers are never reused.
+     * @return A fresh identifier, never zero.
+     */
+    static std::uint64_t nextInstanceId() {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+
+public:
+    /**
+     * @brief Constructs an empty registry.
+     */
+    ThreadShards() : instanceId(nextInstanceId()) {}
+
+    ThreadShards(const ThreadShards &) = delete;
+    ThreadShards &operator=(const ThreadShards &) = delete;
+
+    /**
+     * @brief Retrieves the calling thread's shard, creating it on first use.
+     * @param initialise Called under the lock on a shard just created, with the number of shards including it.
+     * @return The shard of the calling thread.
+     */
+    template<typename Initialise>
+    Shard &local(Initialise &&initialise) {
+        // One-entry cache: consecutive calls from a thread on the same registry skip the lock entirely.
+        thread_local std::uint64_t cachedInstance = 0;
+        thread_local Shard *cachedShard = nullptr;
+        if (cachedInstance == instanceId) return *cachedShard;
+
+        const std::lock_guard<std::mutex> lock(registryMutex);
+        auto &shard = shards[std::this_thread::get_id()];
+        if (!shard) {
+            shard = std::make_unique<Shard>();
+            initialise(*shard, shards.size());
+        }
+        cachedInstance = instanceId;
+        cachedShard = shard.get();
+        return *shard;
+    }
+
+    /**
+     * @brief Retrieves the calling thread's shard, creating it on first use.
+     * @return The shard of the calling thread.
+     */
+    Shard &local() {
+        return local([](Shard &, std::size_t) {});
+    }
+
+    /**
+     * @brief Retrieves the lock guarding the registry, which readers hold while visiting the shards.
+     * @return The registry lock.
+     */
+    std::mutex &getMutex() const { return registryMutex; }
+
+    /**
+     * @brief Visits every shard; the caller holds getMutex().
+     * @param visit Called with each shard.
+     */
+    template<typename Visit>
+    void forEach(Visit &&visit) {
+        for (auto &entry: shards) visit(*entry.second);
+    }
+
+    /**
+     * @brief Visits every shard; the caller holds getMutex().
+     * @param visit Called with each shard.
+     */
+    template<typename Visit>
+    void forEach(Visit &&visit) const {
+        for (const auto &entry: shards) visit(static_cast<const Shard &>(*entry.second));
+    }
+};
+
+#endif //THREAD_SHARDS_H
@@ -0,0 +1,158 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include "ThreadShards.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records timeline events of process runs and exports them as Chrome trace JSON.
+ *
+ * Executions are instrumented with begin/end events (process, task, resource assignment and release) and
+ * with asynchronous spans for the time each resource is held. Events go into a buffer per thread that is
+ * allocated once with a fixed capacity; when it is full further events are counted as dropped instead of
+ * growing the buffer. The output loads in chrome://tracing and ui.perfetto.dev.
+ *
+ * Instrumentation checks TraceRecorder::active(), a single atomic load, so tracing costs nothing beyond
+ * that check while no recorder is installed.
+ */
+class TraceRecorder {
+public:
+    /// @brief Enumeration defining the kind of activity an event belongs to.
+    enum class Category { Process, Task, Assign, Release, Resource };
+
+    static constexpr std::size_t NameLength = 47; ///< Longest event name kept; longer names are truncated.
+
+    /**
+     * @brief A single recorded event.
+     */
+    struct Event {
+        char name[NameLength + 1]; ///< Null-terminated, possibly truncated name.
+        Category category; ///< Activity the event belongs to.
+        char phase; ///< Chrome trace phase: 'B'/'E' for spans, 'b'/'e' for asynchronous spans.
+        std::uint64_t timestampNanoseconds; ///< Time since the recorder was created.
+        std::uint64_t spanId; ///< Identifier pairing asynchronous begin and end events.
+    };
+
+private:
+    /**
+     * @brief Preallocated event buffer of one thread.
+     */
+    struct ThreadBuffer {
+        std::uint32_t threadId = 0; ///< Sequential identifier of the recording thread.
+        std::vector<Event> events; ///< Recorded events; capacity is reserved up front.
+        std::uint64_t dropped = 0; ///< Events discarded because the buffer was full.
+    };
+
+    static std::atomic<TraceRecorder *> activeRecorder; ///< Recorder receiving instrumentation events.
+
+    std::atomic<std::uint64_t> lastSpanId{0}; ///< Last identifier issued to an asynchronous span.
+    std::size_t eventsPerThread; ///< Capacity of each thread buffer.
+    std::chrono::steady_clock::time_point origin; ///< Time origin of all timestamps.
+    ThreadShards<ThreadBuffer> buffers; ///< Buffers by recording thread.
+
+    /**
+     * @brief Retrieves the calling thread's buffer, allocating it on first use.
+     * @return The buffer of the calling thread.
+     */
+    ThreadBuffer &localBuffer();
+
+    /**
+     * @brief Appends an event to the calling thread's buffer.
+     * @param category Activity the event belongs to.
+     * @param phase Chrome trace phase of the event.
+     * @param name Name of the event.
+     * @param spanId Identifier pairing asynchronous events; 0 for synchronous spans.
+     */
+    void record(Category category, char phase, const std::string &name, std::uint64_t spanId);
+
+public:
+    /**
+     * @brief Constructs a recorder.
+     * @param eventsPerThread Number of events each recording thread can hold.
+     * @throw std::invalid_argument If the capacity is zero.
+     */
+    explicit TraceRecorder(std::size_t eventsPerThread = 262144);
+
+    /**
+     * @brief Uninstalls the recorder if it is still active.
+     */
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    /**
+     * @brief Retrieves the recorder that instrumentation reports to.
+     * @return The installed recorder, or nullptr when tracing is disabled.
+     */
+    static TraceRecorder *active() { return activeRecorder.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Installs the recorder that instrumentation reports to.
+     * @param recorder The recorder to install, or nullptr to disable tracing.
+     */
+    static void install(TraceRecorder *recorder);
+
+    /**
+     * @brief Records the beginning of a span on the calling thread.
+     * @param category Activity the span belongs to.
+     * @param name Name of the span.
+     */
+    void begin(Category category, const std::string &name);
+
+    /**
+     * @brief Records the end of the innermost open span on the calling thread.
+     * @param category Activity the span belongs to.
+     * @param name Name of the span.
+     */
+    void end(Category category, const std::string &name);
+
+    /**
+     * @brief Issues an identifier for an asynchronous span, unique among the spans of this recorder.
+     * @return A fresh, non-zero identifier.
+     * @note Overlapping spans of one resource, such as several holds of a consumable, each need their own.
+     */
+    std::uint64_t newSpanId();
+
+    /**
+     * @brief Records the beginning of an asynchronous span, such as a resource being held.
+     * @param category Activity the span belongs to.
+     * @param name Name of the span.
+     * @param spanId Identifier shared with the matching end event.
+     */
+    void beginAsync(Category category, const std::string &name, std::uint64_t spanId);
+
+    /**
+     * @brief Records the end of an asynchronous span.
+     * @param category Activity the span belongs to.
+     * @param name Name of the span.
+     * @param spanId Identifier shared with the matching begin event.
+     */
+    void endAsync(Category category, const std::string &name, std::uint64_t spanId);
+
+    /**
+     * @brief Counts the recorded events of all threads.
+     * @return The number of recorded events.
+     */
+    [[nodiscard]] std::size_t getEventCount() const;
+
+    /**
+     * @brief Counts the events discarded because a thread buffer was full.
+     * @return The number of dropped events.
+     */
+    [[nodiscard]] std::uint64_t getDroppedEventCount() const;
+
+    /**
+     * @brief Writes all recorded events in Chrome trace event format.
+     * @param output The stream to write to.
+     * @note Call it once recording threads are quiescent.
+     */
+    void writeChromeTrace(std::ostream &output) const;
+};
+
+#endif //TRACE_RECORDER_H
@@ -28,6 +28,12 @@ public:
      */
     [[nodiscard]] bool isAvailableForUse() const override;
 
+    /**
+     * @brief Retrieves the capacity of the resource.
+     * @return The capacity (e.g., GHz).
+     */
+    [[nodiscard]] int getCapacity() const;
+
     /**
      * @brief Allocates the resource, marking it as unavailable.
      * @throw std::runtime_error If the resource is already allocated.
@@ -43,5 +49,11 @@ public:
      * @brief Displays the resource usage details, including its capacity.
      */
     void use() const override;
+
+    /**
+     * @brief Creates an independent copy of the resource in its current state, without its listeners.
+     * @return The copy.
+     */
+    [[nodiscard]] std::unique_ptr<Resource> clone() const override;
 };
 #endif //USABLE_RESOURCE_H
@@ -0,0 +1,92 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "Process.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Parameters of a synthetic workload built by WorkloadGenerator.
+ */
+struct WorkloadOptions {
+    /// @brief Enumeration defining the dependency structure between generated tasks.
+    enum class Shape {
+        Chain, ///< Every task depends on the previous one.
+        Wide, ///< Every task depends on the first task only.
+        Random ///< Every task depends on up to maxDependencies random tasks among the previous dependencyWindow.
+    };
+
+    /// @brief Enumeration defining how task durations are drawn.
+    enum class DurationDistribution {
+        Constant, ///< Every task lasts minimumDuration units.
+        Uniform, ///< Durations are uniform in [minimumDuration, maximumDuration].
+        Exponential ///< Durations are minimumDuration plus an exponential tail with mean meanDuration, capped at maximumDuration.
+    };
+
+    std::size_t taskCount = 1000; ///< Number of tasks to generate.
+    std::size_t requirementFanOut = 2; ///< Distinct resources required by every task.
+    std::size_t usableResourceCount = 4; ///< Number of UsableResource units, named CPU0, CPU1, ...
+    std::size_t consumableResourceCount = 4; ///< Number of ConsumableResource pools, named Memory0, Memory1, ...
+    int usableCapacity = 3; ///< Capacity of every usable resource (GHz).
+    int consumableCapacity = 1000000000; ///< Capacity of every consumable resource (MB).
+    DurationDistribution durationDistribution = DurationDistribution::Uniform; ///< Distribution of task durations.
+    int minimumDuration = 1; ///< Smallest task duration in units.
+    int maximumDuration = 10; ///< Largest task duration in units.
+    double meanDuration = 3.0; ///< Mean of the exponential tail.
+    Shape shape = Shape::Random; ///< Dependency structure between tasks.
+    std::size_t maxDependencies = 2; ///< Upper bound of dependencies per task for the random shape.
+    std::size_t dependencyWindow = 64; ///< How far back the random shape looks for dependencies.
+    std::uint64_t seed = 42; ///< Seed of the random generator; equal seeds give identical workloads.
+
+    /**
+     * @brief Sets an option from its textual form, as used by scenario files.
+     * @param key Option name: tasks, fanout, usable, consumable, usable-capacity, consumable-capacity,
+     *            durations, min-duration, max-duration, mean-duration, shape, max-dependencies, window or seed.
+     * @param value Option value.
+     * @throw std::invalid_argument If the key is unknown or the value is invalid.
+     */
+    void set(const std::string &key, const std::string &value);
+
+    /**
+     * @brief Checks that the options describe a workload that can be generated.
+     * @throw std::invalid_argument If a count, capacity or duration bound is out of range.
+     */
+    void validate() const;
+};
+
+/**
+ * @brief Builds synthetic Process instances for scale testing.
+ *
+ * Generated processes have no requirements of their own, a pool of usable and consumable resources, and
+ * tasks added in topological order so that Process::execute honours their dependencies. The generator uses
+ * its own integer arithmetic on a std::mt19937_64 stream, so a seed yields the same workload on every
+ * platform and standard library.
+ */
+class WorkloadGenerator {
+private:
+    WorkloadOptions options; ///< Parameters of the generated workloads.
+
+public:
+    /**
+     * @brief Constructs a generator for the given parameters.
+     * @param options Parameters of the generated workloads.
+     * @throw std::invalid_argument If the options are invalid.
+     */
+    explicit WorkloadGenerator(WorkloadOptions options);
+
+    /**
+     * @brief Retrieves the parameters of the generated workloads.
+     * @return The workload options.
+     */
+    [[nodiscard]] const WorkloadOptions &getOptions() const;
+
+    /**
+     * @brief Generates a process with the configured resources and tasks.
+     * @param processName Name of the generated process.
+     * @return The generated process.
+     */
+    [[nodiscard]] std::unique_ptr<Process> generate(const std::string &processName = "SyntheticWorkload") const;
+};
+
+#endif //WORKLOAD_GENERATOR_H
@@ -10,22 +10,134 @@
  * illustrate Object-Oriented Programming (OOP) concepts. It simulates a compilation process where
  * a Process manages Tasks (scanning, parsing, etc.), utilizing Consumable (Memory) and Usable (CPU)
  * resources, showcasing encapsulation, inheritance, polymorphism, and abstraction.
+ *
+ * The executable doubles as a command-line driver: it runs scenario files a configurable number of
+ * times on several threads and reports throughput and per-phase timings (see CommandLineOptions).
  */
 
+#include "CapacityPlan.h"
+#include "CapacitySweep.h"
+#include "CommandLineOptions.h"
+#include "ExecutionMetrics.h"
+#include "FairShareScheduler.h"
+#include "Json.h"
 #include "Process.h"
+#include "ResourceManager.h"
+#include "ResultCache.h"
+#include "ScenarioLoader.h"
 #include "Task.h"
+#include "TaskQueue.h"
+#include "TaskStream.h"
+#include "TraceRecorder.h"
 #include "UsableResource.h"
 #include "ConsumableResource.h"
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Totals accumulated while loading and running scenarios.
+     */
+    struct RunTotals {
+        Clock::duration loadTime{}; ///< Time spent building processes.
+        Clock::duration runTime{}; ///< Time spent running processes.
+        std::size_t runs = 0; ///< Number of scenario runs.
+        std::size_t processes = 0; ///< Number of processes run.
+        std::size_t tasks = 0; ///< Number of tasks scheduled.
+
+        /**
+         * @brief Adds the totals of another worker.
+         * @param other The totals to add.
+         */
+        void merge(const RunTotals &other) {
+            loadTime += other.loadTime;
+            runTime += other.runTime;
+            runs += other.runs;
+            processes += other.processes;
+            tasks += other.tasks;
+        }
+    };
+
+    /**
+     * @brief Metrics shared by all repetitions of the same process, keyed by scenario source and process name.
+     */
+    class MetricsRegistry {
+    private:
+        /**
+         * @brief Metrics of one process together with an instance used to label them.
+         */
+        struct Entry {
+            std::shared_ptr<ExecutionMetrics> metrics; ///< Metrics shared by all repetitions.
+            std::unique_ptr<Process> exemplar; ///< A finished repetition providing task and resource names.
+        };
+
+        std::mutex entriesMutex; ///< Guards the entries.
+        std::map<std::string, Entry> entries; ///< Entries by source and process name.
+
+    public:
+        /**
+         * @brief Attaches the shared metrics of their scenario to freshly loaded processes.
+         * @param source The scenario source the processes were loaded from.
+         * @param processes The loaded processes.
+         */
+        void attach(const std::string &source, const std::vector<std::unique_ptr<Process> > &processes) {
+            const std::lock_guard<std::mutex> lock(entriesMutex);
+            for (const auto &process: processes) {
+                auto &entry = entries[source + "\n" + process->getName()];
+                if (!entry.metrics) entry.metrics = std::make_shared<ExecutionMetrics>();
+                process->setMetrics(entry.metrics);
+            }
+        }
+
+        /**
+         * @brief Keeps the first finished repetition of each process to label the metrics.
+         * @param source The scenario source the processes were loaded from.
+         * @param processes The finished processes; adopted ones are moved out.
+         */
+        void adopt(const std::string &source, std::vector<std::unique_ptr<Process> > &processes) {
+            const std::lock_guard<std::mutex> lock(entriesMutex);
+            for (auto &process: processes) {
+                auto &entry = entries[source + "\n" + process->getName()];
+                if (!entry.exemplar) entry.exemplar = std::move(process);
+            }
+        }
+
+        /**
+         * @brief Writes the metrics of all processes as a JSON document.
+         * @param output The stream to write to.
+         */
+        void writeJson(std::ostream &output) {
+            const std::lock_guard<std::mutex> lock(entriesMutex);
+            output << "{\"processes\":[";
+            bool first = true;
+            for (const auto &[key, entry]: entries) {
+                if (!entry.exemplar) continue;
+                output << (first ? "" : ",");
+                entry.exemplar->writeMetricsJson(output);
+                first = false;
+            }
+            output << "]}\n";
+        }
+    };
+
+    /**
+     * @brief Builds the built-in compilation scenario used when no scenario file is given.
+     * @return The CompileMain and CompileLimited processes.
+     */
+    std::vector<std::unique_ptr<Process> > buildDefaultScenario() {
+        std::vector<std::unique_ptr<Process> > processes;
 
-/**
- * @brief Main function to demonstrate OOP concepts via process simulation.
- * @return 0 on successful execution, 1 if a critical error occurs.
- */
-int main() {
-    try {
         // Compilation process for main.c
-        const auto compilationProcess = std::unique_ptr<Process>(
+        auto compilationProcess = std::unique_ptr<Process>(
             new Process("CompileMain", "Compile main.c to main.exe", {"CentralProcessingUnit", "Memory"}, 15));
 
         // Add resources to the pool
@@ -45,14 +157,10 @@ int main() {
                                                                    {"CentralProcessingUnit", "Memory"}, 3)));
         compilationProcess->addTask(std::unique_ptr<Task>(new Task("LinkBinary", "Link object files into main.exe",
                                                                    {"CentralProcessingUnit", "Memory"}, 2)));
-
-        // Run successful compilation
-        std::cout << "Starting compilation simulation...\n";
-        compilationProcess->run();
+        processes.push_back(std::move(compilationProcess));
 
         // Simulate compilation with limited memory
-        std::cout << "\nSimulating compilation with limited memory...\n";
-        const auto limitedCompilation = std::unique_ptr<Process>(
+        auto limitedCompilation = std::unique_ptr<Process>(
             new Process("CompileLimited", "Compile main.c with low memory", {"CentralProcessingUnit", "Memory"}, 15));
         limitedCompilation->
                 addResource(std::unique_ptr<UsableResource>(new UsableResource("CentralProcessingUnit", 3)));
@@ -61,11 +169,385 @@ int main() {
                                                                    {"CentralProcessingUnit", "Memory"}, 2)));
         limitedCompilation->addTask(std::unique_ptr<Task>(new Task("ParseSyntax", "Build syntax tree from tokens",
                                                                    {"CentralProcessingUnit", "Memory"}, 3)));
-        limitedCompilation->run();
+        processes.push_back(std::move(limitedCompilation));
+
+        return processes;
+    }
+
+    /**
+     * @brief Builds the processes of a scenario source.
+     * @param source Path of a scenario file, or an empty string for the built-in scenario.
+     * @return The processes of the scenario.
+     * @throw std::runtime_error If the scenario file cannot be loaded.
+     */
+    std::vector<std::unique_ptr<Process> > loadScenario(const std::string &source) {
+        return source.empty() ? buildDefaultScenario() : ScenarioLoader::loadFile(source);
+    }
+
+    /**
+     * @brief Runs the share of scenario repetitions assigned to one worker thread.
+     * @param options The driver options.
+     * @param sources Scenario sources to run; an empty string denotes the built-in scenario.
+     * @param worker Index of the worker, used to pick every threadCount-th repetition.
+     * @param totals Totals to accumulate into.
+     * @param metrics Registry of shared metrics, or nullptr when metrics are disabled.
+     * @param cache Result cache shared by all processes, or nullptr when caching is disabled.
+     * @throw std::runtime_error If a scenario file cannot be loaded.
+     */
+    void runRepetitions(const CommandLineOptions &options, const std::vector<std::string> &sources,
+                        const int worker, RunTotals &totals, MetricsRegistry *metrics,
+                        const std::shared_ptr<ResultCache> &cache) {
+        const std::size_t unitCount = sources.size() * static_cast<std::size_t>(options.repeatCount);
+        for (std::size_t unit = worker; unit < unitCount; unit += options.threadCount) {
+            const auto &source = sources[unit % sources.size()];
+            const auto repetition = unit / sources.size() + 1;
+            std::cout << "Starting simulation of " << (source.empty() ? "built-in compilation scenario" : source);
+            if (options.repeatCount > 1) std::cout << " (run " << repetition << "/" << options.repeatCount << ")";
+            std::cout << "...\n";
+
+            const auto loadStart = Clock::now();
+            auto processes = loadScenario(source);
+            for (const auto &process: processes) {
+                process->setRequirementMatching(options.requirementMatching);
+                process->setScheduling(options.scheduling);
+                process->setAdmission(options.admission);
+                process->setReferenceCapacity(options.referenceCapacity);
+                process->setResourceDelegation(options.delegation);
+                process->setResultCache(cache);
+                process->compile();
+            }
+            if (metrics) metrics->attach(source, processes);
+            const auto runStart = Clock::now();
+            // A streamed run feeds the first process from a reader thread while it runs as a service.
+            std::thread streamReader;
+            TaskStream::Totals streamed;
+            std::shared_ptr<TaskQueue> queue;
+            if (!options.streamFile.empty()) {
+                if (processes.empty()) throw std::runtime_error("No process to run the task stream");
+                queue = std::make_shared<TaskQueue>(static_cast<std::size_t>(options.queueCapacity));
+                processes.front()->setSubmissionQueue(queue);
+                streamReader = std::thread([&options, queue, &streamed] {
+                    if (options.streamFile == "-") {
+                        streamed = TaskStream::submit(std::cin, "stdin", *queue, &std::clog);
+                        return;
+                    }
+                    std::ifstream input(options.streamFile);
+                    if (!input) std::cerr << "Cannot open task stream '" << options.streamFile << "'\n";
+                    streamed = TaskStream::submit(input, options.streamFile, *queue, &std::clog);
+                });
+            }
+            for (const auto &process: processes) {
+                process->run();
+                totals.tasks += process->getTaskCount() + process->getPipelineTaskCount();
+                if (!options.changedInputs.empty()) {
+                    std::cout << "Rerunning tasks of '" << process->getName() << "' affected by changed inputs\n";
+                    totals.tasks += process->rerunChanged(options.changedInputs);
+                }
+            }
+            if (streamReader.joinable()) {
+                // A service that could not start never drained the queue; closing it stops the reader.
+                queue->close();
+                streamReader.join();
+                totals.tasks += streamed.submitted;
+                std::clog << streamed.submitted << " tasks streamed, " << streamed.dropped << " dropped, "
+                          << streamed.invalid << " invalid lines\n";
+            }
+            const auto runEnd = Clock::now();
+
+            totals.loadTime += runStart - loadStart;
+            totals.runTime += runEnd - runStart;
+            totals.processes += processes.size();
+            ++totals.runs;
+            if (metrics) metrics->adopt(source, processes);
+        }
+    }
+
+    /**
+     * @brief Simulates every process of the scenarios under each combination of the swept capacities.
+     * @param options The driver options.
+     * @param sources Scenario sources to sweep; an empty string denotes the built-in scenario.
+     * @param console Stream receiving the table of outcomes while the simulation output is silenced.
+     * @throw std::runtime_error If a scenario file cannot be loaded.
+     */
+    void runSweeps(const CommandLineOptions &options, const std::vector<std::string> &sources, std::ostream &console) {
+        const std::size_t threadCount = options.threadCount > 1 ? static_cast<std::size_t>(options.threadCount) : 0;
+        for (const auto &source: sources) {
+            for (const auto &process: loadScenario(source)) {
+                process->setRequirementMatching(options.requirementMatching);
+                process->setResourceDelegation(options.delegation);
+                process->setAdmission(options.admission);
+                process->setReferenceCapacity(options.referenceCapacity);
+                CapacitySweep sweep(*process);
+                for (const auto &dimension: options.sweepDimensions) {
+                    sweep.addDimension(dimension.resourceName, dimension.values);
+                }
+                console << "Sweep of '" << process->getName() << "' (" << sweep.getGridSize() << " variants):\n";
+                try {
+                    for (const auto &result: sweep.runGrid(threadCount)) {
+                        console << " ";
+                        for (const auto &[resourceName, value]: result.capacities) {
+                            console << " " << resourceName << "=" << value;
+                        }
+                        if (!result.started) {
+                            console << ": did not start\n";
+                            continue;
+                        }
+                        console << ": makespan " << result.report.makespan << ", " << result.report.completed
+                                << " completed, " << result.report.skipped << " skipped, " << result.report.failed
+                                << " failed\n";
+                    }
+                } catch (const std::invalid_argument &e) {
+                    console << "  " << e.what() << "\n";
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Simulates the processes of each scenario together on its shared resources and prints the share of
+     * throughput and latency each process gets.
+     * @param options The driver options.
+     * @param sources Scenario sources to simulate; an empty string denotes the built-in scenario.
+     * @param console Stream receiving the outcomes.
+     * @throw std::runtime_error If a scenario file cannot be loaded.
+     */
+    void printFairShares(const CommandLineOptions &options, const std::vector<std::string> &sources,
+                         std::ostream &console) {
+        for (const auto &source: sources) {
+            const auto processes = loadScenario(source);
+            // Without shared resources, every process draws from its own pool only.
+            auto machine = processes.empty() ? nullptr : processes.front()->getResourceManager();
+            if (!machine) machine = std::make_shared<ResourceManager>();
+            FairShareScheduler scheduler(*machine, *options.fairShare);
+            for (const auto &process: processes) scheduler.addProcess(*process);
+            const auto report = scheduler.run();
+            console << "Fair share of " << (source.empty() ? "built-in compilation scenario" : source) << " ("
+                    << (*options.fairShare == FairShareScheduler::Policy::FirstCome ? "first come" : "drf")
+                    << "), makespan " << report.makespan << " units:\n";
+            for (const auto &outcome: report.processes) {
+                console << "  " << outcome.processName << " (weight " << outcome.weight << "): "
+                        << outcome.completed << " completed, " << outcome.skipped << " skipped, finished at "
+                        << outcome.finishTime << ", " << outcome.throughput << " tasks/unit, latency mean "
+                        << outcome.meanLatency << " max " << outcome.maxLatency << ", peak share "
+                        << static_cast<int>(outcome.peakShare * 100 + 0.5) << "%\n";
+            }
+        }
+    }
+
+    /**
+     * @brief Prints the minimum capacities of every process of the scenarios, without running them.
+     * @param options The driver options.
+     * @param sources Scenario sources to plan; an empty string denotes the built-in scenario.
+     * @param console Stream receiving the minimums.
+     * @throw std::runtime_error If a scenario file cannot be loaded.
+     */
+    void printCapacityPlans(const CommandLineOptions &options, const std::vector<std::string> &sources,
+                            std::ostream &console) {
+        for (const auto &source: sources) {
+            for (const auto &process: loadScenario(source)) {
+                process->setResourceDelegation(options.delegation);
+                const auto plan = process->planCapacities();
+                console << "Minimum capacities of '" << process->getName() << "'"
+                        << (plan.isSufficient() ? "" : " (pool too small)") << ":\n";
+                for (const auto &requirement: plan.getRequirements()) {
+                    const bool consumable = requirement.type == Resource::Type::Consumable;
+                    console << "  " << requirement.resourceName << " (" << (consumable ? "consumable" : "usable")
+                            << "): needs " << requirement.demand << (consumable ? " units" : " at once") << ", has "
+                            << requirement.available << " -> minimum " << requirement.minimum
+                            << (consumable ? " units" : " resources");
+                    if (consumable && requirement.resourceCount > 1) console << " each";
+                    console << (requirement.available < requirement.demand ? " (short)" : "") << "\n";
+                }
+                for (const auto &obstacle: plan.getObstacles()) {
+                    console << "  '" << obstacle.executableName << "' cannot run: " << obstacle.reason << "\n";
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Converts a duration to fractional milliseconds.
+     * @param duration The duration to convert.
+     * @return The duration in milliseconds.
+     */
+    double toMilliseconds(const Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    /**
+     * @brief Prints the run statistics in the requested output mode.
+     * @param options The driver options.
+     * @param totals The accumulated totals of all workers.
+     * @param wallTime Elapsed wall-clock time of all runs.
+     */
+    void reportStatistics(const CommandLineOptions &options, const RunTotals &totals, const Clock::duration wallTime) {
+        const double wallSeconds = std::chrono::duration<double>(wallTime).count();
+        const double tasksPerSecond = wallSeconds > 0 ? static_cast<double>(totals.tasks) / wallSeconds : 0.0;
+
+        if (options.outputMode == CommandLineOptions::OutputMode::Json) {
+            std::cout << "{\"scenarios\":[";
+            for (std::size_t index = 0; index < options.scenarioFiles.size(); ++index) {
+                std::cout << (index ? "," : "") << Json::quote(options.scenarioFiles[index]);
+            }
+            std::cout << "],\"repeat\":" << options.repeatCount << ",\"threads\":" << options.threadCount
+                    << ",\"runs\":" << totals.runs << ",\"processes\":" << totals.processes
+                    << ",\"tasks\":" << totals.tasks << ",\"wall_ms\":" << toMilliseconds(wallTime)
+                    << ",\"tasks_per_second\":" << tasksPerSecond
+                    << ",\"phases\":{\"load_ms\":" << toMilliseconds(totals.loadTime)
+                    << ",\"run_ms\":" << toMilliseconds(totals.runTime) << "}}\n";
+            return;
+        }
+        std::cout << std::fixed << std::setprecision(3)
+                << "\nSummary: " << totals.runs << " runs, " << totals.processes << " processes, "
+                << totals.tasks << " tasks in " << toMilliseconds(wallTime) << " ms ("
+                << std::setprecision(1) << tasksPerSecond << " tasks/s)\n"
+                << std::setprecision(3) << "  load: " << toMilliseconds(totals.loadTime)
+                << " ms, run: " << toMilliseconds(totals.runTime) << " ms\n";
+    }
+}
+
+/**
+ * @brief Main function to demonstrate OOP concepts via process simulation.
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments (see CommandLineOptions::usage).
+ * @return 0 on successful execution, 1 if a critical error occurs.
+ */
+int main(const int argc, char *argv[]) {
+    CommandLineOptions options;
+    try {
+        options = CommandLineOptions::parse(argc, argv);
     } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n" << CommandLineOptions::usage(argv[0]);
+        return 1;
+    }
+    if (options.showHelp) {
+        std::cout << CommandLineOptions::usage(argv[0]);
+        return 0;
+    }
+
+    // Quiet and JSON modes silence the simulation output; statistics are printed once it is restored.
+    std::streambuf *const consoleBuffer = std::cout.rdbuf();
+    if (options.outputMode != CommandLineOptions::OutputMode::Verbose) {
+        std::cout.rdbuf(nullptr);
+    }
+
+    const std::vector<std::string> sources = options.scenarioFiles.empty()
+                                                 ? std::vector<std::string>{""}
+                                                 : options.scenarioFiles;
+    if (options.planCapacities) {
+        // Planning runs nothing, so only the minimums reach the console.
+        std::ostream console(consoleBuffer);
+        try {
+            printCapacityPlans(options, sources, console);
+        } catch (const std::exception &e) {
+            std::cout.rdbuf(consoleBuffer);
+            std::cerr << "Critical error in main: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout.rdbuf(consoleBuffer);
+        return 0;
+    }
+    if (options.fairShare) {
+        // The processes are simulated by unit counts, so only the outcomes reach the console.
+        std::ostream console(consoleBuffer);
+        try {
+            printFairShares(options, sources, console);
+        } catch (const std::exception &e) {
+            std::cout.rdbuf(consoleBuffer);
+            std::cerr << "Critical error in main: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout.rdbuf(consoleBuffer);
+        return 0;
+    }
+    if (!options.sweepDimensions.empty()) {
+        // Variants run concurrently, so their simulation output and warnings are silenced.
+        std::ostream console(consoleBuffer);
+        std::streambuf *const errorBuffer = std::cerr.rdbuf(nullptr);
+        std::cout.rdbuf(nullptr);
+        try {
+            runSweeps(options, sources, console);
+        } catch (const std::exception &e) {
+            std::cout.rdbuf(consoleBuffer);
+            std::cerr.rdbuf(errorBuffer);
+            std::cerr << "Critical error in main: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout.rdbuf(consoleBuffer);
+        std::cerr.rdbuf(errorBuffer);
+        return 0;
+    }
+
+    RunTotals totals;
+    MetricsRegistry metricsRegistry;
+    MetricsRegistry *const metrics = options.metricsFile.empty() ? nullptr : &metricsRegistry;
+    std::exception_ptr failure;
+    std::unique_ptr<TraceRecorder> trace;
+    if (!options.traceFile.empty()) {
+        trace = std::make_unique<TraceRecorder>();
+        TraceRecorder::install(trace.get());
+    }
+    std::shared_ptr<ResultCache> cache;
+    const auto wallStart = Clock::now();
+    try {
+        if (!options.cacheFile.empty()) {
+            cache = std::make_shared<ResultCache>();
+            cache->load(options.cacheFile);
+        }
+        if (options.threadCount == 1) {
+            runRepetitions(options, sources, 0, totals, metrics, cache);
+        } else {
+            std::mutex totalsMutex;
+            std::vector<std::thread> workers;
+            for (int worker = 0; worker < options.threadCount; ++worker) {
+                workers.emplace_back([&, worker] {
+                    RunTotals workerTotals;
+                    try {
+                        runRepetitions(options, sources, worker, workerTotals, metrics, cache);
+                    } catch (...) {
+                        const std::lock_guard<std::mutex> lock(totalsMutex);
+                        if (!failure) failure = std::current_exception();
+                    }
+                    const std::lock_guard<std::mutex> lock(totalsMutex);
+                    totals.merge(workerTotals);
+                });
+            }
+            for (auto &worker: workers) worker.join();
+        }
+        if (failure) std::rethrow_exception(failure);
+        if (cache) cache->save(options.cacheFile);
+    } catch (const std::exception &e) {
+        std::cout.rdbuf(consoleBuffer);
         std::cerr << "Critical error in main: " << e.what() << "\n";
         return 1;
     }
+    const auto wallTime = Clock::now() - wallStart;
 
+    std::cout.rdbuf(consoleBuffer);
+    reportStatistics(options, totals, wallTime);
+    if (cache) {
+        std::clog << "Result cache: " << cache->getHits() << " hits, " << cache->getMisses() << " misses, "
+                  << cache->size() << " entries in '" << options.cacheFile << "'\n";
+    }
+    if (metrics) {
+        std::ofstream metricsOutput(options.metricsFile);
+        if (!metricsOutput) {
+            std::cerr << "Critical error in main: cannot write metrics to '" << options.metricsFile << "'\n";
+            return 1;
+        }
+        metrics->writeJson(metricsOutput);
+    }
+    if (trace) {
+        TraceRecorder::install(nullptr);
+        std::ofstream traceOutput(options.traceFile);
+        if (!traceOutput) {
+            std::cerr << "Critical error in main: cannot write trace to '" << options.traceFile << "'\n";
+            return 1;
+        }
+        trace->writeChromeTrace(traceOutput);
+        if (trace->getDroppedEventCount() > 0) {
+            std::cerr << "Warning: " << trace->getDroppedEventCount() << " trace events dropped (buffers full)\n";
+        }
+    }
     return 0;
 }
@@ -0,0 +1,264 @@
+#include "CapacityPlan.h"
+#include "ConsumableResource.h"
+#include <algorithm>
+#include <climits>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Computes the demand of a process on its pool.
+ * @param resourcePool The pool of the process.
+ * @param tasks The tasks of the process.
+ * @param processName Name of the process, reported if its own requirements cannot be met.
+ * @param ownRequirements Names the process allocates from its pool for its whole run.
+ * @param lentNames Names of the resources the process lends to its tasks, once per loan.
+ * @param stages Pipeline stages of the process, each run once per pipeline input.
+ * @param inputCount Number of pipeline inputs.
+ */
+CapacityPlan::CapacityPlan(const std::vector<std::unique_ptr<Resource> > &resourcePool,
+                           const std::vector<std::unique_ptr<Executable> > &tasks, const std::string &processName,
+                           const std::vector<std::string> &ownRequirements, const std::vector<std::string> &lentNames,
+                           const std::vector<Pipeline::Stage> &stages, const std::size_t inputCount) {
+    std::unordered_map<std::string, std::size_t> groupsByName;
+    for (const auto &resource: resourcePool) {
+        const auto inserted = groupsByName.emplace(resource->getName(), requirements.size());
+        if (inserted.second) requirements.push_back({resource->getName(), resource->getResourceType()});
+        auto &requirement = requirements[inserted.first->second];
+        ++requirement.resourceCount;
+        requirement.available += resource->getResourceType() == Resource::Type::Consumable
+                                     ? static_cast<const ConsumableResource &>(*resource).getRemainingCapacity()
+                                     : 1;
+    }
+    // Names only the loans carry get a group past the pool's, which no requirement entry describes.
+    const auto poolGroupCount = requirements.size();
+    std::vector<long long> loans(poolGroupCount, 0);
+    for (const auto &name: lentNames) {
+        const auto inserted = groupsByName.emplace(name, loans.size());
+        if (inserted.second) loans.push_back(0);
+        ++loans[inserted.first->second];
+    }
+
+    // Each executable's needs are tallied per group, less what it borrows, into a flat list of (group, units).
+    std::vector<long long> counts(loans.size(), 0);
+    std::vector<std::size_t> touched;
+    std::vector<std::pair<std::size_t, long long> > needs;
+    const auto tally = [&](const std::vector<std::string> &names, const bool lending, std::string &reason) {
+        touched.clear();
+        for (const auto &name: names) {
+            const auto group = groupsByName.find(name);
+            if (group == groupsByName.end() || (group->second >= poolGroupCount && !lending)) {
+                if (reason.empty()) reason = "requires missing resource '" + name + "'";
+                continue;
+            }
+            if (counts[group->second]++ == 0) touched.push_back(group->second);
+        }
+        for (const auto group: touched) {
+            const auto need = counts[group] - (lending ? loans[group] : 0);
+            counts[group] = 0;
+            if (need <= 0 || !reason.empty()) continue;
+            if (group >= poolGroupCount) {
+                const auto &name = *std::find_if(names.begin(), names.end(), [&](const std::string &candidate) {
+                    return groupsByName.at(candidate) == group;
+                });
+                reason = "requires " + std::to_string(need + loans[group]) + " units of '" + name +
+                         "' but the loans have " + std::to_string(loans[group]);
+                continue;
+            }
+            needs.emplace_back(group, need);
+        }
+        return reason.empty();
+    };
+
+    // The process holds its usable resources for its whole run, on top of what any task holds.
+    std::vector<long long> heldByProcess(poolGroupCount, 0);
+    std::string ownReason;
+    if (tally(ownRequirements, false, ownReason)) {
+        for (const auto &[group, need]: needs) {
+            if (requirements[group].type == Resource::Type::Consumable) {
+                requirements[group].demand += need;
+            } else {
+                heldByProcess[group] += need;
+            }
+        }
+    } else {
+        obstacles.push_back({processName, ownReason});
+    }
+    needs.clear();
+
+    std::vector<std::size_t> needOffsets;
+    needOffsets.reserve(tasks.size() + 1);
+    std::vector<std::string> reasons(tasks.size());
+    std::vector<char> runnable(tasks.size(), 0);
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        needOffsets.push_back(needs.size());
+        const auto mark = needs.size();
+        runnable[task] = tally(tasks[task]->getRequiredResourcesNames(), true, reasons[task]);
+        if (!runnable[task]) needs.resize(mark);
+    }
+    needOffsets.push_back(needs.size());
+
+    // A dependency is met once some runnable task carries its name; runnable tasks are found in waves, from
+    // the tasks without unmet dependencies, so cycles and chains leading to obstacles stay unmet.
+    const bool hasDependencies = std::any_of(tasks.begin(), tasks.end(), [](const auto &task) {
+        return !task->getDependencyNames().empty();
+    });
+    if (hasDependencies) {
+        // Task names become dense ids, so the waves below index arrays instead of hashing names.
+        std::unordered_map<std::string, std::size_t> nameIds;
+        nameIds.reserve(tasks.size());
+        std::vector<std::size_t> taskNameIds(tasks.size());
+        for (std::size_t task = 0; task < tasks.size(); ++task) {
+            taskNameIds[task] = nameIds.emplace(tasks[task]->getName(), nameIds.size()).first->second;
+        }
+        const auto unknownName = nameIds.size();
+
+        // Distinct dependency ids of each task, an unknown name standing for a dependency never met, and the
+        // tasks depending on each id, both as flat lists.
+        std::vector<std::size_t> dependencyOffsets{0};
+        std::vector<std::size_t> dependencyIds;
+        std::vector<std::size_t> dependentOffsets(unknownName + 2, 0);
+        dependencyOffsets.reserve(tasks.size() + 1);
+        for (const auto &task: tasks) {
+            const auto first = dependencyIds.size();
+            for (const auto &dependency: task->getDependencyNames()) {
+                const auto id = nameIds.find(dependency);
+                dependencyIds.push_back(id == nameIds.end() ? unknownName : id->second);
+            }
+            std::sort(dependencyIds.begin() + static_cast<std::ptrdiff_t>(first), dependencyIds.end());
+            dependencyIds.erase(std::unique(dependencyIds.begin() + static_cast<std::ptrdiff_t>(first),
+                                            dependencyIds.end()), dependencyIds.end());
+            for (auto offset = first; offset < dependencyIds.size(); ++offset) {
+                ++dependentOffsets[dependencyIds[offset] + 1];
+            }
+            dependencyOffsets.push_back(dependencyIds.size());
+        }
+        for (std::size_t id = 1; id < dependentOffsets.size(); ++id) {
+            dependentOffsets[id] += dependentOffsets[id - 1];
+        }
+        std::vector<std::size_t> dependents(dependencyIds.size());
+        auto fill = dependentOffsets;
+        std::vector<std::size_t> unmetDependencies(tasks.size(), 0);
+        std::vector<std::size_t> ready;
+        for (std::size_t task = 0; task < tasks.size(); ++task) {
+            for (auto offset = dependencyOffsets[task]; offset < dependencyOffsets[task + 1]; ++offset) {
+                dependents[fill[dependencyIds[offset]]++] = task;
+            }
+            unmetDependencies[task] = dependencyOffsets[task + 1] - dependencyOffsets[task];
+            if (runnable[task] && unmetDependencies[task] == 0) ready.push_back(task);
+        }
+
+        std::vector<char> requirementsMet = std::move(runnable);
+        runnable.assign(tasks.size(), 0);
+        std::vector<char> metIds(unknownName + 1, 0);
+        while (!ready.empty()) {
+            const auto task = ready.back();
+            ready.pop_back();
+            runnable[task] = 1;
+            const auto id = taskNameIds[task];
+            if (metIds[id]) continue;
+            metIds[id] = 1;
+            for (auto offset = dependentOffsets[id]; offset < dependentOffsets[id + 1]; ++offset) {
+                const auto dependent = dependents[offset];
+                if (--unmetDependencies[dependent] == 0 && requirementsMet[dependent]) ready.push_back(dependent);
+            }
+        }
+        for (std::size_t task = 0; task < tasks.size(); ++task) {
+            if (runnable[task] || !reasons[task].empty()) continue;
+            for (const auto &dependency: tasks[task]->getDependencyNames()) {
+                const auto id = nameIds.find(dependency);
+                if (id != nameIds.end() && metIds[id->second]) continue;
+                reasons[task] = id != nameIds.end() ? "depends on '" + dependency + "', which can never run"
+                                                    : "depends on unknown task '" + dependency + "'";
+                break;
+            }
+        }
+    }
+
+    std::vector<long long> heldByTask(poolGroupCount, 0);
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        if (!runnable[task]) {
+            obstacles.push_back({tasks[task]->getName(), reasons[task]});
+            continue;
+        }
+        for (auto offset = needOffsets[task]; offset < needOffsets[task + 1]; ++offset) {
+            const auto &[group, need] = needs[offset];
+            if (requirements[group].type == Resource::Type::Consumable) {
+                requirements[group].demand += need;
+            } else {
+                heldByTask[group] = std::max(heldByTask[group], need);
+            }
+        }
+    }
+
+    // Every input runs through every stage, so a stage consumes its consumables once per input; stage workers
+    // wait for usable resources held by other workers, so a stage holds at most one task's worth at once.
+    if (inputCount != 0) {
+        for (const auto &stage: stages) {
+            std::string reason;
+            if (!tally(stage.requiredResourcesNames, true, reason)) {
+                obstacles.push_back({stage.name, reason});
+                needs.clear();
+                continue;
+            }
+            for (const auto &[group, need]: needs) {
+                if (requirements[group].type == Resource::Type::Consumable) {
+                    requirements[group].demand += need * static_cast<long long>(inputCount);
+                } else {
+                    heldByTask[group] = std::max(heldByTask[group], need);
+                }
+            }
+            needs.clear();
+        }
+    }
+
+    // Process::cloneProcess() gives each consumable of a name the same capacity and keeps at least one
+    // resource of every name, so minimums are spread over the name's consumables and never below one.
+    for (std::size_t group = 0; group < poolGroupCount; ++group) {
+        auto &requirement = requirements[group];
+        long long minimum = requirement.demand;
+        if (requirement.type == Resource::Type::Consumable) {
+            const auto count = static_cast<long long>(requirement.resourceCount);
+            minimum = (minimum + count - 1) / count;
+        } else {
+            requirement.demand = heldByProcess[group] + heldByTask[group];
+            minimum = requirement.demand;
+        }
+        requirement.minimum = static_cast<int>(std::clamp(minimum, 1LL, static_cast<long long>(INT_MAX)));
+    }
+}
+
+/**
+ * @brief Retrieves the demand on each resource name of the pool.
+ * @return The requirements, by first appearance of the name in the pool.
+ */
+const std::vector<CapacityPlan::Requirement> &CapacityPlan::getRequirements() const {
+    return requirements;
+}
+
+/**
+ * @brief Retrieves the process, tasks and pipeline stages that cannot run whatever the capacities.
+ * @return The obstacles, the process first, then the tasks and the stages in order.
+ */
+const std::vector<CapacityPlan::Obstacle> &CapacityPlan::getObstacles() const {
+    return obstacles;
+}
+
+/**
+ * @brief Checks whether the pool already meets the demand of every name.
+ * @return True if no name offers fewer units than its demand.
+ */
+bool CapacityPlan::isSufficient() const {
+    return std::all_of(requirements.begin(), requirements.end(), [](const Requirement &requirement) {
+        return requirement.available >= requirement.demand;
+    });
+}
+
+/**
+ * @brief Lists the minimum of every name in the form Process::cloneProcess() takes.
+ * @return Capacity of each consumable and number of usable resources, by resource name.
+ */
+std::map<std::string, int> CapacityPlan::getCapacities() const {
+    std::map<std::string, int> capacities;
+    for (const auto &requirement: requirements) capacities.emplace(requirement.resourceName, requirement.minimum);
+    return capacities;
+}
@@ -0,0 +1,122 @@
+#include "CapacitySweep.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Constructs a sweep without dimensions over a prototype process.
+ * @param prototype Process every variant is cloned from; it must outlive the sweep.
+ */
+CapacitySweep::CapacitySweep(const Process &prototype) : prototype(prototype) {}
+
+/**
+ * @brief Adds a resource to vary.
+ * @param resourceName Name of a resource of the prototype.
+ * @param values Capacities of a consumable, or unit counts of a usable resource.
+ * @throw std::invalid_argument If the list is empty, a value is not positive or the resource is already varied.
+ */
+void CapacitySweep::addDimension(const std::string &resourceName, std::vector<int> values) {
+    if (values.empty()) throw std::invalid_argument("Sweep of resource '" + resourceName + "' needs values");
+    if (std::any_of(values.begin(), values.end(), [](const int value) { return value <= 0; })) {
+        throw std::invalid_argument("Sweep values of resource '" + resourceName + "' must be positive");
+    }
+    if (std::any_of(dimensions.begin(), dimensions.end(), [&resourceName](const Dimension &dimension) {
+        return dimension.resourceName == resourceName;
+    })) {
+        throw std::invalid_argument("Resource '" + resourceName + "' is already swept");
+    }
+    dimensions.push_back({resourceName, std::move(values)});
+}
+
+/**
+ * @brief Retrieves the number of combinations runGrid() runs.
+ * @return The product of the dimensions' value counts.
+ */
+std::size_t CapacitySweep::getGridSize() const {
+    std::size_t size = 1;
+    for (const auto &dimension: dimensions) size *= dimension.values.size();
+    return size;
+}
+
+/**
+ * @brief Runs every combination of the dimensions' values.
+ * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+ * @return The outcome of every variant, the last dimension varying fastest.
+ * @throw std::invalid_argument If a dimension names a resource the prototype does not have.
+ */
+std::vector<CapacitySweep::Result> CapacitySweep::runGrid(const std::size_t threadCount) const {
+    std::vector<std::map<std::string, int> > variants(getGridSize());
+    for (std::size_t variant = 0; variant < variants.size(); ++variant) {
+        // The variant index is a mixed-radix number whose last digit belongs to the last dimension.
+        std::size_t remainder = variant;
+        for (auto dimension = dimensions.rbegin(); dimension != dimensions.rend(); ++dimension) {
+            variants[variant][dimension->resourceName] = dimension->values[remainder % dimension->values.size()];
+            remainder /= dimension->values.size();
+        }
+    }
+    return runVariants(variants, threadCount);
+}
+
+/**
+ * @brief Runs combinations drawn at random, each dimension's value uniformly among its values.
+ * @param sampleCount Number of variants to run.
+ * @param seed Seed of the random generator; equal seeds draw the same variants.
+ * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+ * @return The outcome of every variant, in drawing order.
+ * @throw std::invalid_argument If a dimension names a resource the prototype does not have.
+ */
+std::vector<CapacitySweep::Result> CapacitySweep::runSamples(const std::size_t sampleCount, const std::uint64_t seed,
+                                                             const std::size_t threadCount) const {
+    std::mt19937_64 engine(seed);
+    std::vector<std::map<std::string, int> > variants(sampleCount);
+    for (auto &variant: variants) {
+        for (const auto &dimension: dimensions) {
+            std::uniform_int_distribution<std::size_t> pick(0, dimension.values.size() - 1);
+            variant[dimension.resourceName] = dimension.values[pick(engine)];
+        }
+    }
+    return runVariants(variants, threadCount);
+}
+
+/**
+ * @brief Runs variants on worker threads.
+ * @param variants Capacities of every variant.
+ * @param threadCount Number of worker threads; 0 uses one per hardware thread.
+ * @return The outcome of every variant, in the order of variants.
+ */
+std::vector<CapacitySweep::Result> CapacitySweep::runVariants(const std::vector<std::map<std::string, int> > &variants,
+                                                              std::size_t threadCount) const {
+    if (threadCount == 0) threadCount = std::max(1U, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<std::size_t>(variants.size(), 1));
+    std::vector<Result> results(variants.size());
+    std::atomic<std::size_t> nextVariant{0};
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+    const auto work = [&] {
+        for (auto variant = nextVariant.fetch_add(1); variant < variants.size(); variant = nextVariant.fetch_add(1)) {
+            try {
+                auto process = prototype.cloneProcess(variants[variant]);
+                process->setScheduling(Process::Scheduling::EventDriven);
+                process->run();
+                auto &result = results[variant];
+                result.capacities = variants[variant];
+                result.started = process->getLastSimulation().has_value();
+                if (result.started) result.report = *process->getLastSimulation();
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) failure = std::current_exception();
+                nextVariant = variants.size();
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 1; worker < threadCount; ++worker) workers.emplace_back(work);
+    work();
+    for (auto &worker: workers) worker.join();
+    if (failure) std::rethrow_exception(failure);
+    return results;
+}
@@ -0,0 +1,259 @@
+#include "CommandLineOptions.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Parses a positive integer option value.
+     * @param option The option the value belongs to.
+     * @param value The value to parse.
+     * @return The parsed value.
+     * @throw std::invalid_argument If the value is not a positive integer.
+     */
+    int parsePositiveValue(const std::string &option, const std::string &value) {
+        std::size_t consumed = 0;
+        int parsed = 0;
+        try {
+            parsed = std::stoi(value, &consumed);
+        } catch (const std::exception &) {
+            consumed = 0;
+        }
+        if (consumed != value.size() || parsed <= 0) {
+            throw std::invalid_argument("Option '" + option + "' expects a positive integer, got '" + value + "'");
+        }
+        return parsed;
+    }
+
+    /**
+     * @brief Parses a sweep dimension of the form NAME=V1,V2,...
+     * @param option The option the value belongs to.
+     * @param value The value to parse.
+     * @return The dimension.
+     * @throw std::invalid_argument If the name is missing or a value is not a positive integer.
+     */
+    CapacitySweep::Dimension parseSweepDimension(const std::string &option, const std::string &value) {
+        const auto separator = value.find('=');
+        if (separator == 0 || separator == std::string::npos || separator + 1 == value.size()) {
+            throw std::invalid_argument("Option '" + option + "' expects NAME=V1,V2,..., got '" + value + "'");
+        }
+        CapacitySweep::Dimension dimension{value.substr(0, separator), {}};
+        std::size_t start = separator + 1;
+        while (start <= value.size()) {
+            const auto end = std::min(value.find(',', start), value.size());
+            dimension.values.push_back(parsePositiveValue(option, value.substr(start, end - start)));
+            start = end + 1;
+        }
+        return dimension;
+    }
+
+    /**
+     * @brief Parses an output mode name.
+     * @param value The mode name (verbose, quiet or json).
+     * @return The matching output mode.
+     * @throw std::invalid_argument If the name is not a known mode.
+     */
+    CommandLineOptions::OutputMode parseOutputMode(const std::string &value) {
+        if (value == "verbose") return CommandLineOptions::OutputMode::Verbose;
+        if (value == "quiet") return CommandLineOptions::OutputMode::Quiet;
+        if (value == "json") return CommandLineOptions::OutputMode::Json;
+        throw std::invalid_argument("Unknown output mode '" + value + "' (expected verbose, quiet or json)");
+    }
+
+    /**
+     * @brief Parses a requirement matching mode name.
+     * @param value The mode name (names or bitmask).
+     * @return The matching mode.
+     * @throw std::invalid_argument If the name is not a known mode.
+     */
+    Process::RequirementMatching parseRequirementMatching(const std::string &value) {
+        if (value == "names") return Process::RequirementMatching::NameScan;
+        if (value == "bitmask") return Process::RequirementMatching::Bitmask;
+        throw std::invalid_argument("Unknown matching mode '" + value + "' (expected names or bitmask)");
+    }
+
+    /**
+     * @brief Parses a scheduling mode name.
+     * @param value The mode name (sequential or event).
+     * @return The scheduling mode.
+     * @throw std::invalid_argument If the name is not a known mode.
+     */
+    Process::Scheduling parseScheduling(const std::string &value) {
+        if (value == "sequential") return Process::Scheduling::Sequential;
+        if (value == "event") return Process::Scheduling::EventDriven;
+        throw std::invalid_argument("Unknown scheduling mode '" + value + "' (expected sequential or event)");
+    }
+
+    /**
+     * @brief Parses an admission policy name.
+     * @param value The policy name (first-come, ffd, best-fit, drf, backfill or heft).
+     * @return The admission policy.
+     * @throw std::invalid_argument If the name is not a known policy.
+     */
+    EventDrivenScheduler::Admission parseAdmission(const std::string &value) {
+        if (value == "first-come") return EventDrivenScheduler::Admission::FirstCome;
+        if (value == "ffd") return EventDrivenScheduler::Admission::FirstFitDecreasing;
+        if (value == "best-fit") return EventDrivenScheduler::Admission::BestFit;
+        if (value == "drf") return EventDrivenScheduler::Admission::DominantResource;
+        if (value == "backfill") return EventDrivenScheduler::Admission::Backfill;
+        if (value == "heft") return EventDrivenScheduler::Admission::EarliestFinish;
+        throw std::invalid_argument("Unknown admission policy '" + value +
+                                    "' (expected first-come, ffd, best-fit, drf, backfill or heft)");
+    }
+
+    /**
+     * @brief Parses a fair-share policy name.
+     * @param value The policy name (first-come or drf).
+     * @return The fair-share policy.
+     * @throw std::invalid_argument If the name is not a known policy.
+     */
+    FairShareScheduler::Policy parseFairShare(const std::string &value) {
+        if (value == "first-come") return FairShareScheduler::Policy::FirstCome;
+        if (value == "drf") return FairShareScheduler::Policy::DominantResource;
+        throw std::invalid_argument("Unknown fair-share policy '" + value + "' (expected first-come or drf)");
+    }
+
+    /**
+     * @brief Parses a resource delegation mode name.
+     * @param value The mode name (none, usable or all).
+     * @return The delegation mode.
+     * @throw std::invalid_argument If the name is not a known mode.
+     */
+    Process::ResourceDelegation parseDelegation(const std::string &value) {
+        if (value == "none") return Process::ResourceDelegation::None;
+        if (value == "usable") return Process::ResourceDelegation::Usable;
+        if (value == "all") return Process::ResourceDelegation::All;
+        throw std::invalid_argument("Unknown delegation mode '" + value + "' (expected none, usable or all)");
+    }
+}
+
+/**
+ * @brief Parses the program arguments.
+ * @param argc Number of arguments, including the program name.
+ * @param argv Argument values, including the program name.
+ * @return The parsed options.
+ * @throw std::invalid_argument If an option is unknown, lacks its value or has an invalid value, or if a
+ * task stream is combined with several scenarios, repetitions or threads, or with a sweep, or if capacity
+ * planning is combined with a task stream or a sweep, or if fair sharing is combined with either or with
+ * capacity planning.
+ */
+CommandLineOptions CommandLineOptions::parse(const int argc, const char *const argv[]) {
+    CommandLineOptions options;
+    for (int index = 1; index < argc; ++index) {
+        const std::string argument = argv[index];
+        const auto nextValue = [&]() -> std::string {
+            if (index + 1 >= argc) throw std::invalid_argument("Option '" + argument + "' requires a value");
+            return argv[++index];
+        };
+
+        if (argument == "-h" || argument == "--help") {
+            options.showHelp = true;
+        } else if (argument == "-s" || argument == "--scenario") {
+            options.scenarioFiles.push_back(nextValue());
+        } else if (argument == "-r" || argument == "--repeat") {
+            options.repeatCount = parsePositiveValue(argument, nextValue());
+        } else if (argument == "-t" || argument == "--threads") {
+            options.threadCount = parsePositiveValue(argument, nextValue());
+        } else if (argument == "-m" || argument == "--mode") {
+            options.outputMode = parseOutputMode(nextValue());
+        } else if (argument == "--matching") {
+            options.requirementMatching = parseRequirementMatching(nextValue());
+        } else if (argument == "--scheduling") {
+            options.scheduling = parseScheduling(nextValue());
+        } else if (argument == "--admission") {
+            options.admission = parseAdmission(nextValue());
+        } else if (argument == "--reference-ghz") {
+            options.referenceCapacity = parsePositiveValue(argument, nextValue());
+        } else if (argument == "--delegation") {
+            options.delegation = parseDelegation(nextValue());
+        } else if (argument == "--metrics") {
+            options.metricsFile = nextValue();
+        } else if (argument == "--trace") {
+            options.traceFile = nextValue();
+        } else if (argument == "--stream") {
+            options.streamFile = nextValue();
+        } else if (argument == "--queue") {
+            options.queueCapacity = parsePositiveValue(argument, nextValue());
+        } else if (argument == "--cache") {
+            options.cacheFile = nextValue();
+        } else if (argument == "--changed") {
+            options.changedInputs.push_back(nextValue());
+        } else if (argument == "--sweep") {
+            options.sweepDimensions.push_back(parseSweepDimension(argument, nextValue()));
+        } else if (argument == "--min-capacity") {
+            options.planCapacities = true;
+        } else if (argument == "--fair-share") {
+            options.fairShare = parseFairShare(nextValue());
+        } else if (argument == "-q" || argument == "--quiet") {
+            options.outputMode = OutputMode::Quiet;
+        } else if (argument == "--json") {
+            options.outputMode = OutputMode::Json;
+        } else if (!argument.empty() && argument[0] == '-') {
+            throw std::invalid_argument("Unknown option '" + argument + "'");
+        } else {
+            options.scenarioFiles.push_back(argument);
+        }
+    }
+    if (!options.streamFile.empty() &&
+        (options.scenarioFiles.size() > 1 || options.repeatCount > 1 || options.threadCount > 1)) {
+        throw std::invalid_argument("Option '--stream' runs a single scenario once on one thread");
+    }
+    if (!options.streamFile.empty() && !options.sweepDimensions.empty()) {
+        throw std::invalid_argument("Options '--stream' and '--sweep' cannot be combined");
+    }
+    if (options.planCapacities && (!options.streamFile.empty() || !options.sweepDimensions.empty())) {
+        throw std::invalid_argument("Option '--min-capacity' cannot be combined with '--stream' or '--sweep'");
+    }
+    if (options.fairShare && (!options.streamFile.empty() || !options.sweepDimensions.empty() ||
+                              options.planCapacities)) {
+        throw std::invalid_argument("Option '--fair-share' cannot be combined with '--stream', '--sweep' or "
+                                    "'--min-capacity'");
+    }
+    return options;
+}
+
+/**
+ * @brief Builds the usage text of the driver.
+ * @param programName Name the program was invoked with.
+ * @return The multi-line usage text.
+ */
+std::string CommandLineOptions::usage(const std::string &programName) {
+    return "Usage: " + programName + " [options] [scenario-file...]\n"
+           "\n"
+           "Runs the given scenario files, or the built-in compilation scenario when none is given.\n"
+           "\n"
+           "Options:\n"
+           "  -s, --scenario FILE   Add a scenario file to run\n"
+           "  -r, --repeat N        Load and run every scenario N times (default 1)\n"
+           "  -t, --threads N       Share the repetitions among N worker threads (default 1)\n"
+           "  -m, --mode MODE       Output mode: verbose, quiet or json (default verbose)\n"
+           "  -q, --quiet           Same as --mode quiet\n"
+           "      --json            Same as --mode json\n"
+           "      --matching MODE   Resource matching: names or bitmask (default names)\n"
+           "      --scheduling MODE Task scheduling: sequential or event (default sequential)\n"
+           "      --admission MODE  Tasks event-driven runs start together: first-come, or packed by\n"
+           "                        ffd, best-fit or drf (dominant resource), or backfill (EASY backfilling\n"
+           "                        on task durations), or heft (ranked tasks on the processors that finish\n"
+           "                        them earliest) (default first-come)\n"
+           "      --reference-ghz N Event-driven durations are measured on an N GHz processor and scale with\n"
+           "                        the capacity of the slowest usable resource a task holds\n"
+           "      --delegation MODE Resources processes lend to their tasks: none, usable or all (default usable)\n"
+           "      --metrics FILE    Write per-task and per-resource metrics as JSON to FILE\n"
+           "      --trace FILE      Write a Chrome trace (chrome://tracing, Perfetto) of all runs to FILE\n"
+           "      --stream FILE     Run the first process as a service executing the task lines of FILE\n"
+           "                        (- for standard input), reporting throughput every second\n"
+           "      --queue N         Streamed tasks buffered ahead of the service (default 1024)\n"
+           "      --cache FILE      Skip tasks that completed unchanged in runs sharing FILE, then update it\n"
+           "      --changed NAME    After each process run, rerun the tasks affected by a change to the\n"
+           "                        artifact NAME (repeatable)\n"
+           "      --sweep NAME=V1,V2,...\n"
+           "                        Instead of running, simulate every process with each combination of the\n"
+           "                        capacities (consumables) or unit counts (usable resources) of the swept\n"
+           "                        resources and print makespans and skips (repeatable; workers set by --threads,\n"
+           "                        one per hardware thread by default)\n"
+           "      --min-capacity    Instead of running, print the smallest capacities (consumables) and unit\n"
+           "                        counts (usable resources) with which every process runs all its tasks\n"
+           "      --fair-share MODE Instead of running, simulate the processes of each scenario together on its\n"
+           "                        shared resources, choosing whose task starts first-come or by weighted\n"
+           "                        dominant resource fairness (drf), and print per-process throughput and latency\n"
+           "  -h, --help            Show this help\n";
+}
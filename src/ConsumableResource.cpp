@@ -25,25 +25,36 @@ bool ConsumableResource::isAvailableForUse() const {
 
 /**
  * @brief Allocates one unit of the resource, reducing its remaining capacity.
+ *
+ * Safe to call from several threads at once; only the allocation that takes the last unit updates the
+ * availability.
+ *
  * @throw std::runtime_error If no capacity remains to allocate.
  */
 void ConsumableResource::allocate() {
-    if (remainingCapacity <= 0) {
-        throw std::runtime_error("No remaining capacity for consumable resource '" + name + "'");
-    }
-    remainingCapacity--;
-    isAvailable = (remainingCapacity > 0);
+    int remaining = remainingCapacity.load();
+    do {
+        if (remaining <= 0) {
+            throw std::runtime_error("No remaining capacity for consumable resource '" + name + "'");
+        }
+    } while (!remainingCapacity.compare_exchange_weak(remaining, remaining - 1));
+    if (remaining == 1) setAvailability(false);
 }
 
 /**
  * @brief Releases the resource, updating availability status.
+ *
+ * The first release after the resource is depleted warns on std::cerr; later ones stay silent until a
+ * replenishment or restoreState() restores capacity.
+ *
  * @note Does not restore capacity; external replenishment is required.
  */
 void ConsumableResource::release() {
-    if (remainingCapacity == 0 && !isAvailable) {
+    if (remainingCapacity == 0 && !isAvailable && !depletionReported) {
+        depletionReported = true;
         std::cerr << "Warning: Consumable resource '" << name << "' is depleted and cannot be reused without replenishment\n";
     }
-    isAvailable = (remainingCapacity > 0);
+    setAvailability(remainingCapacity > 0);
 }
 
 /**
@@ -59,4 +70,60 @@ void ConsumableResource::use() const {
  */
 int ConsumableResource::getRemainingCapacity() const {
     return remainingCapacity;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Restores capacity, up to the total capacity of the resource.
+ * @param units The number of units to restore.
+ * @throw std::invalid_argument If units is not positive.
+ */
+void ConsumableResource::replenish(const int units) {
+    if (units <= 0) {
+        throw std::invalid_argument("Replenishment of resource '" + name + "' must be positive");
+    }
+    remainingCapacity = units >= totalCapacity - remainingCapacity ? totalCapacity : remainingCapacity + units;
+    depletionReported = false;
+    setAvailability(remainingCapacity > 0);
+}
+
+/**
+ * @brief Captures the availability and remaining capacity of the resource.
+ * @return The state, to be passed back to restoreState().
+ */
+Resource::State ConsumableResource::saveState() const {
+    return State{isAvailable, remainingCapacity};
+}
+
+/**
+ * @brief Puts back the availability and remaining capacity captured by saveState().
+ * @param state The state to restore.
+ * @throw std::invalid_argument If the remaining capacity is negative or above the total capacity.
+ */
+void ConsumableResource::restoreState(const State &state) {
+    if (state.units < 0 || state.units > totalCapacity) {
+        throw std::invalid_argument("Cannot restore " + std::to_string(state.units) + " units of resource '" + name + "'");
+    }
+    remainingCapacity = state.units;
+    depletionReported = false;
+    setAvailability(state.available);
+}
+
+/**
+ * @brief Creates an independent copy of the resource in its current state, without its listeners.
+ * @return The copy.
+ */
+std::unique_ptr<Resource> ConsumableResource::clone() const {
+    auto copy = cloneWithCapacity(totalCapacity);
+    copy->restoreState(saveState());
+    return copy;
+}
+
+/**
+ * @brief Creates a resource of the same kind and name with another capacity, fully available.
+ * @param capacity Total capacity of the new resource.
+ * @return The new resource.
+ * @throw std::invalid_argument If the capacity is not positive.
+ */
+std::unique_ptr<ConsumableResource> ConsumableResource::cloneWithCapacity(const int capacity) const {
+    return std::make_unique<ConsumableResource>(name, capacity);
+}
@@ -0,0 +1,202 @@
+#include "EligibilityKernel.h"
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ELIGIBILITY_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    /**
+     * @brief Portable kernel: checks one task per iteration.
+     * @param masks The requirement masks of the tasks.
+     * @param begin Position of the first task to evaluate.
+     * @param freeMask The groups currently available.
+     * @param wordCount Number of mask words to check.
+     * @param ready Receives the positions of the satisfied tasks.
+     */
+    void selectReadyScalar(const EligibilityKernel::MaskTable &masks, const std::size_t begin,
+                           const ResourceIndex::Mask &freeMask, const std::size_t wordCount,
+                           std::vector<std::size_t> &ready) {
+        for (std::size_t index = begin; index < masks.size(); ++index) {
+            if (masks.isSatisfied(index, freeMask, wordCount)) ready.push_back(index);
+        }
+    }
+
+#ifdef ELIGIBILITY_KERNEL_X86
+    /**
+     * @brief SSE2 kernel: checks two tasks per instruction.
+     * @param masks The requirement masks of the tasks.
+     * @param begin Position of the first task to evaluate.
+     * @param freeMask The groups currently available.
+     * @param wordCount Number of mask words to check.
+     * @param ready Receives the positions of the satisfied tasks.
+     */
+    __attribute__((target("sse2")))
+    void selectReadySse2(const EligibilityKernel::MaskTable &masks, const std::size_t begin,
+                         const ResourceIndex::Mask &freeMask, const std::size_t wordCount,
+                         std::vector<std::size_t> &ready) {
+        __m128i freeWords[ResourceIndex::WordCount];
+        for (std::size_t word = 0; word < wordCount; ++word) {
+            freeWords[word] = _mm_set1_epi64x(static_cast<long long>(freeMask.words[word]));
+        }
+        const __m128i zero = _mm_setzero_si128();
+        std::size_t index = begin;
+        for (; index + 2 <= masks.size(); index += 2) {
+            __m128i missing = zero;
+            for (std::size_t word = 0; word < wordCount; ++word) {
+                const __m128i required = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(masks.wordData(word) + index));
+                missing = _mm_or_si128(missing, _mm_andnot_si128(freeWords[word], required));
+            }
+            // SSE2 has no 64-bit compare: a lane is zero when both of its 32-bit halves are.
+            const __m128i halves = _mm_cmpeq_epi32(missing, zero);
+            const __m128i lanes = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+            const int satisfied = _mm_movemask_pd(_mm_castsi128_pd(lanes));
+            if (satisfied & 1) ready.push_back(index);
+            if (satisfied & 2) ready.push_back(index + 1);
+        }
+        for (; index < masks.size(); ++index) {
+            if (masks.isSatisfied(index, freeMask, wordCount)) ready.push_back(index);
+        }
+    }
+
+    /**
+     * @brief AVX2 kernel: checks four tasks per instruction.
+     * @param masks The requirement masks of the tasks.
+     * @param begin Position of the first task to evaluate.
+     * @param freeMask The groups currently available.
+     * @param wordCount Number of mask words to check.
+     * @param ready Receives the positions of the satisfied tasks.
+     */
+    __attribute__((target("avx2")))
+    void selectReadyAvx2(const EligibilityKernel::MaskTable &masks, const std::size_t begin,
+                         const ResourceIndex::Mask &freeMask, const std::size_t wordCount,
+                         std::vector<std::size_t> &ready) {
+        __m256i freeWords[ResourceIndex::WordCount];
+        for (std::size_t word = 0; word < wordCount; ++word) {
+            freeWords[word] = _mm256_set1_epi64x(static_cast<long long>(freeMask.words[word]));
+        }
+        const __m256i zero = _mm256_setzero_si256();
+        std::size_t index = begin;
+        for (; index + 4 <= masks.size(); index += 4) {
+            __m256i missing = zero;
+            for (std::size_t word = 0; word < wordCount; ++word) {
+                const __m256i required = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(masks.wordData(word) + index));
+                missing = _mm256_or_si256(missing, _mm256_andnot_si256(freeWords[word], required));
+            }
+            auto satisfied = static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(missing, zero))));
+            for (; satisfied != 0; satisfied &= satisfied - 1) {
+                ready.push_back(index + static_cast<std::size_t>(__builtin_ctz(satisfied)));
+            }
+        }
+        for (; index < masks.size(); ++index) {
+            if (masks.isSatisfied(index, freeMask, wordCount)) ready.push_back(index);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Appends the mask of the next task.
+ * @param mask The requirement mask.
+ */
+void EligibilityKernel::MaskTable::push_back(const ResourceIndex::Mask &mask) {
+    for (std::size_t word = 0; word < words.size(); ++word) words[word].push_back(mask.words[word]);
+}
+
+/**
+ * @brief Replaces the mask of a task.
+ * @param index Position of the task.
+ * @param mask The requirement mask.
+ */
+void EligibilityKernel::MaskTable::assign(const std::size_t index, const ResourceIndex::Mask &mask) {
+    for (std::size_t word = 0; word < words.size(); ++word) words[word][index] = mask.words[word];
+}
+
+/**
+ * @brief Resizes the table, giving new tasks an empty mask.
+ * @param count The number of tasks.
+ */
+void EligibilityKernel::MaskTable::resize(const std::size_t count) {
+    for (auto &column: words) column.resize(count);
+}
+
+/**
+ * @brief Removes all masks.
+ */
+void EligibilityKernel::MaskTable::clear() {
+    for (auto &column: words) {
+        column.clear();
+        column.shrink_to_fit();
+    }
+}
+
+/**
+ * @brief Checks a single task's mask against a free mask.
+ * @param index Position of the task.
+ * @param freeMask The groups currently available.
+ * @param wordCount Number of leading mask words that can hold set bits.
+ * @return True if every required group is free.
+ */
+bool EligibilityKernel::MaskTable::isSatisfied(const std::size_t index, const ResourceIndex::Mask &freeMask,
+                                               const std::size_t wordCount) const {
+    std::uint64_t missing = 0;
+    for (std::size_t word = 0; word < wordCount; ++word) missing |= words[word][index] & ~freeMask.words[word];
+    return missing == 0;
+}
+
+/**
+ * @brief Retrieves the widest instruction set supported by the processor and the build.
+ * @return The instruction set selectReady() uses by default.
+ */
+EligibilityKernel::InstructionSet EligibilityKernel::supportedInstructionSet() {
+#ifdef ELIGIBILITY_KERNEL_X86
+    static const InstructionSet supported = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return InstructionSet::Avx2;
+        if (__builtin_cpu_supports("sse2")) return InstructionSet::Sse2;
+        return InstructionSet::Scalar;
+    }();
+    return supported;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+/**
+ * @brief Collects the tasks whose requirements are all satisfied by a free mask.
+ * @param masks The requirement masks of the tasks.
+ * @param begin Position of the first task to evaluate.
+ * @param freeMask The groups currently available.
+ * @param wordCount Number of leading mask words that can hold set bits (at most ResourceIndex::WordCount).
+ * @param ready Receives the positions of the satisfied tasks from begin onwards, in increasing order.
+ * @param instructionSet The instruction set to run on.
+ * @throw std::invalid_argument If the instruction set is not supported or wordCount is too large.
+ */
+void EligibilityKernel::selectReady(const MaskTable &masks, const std::size_t begin,
+                                    const ResourceIndex::Mask &freeMask, const std::size_t wordCount,
+                                    std::vector<std::size_t> &ready, const InstructionSet instructionSet) {
+    if (wordCount > ResourceIndex::WordCount) {
+        throw std::invalid_argument("Masks have at most " + std::to_string(ResourceIndex::WordCount) + " words");
+    }
+    if (instructionSet > supportedInstructionSet()) {
+        throw std::invalid_argument("Instruction set not supported by this processor");
+    }
+    ready.clear();
+    switch (instructionSet) {
+#ifdef ELIGIBILITY_KERNEL_X86
+        case InstructionSet::Avx2:
+            selectReadyAvx2(masks, begin, freeMask, wordCount, ready);
+            return;
+        case InstructionSet::Sse2:
+            selectReadySse2(masks, begin, freeMask, wordCount, ready);
+            return;
+#endif
+        default:
+            selectReadyScalar(masks, begin, freeMask, wordCount, ready);
+    }
+}
@@ -0,0 +1,691 @@
+#include "EventDrivenScheduler.h"
+#include "ConsumableResource.h"
+#include "UsableResource.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    /**
+     * @brief Retrieves the capacity of a usable resource.
+     * @param resource The resource.
+     * @return Its capacity, or zero if it is not a usable resource.
+     */
+    int capacityOf(const Resource &resource) {
+        if (resource.getResourceType() != Resource::Type::Usable) return 0;
+        return static_cast<const UsableResource &>(resource).getCapacity();
+    }
+
+    /**
+     * @brief Orders events so that the earliest, then first scheduled, is at the top of a heap.
+     * @param left An event.
+     * @param right Another event.
+     * @return True if left is due after right.
+     */
+    template<typename Event>
+    bool isLater(const Event &left, const Event &right) {
+        return left.time != right.time ? left.time > right.time : left.sequence > right.sequence;
+    }
+}
+
+/**
+ * @brief Prepares a simulation and starts observing the pool's availability.
+ * @param resourcePool Resources the tasks compete for; they must outlive the scheduler.
+ * @param tasks Tasks to simulate.
+ * @param replenishments Refills applied during the simulation.
+ * @param admission Which ready tasks start when they compete for resources.
+ * @param referenceCapacity Capacity durations are measured on; zero leaves durations unscaled.
+ */
+EventDrivenScheduler::EventDrivenScheduler(const std::vector<std::unique_ptr<Resource> > &resourcePool,
+                                           const std::vector<std::unique_ptr<Executable> > &tasks,
+                                           const std::vector<Replenishment> &replenishments,
+                                           const Admission admission, const int referenceCapacity)
+    : resourcePool(resourcePool), tasks(tasks), replenishments(replenishments), admission(admission),
+      referenceCapacity(referenceCapacity), states(tasks.size(), TaskState::Blocked) {
+    std::unordered_map<std::string, std::size_t> groupsByName;
+    const auto groupOf = [&](const std::string &name) {
+        const auto inserted = groupsByName.emplace(name, groupsByName.size());
+        if (inserted.second) {
+            availableCounts.push_back(0);
+            consumables.emplace_back();
+            groupUnits.push_back(0);
+            placementOrder.emplace_back();
+        }
+        return inserted.first->second;
+    };
+    for (const auto &resource: resourcePool) {
+        const auto group = groupOf(resource->getName());
+        poolGroups.push_back(group);
+        resource->addAvailabilityListener(this, group);
+        placementOrder[group].push_back(resource.get());
+        if (resource->getResourceType() == Resource::Type::Consumable) {
+            const auto &consumable = static_cast<const ConsumableResource &>(*resource);
+            consumables[group].push_back(&consumable);
+            groupUnits[group] += consumable.getRemainingCapacity();
+        } else if (resource->isAvailableForUse()) {
+            ++groupUnits[group];
+            ++usableUnits;
+        }
+        if (resource->isAvailableForUse()) ++availableCounts[group];
+    }
+
+    // Requirements are kept as a flat list of groups per task; a name no resource carries gets a group
+    // that never becomes available. Borrowed requirements are left out, as the task never waits for them.
+    requirementOffsets.reserve(tasks.size() + 1);
+    for (const auto &task: tasks) {
+        requirementOffsets.push_back(requirementGroups.size());
+        const auto &names = task->getRequiredResourcesNames();
+        for (std::size_t requirement = 0; requirement < names.size(); ++requirement) {
+            if (!task->isBorrowed(requirement)) requirementGroups.push_back(groupOf(names[requirement]));
+        }
+    }
+    requirementOffsets.push_back(requirementGroups.size());
+    waiters.resize(availableCounts.size());
+
+    // Demands count the units of each distinct group a task requires; the packing admissions size tasks by
+    // their demands relative to the units each group offered at the start.
+    std::vector<int> counts(availableCounts.size(), 0);
+    demandOffsets.reserve(tasks.size() + 1);
+    if (admission != Admission::FirstCome) admissionKeys.assign(tasks.size(), 0.0);
+    unattainable.assign(tasks.size(), 0);
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        demandOffsets.push_back(demands.size());
+        for (auto offset = requirementOffsets[task]; offset < requirementOffsets[task + 1]; ++offset) {
+            if (counts[requirementGroups[offset]]++ == 0) demands.emplace_back(requirementGroups[offset], 0);
+        }
+        double total = 0;
+        double dominant = 0;
+        for (auto offset = demandOffsets[task]; offset < demands.size(); ++offset) {
+            auto &[group, units] = demands[offset];
+            units = counts[group];
+            counts[group] = 0;
+            const auto share = groupUnits[group] > 0 ? units / groupUnits[group] : 1.0;
+            if (consumables[group].empty() && units > groupUnits[group]) unattainable[task] = 1;
+            total += share;
+            dominant = std::max(dominant, share);
+        }
+        if (admission == Admission::FirstFitDecreasing) admissionKeys[task] = total;
+        if (admission == Admission::DominantResource) admissionKeys[task] = dominant;
+    }
+    demandOffsets.push_back(demands.size());
+    if (admission == Admission::EarliestFinish) rankByEarliestFinish();
+    if (admission == Admission::BestFit) {
+        // Tasks requiring the same units of the same groups share a demand class, whatever their order.
+        std::map<std::vector<std::pair<std::size_t, int> >, std::size_t> classes;
+        demandClasses.reserve(tasks.size());
+        for (std::size_t task = 0; task < tasks.size(); ++task) {
+            std::vector<std::pair<std::size_t, int> > demand(demands.begin() + demandOffsets[task],
+                                                             demands.begin() + demandOffsets[task + 1]);
+            std::sort(demand.begin(), demand.end());
+            demandClasses.push_back(classes.emplace(std::move(demand), classes.size()).first->second);
+        }
+        readyByClass.resize(classes.size());
+    }
+}
+
+/**
+ * @brief Orders the resources of each group fastest first and sets each task's key to its upward rank.
+ */
+void EventDrivenScheduler::rankByEarliestFinish() {
+    std::vector<double> meanCapacities(placementOrder.size(), 0.0);
+    for (std::size_t group = 0; group < placementOrder.size(); ++group) {
+        auto &order = placementOrder[group];
+        std::stable_sort(order.begin(), order.end(), [](const Resource *left, const Resource *right) {
+            return capacityOf(*left) > capacityOf(*right);
+        });
+        double total = 0;
+        for (const auto *resource: order) total += capacityOf(*resource);
+        if (!order.empty()) meanCapacities[group] = total / static_cast<double>(order.size());
+    }
+
+    // A task's expected duration is its duration at the mean pace of the slowest group it requires; ranks add
+    // up along the dependencies, from the last tasks of the graph back to the first.
+    std::unordered_map<std::string, std::vector<std::size_t> > carriers;
+    for (std::size_t task = 0; task < tasks.size(); ++task) carriers[tasks[task]->getName()].push_back(task);
+    std::vector<std::vector<std::size_t> > successors(tasks.size());
+    std::vector<std::size_t> predecessorCounts(tasks.size(), 0);
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        auto names = tasks[task]->getDependencyNames();
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (const auto &name: names) {
+            const auto carrier = carriers.find(name);
+            if (carrier == carriers.end()) continue;
+            for (const auto predecessor: carrier->second) successors[predecessor].push_back(task);
+            predecessorCounts[task] += carrier->second.size();
+        }
+        double pace = 0;
+        for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+            const auto capacity = meanCapacities[demands[offset].first];
+            if (capacity > 0 && (pace == 0 || capacity < pace)) pace = capacity;
+        }
+        const auto duration = static_cast<std::int64_t>(tasks[task]->getDurationInUnits());
+        admissionKeys[task] = static_cast<double>(pace > 0 ? scaleDuration(duration, pace) : duration);
+    }
+    std::vector<std::size_t> order;
+    order.reserve(tasks.size());
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        if (predecessorCounts[task] == 0) order.push_back(task);
+    }
+    for (std::size_t next = 0; next < order.size(); ++next) {
+        for (const auto successor: successors[order[next]]) {
+            if (--predecessorCounts[successor] == 0) order.push_back(successor);
+        }
+    }
+    // Tasks on a dependency cycle never become ready, so they keep their expected duration as their rank.
+    for (auto task = order.rbegin(); task != order.rend(); ++task) {
+        double longest = 0;
+        for (const auto successor: successors[*task]) longest = std::max(longest, admissionKeys[successor]);
+        admissionKeys[*task] += longest;
+    }
+}
+
+/**
+ * @brief Stops observing the pool.
+ */
+EventDrivenScheduler::~EventDrivenScheduler() {
+    for (const auto &resource: resourcePool) resource->removeAvailabilityListener(this);
+}
+
+/**
+ * @brief Adds an event to the pending events.
+ * @param time Simulated time of the event.
+ * @param replenishment True for a replenishment, false for a task completion.
+ * @param index Position of the completing task or of the replenishment.
+ */
+void EventDrivenScheduler::schedule(const std::int64_t time, const bool replenishment, const std::size_t index) {
+    events.push_back(Event{time, nextSequence++, replenishment, index});
+    std::push_heap(events.begin(), events.end(), isLater<Event>);
+}
+
+/**
+ * @brief Starts a task if all its required groups have enough free units, or queues it on the first short one.
+ * @param task Position of the task.
+ * @param time Current simulated time.
+ * @param report Report receiving failures.
+ */
+void EventDrivenScheduler::evaluate(const std::size_t task, const std::int64_t time, Report &report) {
+    const auto shortage = findShortage(task);
+    if (shortage != NoGroup) {
+        // A task needing more usable units than its group ever offers would hold back every waiter behind it.
+        if (!unattainable[task]) waiters[shortage].push_back(task);
+        states[task] = TaskState::Waiting;
+        return;
+    }
+    start(task, time, report);
+}
+
+/**
+ * @brief Assigns a task's resources and schedules its completion, or records its failure.
+ * @param task Position of the task.
+ * @param time Current simulated time.
+ * @param report Report receiving failures.
+ */
+void EventDrivenScheduler::start(const std::size_t task, const std::int64_t time, Report &report) {
+    const auto &executable = tasks[task];
+    try {
+        if (admission == Admission::EarliestFinish) {
+            // Each requirement takes the first free resource of its group, which lists the fastest first.
+            placements.clear();
+            auto offset = requirementOffsets[task];
+            for (std::size_t requirement = 0; requirement < executable->getRequiredResourcesNames().size();
+                 ++requirement) {
+                placements.push_back(executable->isBorrowed(requirement)
+                                         ? nullptr
+                                         : &placementOrder[requirementGroups[offset++]]);
+            }
+            executable->assignResources(placements);
+        } else {
+            executable->assignResources(resourcePool);
+        }
+        std::int64_t duration = executable->getDurationInUnits();
+        if (referenceCapacity > 0) {
+            int slowest = 0;
+            for (const auto *resource: executable->getAssignedResources()) {
+                const auto capacity = capacityOf(*resource);
+                if (capacity > 0 && (slowest == 0 || capacity < slowest)) slowest = capacity;
+            }
+            if (slowest > 0) duration = scaleDuration(duration, slowest);
+        }
+        std::cout << "  [t=" << time << "] ";
+        executable->execute();
+        states[task] = TaskState::Running;
+        schedule(time + duration, false, task);
+        if (admission == Admission::EarliestFinish) {
+            for (const auto *resource: executable->getAssignedResources()) {
+                if (resource->getResourceType() == Resource::Type::Usable) releaseTimes[resource] = time + duration;
+            }
+        }
+        for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+            if (consumables[demands[offset].first].empty()) {
+                heldUnitTime += static_cast<double>(demands[offset].second) * static_cast<double>(duration);
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "  Error in '" << executable->getName() << "': " << e.what() << "\n";
+        executable->releaseResources();
+        states[task] = TaskState::Failed;
+        ++report.failed;
+    }
+}
+
+/**
+ * @brief Retrieves the units a group can serve right now.
+ * @param group The group.
+ * @return The remaining units of its consumables, or its number of available usable resources.
+ */
+long long EventDrivenScheduler::freeUnits(const std::size_t group) const {
+    if (consumables[group].empty()) return availableCounts[group];
+    long long units = 0;
+    for (const auto *consumable: consumables[group]) units += consumable->getRemainingCapacity();
+    return units;
+}
+
+/**
+ * @brief Scales a duration to the pace of a usable resource.
+ * @param duration Duration on a resource of the reference capacity.
+ * @param capacity Capacity of the resource.
+ * @return The duration rounded up, or unchanged without a reference capacity.
+ */
+std::int64_t EventDrivenScheduler::scaleDuration(const std::int64_t duration, const double capacity) const {
+    if (referenceCapacity <= 0 || capacity <= 0) return duration;
+    return static_cast<std::int64_t>(std::ceil(static_cast<double>(duration) * referenceCapacity / capacity));
+}
+
+/**
+ * @brief Bounds the duration of a task started now, whichever free resources it is assigned.
+ * @param task Position of the task, which fits right now.
+ * @return Its duration scaled to the slowest free usable resource of the groups it requires.
+ */
+std::int64_t EventDrivenScheduler::longestDuration(const std::size_t task) const {
+    const auto duration = static_cast<std::int64_t>(tasks[task]->getDurationInUnits());
+    if (referenceCapacity <= 0) return duration;
+    int slowest = 0;
+    for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+        for (const auto *resource: placementOrder[demands[offset].first]) {
+            const auto capacity = capacityOf(*resource);
+            if (capacity > 0 && resource->isAvailableForUse() && (slowest == 0 || capacity < slowest)) {
+                slowest = capacity;
+            }
+        }
+    }
+    return slowest > 0 ? scaleDuration(duration, slowest) : duration;
+}
+
+/**
+ * @brief Checks whether a task would finish earlier on a faster busy resource than on the free ones, and if so
+ * reserves that resource for it until the next scheduling point.
+ * @param task Position of the task, which fits right now.
+ * @param time Current simulated time.
+ * @return True if the task requires one unit of a single usable group and one of its busy resources, faster
+ * than its fastest free one, would complete the task earlier once released and once the tasks that reserved it
+ * before complete.
+ */
+bool EventDrivenScheduler::waitsForFasterUnit(const std::size_t task, const std::int64_t time) {
+    if (referenceCapacity <= 0) return false;
+    auto usableGroup = NoGroup;
+    for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+        const auto &[group, units] = demands[offset];
+        if (!consumables[group].empty()) continue;
+        if (usableGroup != NoGroup || units != 1) return false;
+        usableGroup = group;
+    }
+    if (usableGroup == NoGroup) return false;
+
+    const auto &order = placementOrder[usableGroup];
+    const auto fastestFree = std::find_if(order.begin(), order.end(), [](const Resource *resource) {
+        return resource->isAvailableForUse();
+    });
+    if (fastestFree == order.end()) return false;
+    const auto freeCapacity = capacityOf(**fastestFree);
+    const auto duration = static_cast<std::int64_t>(tasks[task]->getDurationInUnits());
+    auto finish = time + scaleDuration(duration, freeCapacity);
+    // Faster resources precede the fastest free one and are all busy; those held outside the simulation are
+    // never released, so only the ones a task holds are waited for.
+    const Resource *chosen = nullptr;
+    for (auto resource = order.begin(); resource != fastestFree; ++resource) {
+        if (capacityOf(**resource) <= freeCapacity) break;
+        const auto released = releaseTimes.find(*resource);
+        if (released == releaseTimes.end()) continue;
+        const auto reserved = reservations.find(*resource);
+        const auto start = reserved == reservations.end() ? released->second
+                                                          : std::max(released->second, reserved->second);
+        const auto candidate = start + scaleDuration(duration, capacityOf(**resource));
+        if (candidate < finish) {
+            finish = candidate;
+            chosen = *resource;
+        }
+    }
+    if (chosen == nullptr) return false;
+    reservations[chosen] = finish;
+    return true;
+}
+
+/**
+ * @brief Finds the first group that cannot serve a task's demand right now.
+ * @param task Position of the task.
+ * @return The first group with fewer free units than the task requires of it, or NoGroup if it fits.
+ */
+std::size_t EventDrivenScheduler::findShortage(const std::size_t task) const {
+    for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+        if (freeUnits(demands[offset].first) < demands[offset].second) return demands[offset].first;
+    }
+    return NoGroup;
+}
+
+/**
+ * @brief Adds newly ready tasks to the ready list and starts the tasks the packing admission chooses.
+ * @param arrivals Tasks whose dependencies completed since the last call; emptied.
+ * @param time Current simulated time.
+ * @param report Report receiving failures.
+ */
+void EventDrivenScheduler::admit(std::vector<std::size_t> &arrivals, const std::int64_t time, Report &report) {
+    capacityFreed = false;
+    if (admission == Admission::BestFit) {
+        packBestFit(arrivals, time, report);
+        return;
+    }
+    // The ready list stays sorted by size, larger first, then by position, so arrivals are merged into it;
+    // backfilling keeps it in arrival order instead, appending arrivals by position.
+    const auto precedes = [this](const std::size_t left, const std::size_t right) {
+        if (admissionKeys[left] == admissionKeys[right]) return left < right;
+        return admissionKeys[left] > admissionKeys[right];
+    };
+    std::sort(arrivals.begin(), arrivals.end(), precedes);
+    for (const auto task: arrivals) states[task] = TaskState::Waiting;
+    const auto middle = static_cast<std::ptrdiff_t>(ready.size());
+    ready.insert(ready.end(), arrivals.begin(), arrivals.end());
+    if (admission != Admission::Backfill) {
+        std::inplace_merge(ready.begin(), ready.begin() + middle, ready.end(), precedes);
+    }
+    arrivals.clear();
+
+    if (admission == Admission::Backfill) {
+        backfill(time, report);
+        return;
+    }
+
+    std::size_t kept = 0;
+    reservations.clear();
+    for (const auto task: ready) {
+        if (findShortage(task) == NoGroup &&
+            (admission != Admission::EarliestFinish || !waitsForFasterUnit(task, time))) {
+            start(task, time, report);
+        } else {
+            ready[kept++] = task;
+        }
+    }
+    ready.resize(kept);
+}
+
+/**
+ * @brief Adds newly ready tasks to their demand classes and repeatedly starts the fitting task that leaves the
+ * least free capacity.
+ * @param arrivals Tasks whose dependencies completed since the last call; emptied.
+ * @param time Current simulated time.
+ * @param report Report receiving failures.
+ */
+void EventDrivenScheduler::packBestFit(std::vector<std::size_t> &arrivals, const std::int64_t time, Report &report) {
+    for (const auto task: arrivals) {
+        states[task] = TaskState::Waiting;
+        auto &queue = readyByClass[demandClasses[task]];
+        if (queue.empty()) activeClasses.push_back(demandClasses[task]);
+        queue.push_back(task);
+        std::push_heap(queue.begin(), queue.end(), std::greater<>());
+    }
+    arrivals.clear();
+
+    // Starting a task lowers the free units by its demand d; relative to the offered units u, the squared norm
+    // of the free units f changes by the sum of d(d - 2f)/u^2, so the smallest sum leaves the least capacity.
+    // Tasks of one class fit and change the norm alike, so each pass weighs the first ready task of every class.
+    while (true) {
+        auto best = NoGroup;
+        auto bestClass = NoGroup;
+        double bestChange = 0;
+        for (const auto demandClass: activeClasses) {
+            const auto candidate = readyByClass[demandClass].front();
+            if (findShortage(candidate) != NoGroup) continue;
+            double change = 0;
+            for (auto offset = demandOffsets[candidate]; offset < demandOffsets[candidate + 1]; ++offset) {
+                const auto &[group, units] = demands[offset];
+                if (groupUnits[group] <= 0) continue;
+                change += units * (units - 2.0 * static_cast<double>(freeUnits(group))) /
+                        (groupUnits[group] * groupUnits[group]);
+            }
+            if (best == NoGroup || change < bestChange || (change == bestChange && candidate < best)) {
+                best = candidate;
+                bestClass = demandClass;
+                bestChange = change;
+            }
+        }
+        if (best == NoGroup) return;
+        auto &queue = readyByClass[bestClass];
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        queue.pop_back();
+        if (queue.empty()) activeClasses.erase(std::find(activeClasses.begin(), activeClasses.end(), bestClass));
+        start(best, time, report);
+    }
+}
+
+/**
+ * @brief Starts ready tasks in order, then backfills around a reservation for the first that does not fit.
+ * @param time Current simulated time.
+ * @param report Report receiving failures.
+ */
+void EventDrivenScheduler::backfill(const std::int64_t time, Report &report) {
+    std::size_t kept = 0;
+    auto next = ready.begin();
+    for (; next != ready.end(); ++next) {
+        if (findShortage(*next) == NoGroup) {
+            start(*next, time, report);
+        } else if (unattainable[*next]) {
+            ready[kept++] = *next;
+        } else {
+            break;
+        }
+    }
+    if (next == ready.end()) {
+        ready.resize(kept);
+        return;
+    }
+
+    // The head is reserved the earliest time at which running tasks, completing in order, have freed enough
+    // units of every group it requires; spare holds what each of its groups will have left over at that time.
+    // Consumables are not given back, so a head short of them is reserved no time, only its units.
+    const auto head = *next;
+    ready[kept++] = head;
+    constexpr auto never = std::numeric_limits<std::int64_t>::max();
+    std::vector<long long> spare(availableCounts.size(), std::numeric_limits<long long>::max());
+    bool headShort = false;
+    bool consumableShort = false;
+    for (auto offset = demandOffsets[head]; offset < demandOffsets[head + 1]; ++offset) {
+        const auto &[group, units] = demands[offset];
+        spare[group] = freeUnits(group) - units;
+        if (spare[group] < 0) (consumables[group].empty() ? headShort : consumableShort) = true;
+    }
+    std::vector<std::pair<std::int64_t, std::size_t> > completions;
+    for (const auto &event: events) {
+        if (!event.replenishment) completions.emplace_back(event.time, event.index);
+    }
+    std::sort(completions.begin(), completions.end());
+    auto shadow = consumableShort ? never : time;
+    for (auto completion = completions.begin(); completion != completions.end() && shadow != never; ++completion) {
+        if (!headShort && completion->first > shadow) break;
+        shadow = completion->first;
+        headShort = false;
+        for (auto offset = demandOffsets[completion->second]; offset < demandOffsets[completion->second + 1];
+             ++offset) {
+            const auto &[group, units] = demands[offset];
+            if (consumables[group].empty() && spare[group] != std::numeric_limits<long long>::max()) {
+                spare[group] += units;
+            }
+        }
+        for (auto offset = demandOffsets[head]; offset < demandOffsets[head + 1]; ++offset) {
+            if (spare[demands[offset].first] < 0) headShort = true;
+        }
+    }
+    if (headShort) shadow = never;
+
+    // A later task that fits starts now if it frees its usable units by the reservation and leaves the head's
+    // consumables alone, or else if it only takes units the reservation leaves spare.
+    for (++next; next != ready.end(); ++next) {
+        const auto task = *next;
+        if (findShortage(task) != NoGroup) {
+            ready[kept++] = task;
+            continue;
+        }
+        // With a reference capacity the task may land on the slowest free resource, so that pace must finish too.
+        const bool completesFirst = shadow != never && time + longestDuration(task) <= shadow;
+        bool harmless = true;
+        for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1] && harmless; ++offset) {
+            const auto &[group, units] = demands[offset];
+            if (completesFirst && consumables[group].empty()) continue;
+            harmless = units <= spare[group];
+        }
+        if (!harmless) {
+            ready[kept++] = task;
+            continue;
+        }
+        for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+            const auto &[group, units] = demands[offset];
+            if (spare[group] == std::numeric_limits<long long>::max()) continue;
+            if (completesFirst && consumables[group].empty()) continue;
+            spare[group] -= units;
+        }
+        start(task, time, report);
+    }
+    ready.resize(kept);
+}
+
+/**
+ * @brief Runs the simulation until no event remains.
+ * @return The outcome of the simulation.
+ */
+EventDrivenScheduler::Report EventDrivenScheduler::run() {
+    Report report;
+
+    // A task becomes a candidate once every distinct dependency name has a completed task.
+    std::unordered_map<std::string, std::vector<std::size_t> > dependents;
+    std::vector<std::size_t> unmetDependencies(tasks.size(), 0);
+    std::vector<std::size_t> candidates;
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        auto names = tasks[task]->getDependencyNames();
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (const auto &name: names) dependents[name].push_back(task);
+        unmetDependencies[task] = names.size();
+        if (names.empty()) candidates.push_back(task);
+    }
+    std::unordered_set<std::string> completedNames;
+
+    for (std::size_t index = 0; index < replenishments.size(); ++index) {
+        schedule(replenishments[index].time, true, index);
+    }
+
+    std::int64_t time = 0;
+    while (true) {
+        // Newly unblocked tasks are evaluated in the order they were added. Then the waiters of each group
+        // that became available are evaluated in arrival order, only while the group still has an available
+        // resource, so a release wakes the tasks it can serve rather than the whole list. The packing
+        // admissions instead choose among all ready tasks whenever some arrived or a resource was freed.
+        if (admission != Admission::FirstCome) {
+            if (!candidates.empty() || capacityFreed) admit(candidates, time, report);
+        }
+        while (!candidates.empty() || !wokenGroups.empty()) {
+            std::sort(candidates.begin(), candidates.end());
+            auto evaluating = std::move(candidates);
+            candidates.clear();
+            for (const auto task: evaluating) evaluate(task, time, report);
+            while (!wokenGroups.empty()) {
+                const auto group = wokenGroups.back();
+                wokenGroups.pop_back();
+                auto &queue = waiters[group];
+                // A waiter needing more units than are free keeps its place and holds back the ones behind it.
+                while (availableCounts[group] > 0 && !queue.empty() && findShortage(queue.front()) != group) {
+                    const auto task = queue.front();
+                    queue.pop_front();
+                    evaluate(task, time, report);
+                }
+            }
+        }
+        if (events.empty()) break;
+
+        time = events.front().time;
+        while (!events.empty() && events.front().time == time) {
+            std::pop_heap(events.begin(), events.end(), isLater<Event>);
+            const auto event = events.back();
+            events.pop_back();
+            if (event.replenishment) {
+                const auto &refill = replenishments[event.index];
+                const auto target = std::find_if(resourcePool.begin(), resourcePool.end(),
+                                                 [&refill](const auto &resource) {
+                                                     return resource->getName() == refill.resourceName &&
+                                                            resource->getResourceType() ==
+                                                            Resource::Type::Consumable;
+                                                 });
+                if (target == resourcePool.end()) {
+                    std::cerr << "Warning: No consumable resource '" << refill.resourceName << "' to replenish\n";
+                    continue;
+                }
+                static_cast<ConsumableResource &>(**target).replenish(refill.units);
+                // A refill adds units even when the consumable never ran out and its availability did not
+                // change, and waiters may need several of them.
+                const auto group = poolGroups[static_cast<std::size_t>(target - resourcePool.begin())];
+                capacityFreed = true;
+                if (!waiters[group].empty()) wokenGroups.push_back(group);
+                std::cout << "  [t=" << time << "] Replenished '" << refill.resourceName << "' by "
+                        << refill.units << " units\n";
+                continue;
+            }
+            const auto &executable = tasks[event.index];
+            executable->releaseResources();
+            states[event.index] = TaskState::Completed;
+            ++report.completed;
+            report.makespan = time;
+            std::cout << "  [t=" << time << "] Task '" << executable->getName() << "' completed\n";
+            if (!completedNames.insert(executable->getName()).second) continue;
+            const auto waiting = dependents.find(executable->getName());
+            if (waiting == dependents.end()) continue;
+            for (const auto task: waiting->second) {
+                if (--unmetDependencies[task] == 0) candidates.push_back(task);
+            }
+        }
+    }
+
+    if (usableUnits > 0 && report.makespan > 0) {
+        report.utilisation = heldUnitTime / (usableUnits * static_cast<double>(report.makespan));
+    }
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        if (states[task] != TaskState::Blocked && states[task] != TaskState::Waiting) continue;
+        ++report.skipped;
+        std::cout << "  Task '" << tasks[task]->getName() << "' skipped: ";
+        if (unmetDependencies[task] == 0) {
+            std::cout << "insufficient resources\n";
+            continue;
+        }
+        const auto &dependencies = tasks[task]->getDependencyNames();
+        const auto pending = std::find_if(dependencies.begin(), dependencies.end(),
+                                          [&completedNames](const auto &name) {
+                                              return completedNames.count(name) == 0;
+                                          });
+        std::cout << "dependency '" << *pending << "' not completed\n";
+    }
+    return report;
+}
+
+/**
+ * @brief Updates the available count of a group, waking its waiters when it becomes available.
+ * @param tag The group of the resource.
+ * @param available True if the resource became available, false if it became unavailable.
+ */
+void EventDrivenScheduler::availabilityChanged(const std::size_t tag, const bool available) {
+    auto &count = availableCounts[tag];
+    count += available ? 1 : -1;
+    if (available) capacityFreed = true;
+    if (available && !waiters[tag].empty()) wokenGroups.push_back(tag);
+}
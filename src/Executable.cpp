@@ -1,6 +1,8 @@
 #include "Executable.h"
+#include "TraceRecorder.h"
 #include <stdexcept>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 /**
@@ -19,6 +21,16 @@ Executable::Executable(const std::string &name, std::string description,
     if (durationInUnits <= 0) throw std::invalid_argument("Duration for '" + name + "' must be positive");
 }
 
+/**
+ * @brief Copies the dependencies and the input and output artifacts another executable declares.
+ * @param other The executable to copy the declarations of.
+ */
+void Executable::copyDeclarationsFrom(const Executable &other) {
+    dependencyNames = other.dependencyNames;
+    inputNames = other.inputNames;
+    outputNames = other.outputNames;
+}
+
 /**
  * @brief Retrieves the entity's unique name.
  * @return The name of the executable entity.
@@ -27,6 +39,14 @@ std::string Executable::getName() const {
     return name;
 }
 
+/**
+ * @brief Retrieves the description of the entity's purpose.
+ * @return The description.
+ */
+const std::string &Executable::getDescription() const {
+    return description;
+}
+
 /**
  * @brief Retrieves the names of required resources.
  * @return A constant reference to the vector of resource names.
@@ -43,6 +63,61 @@ int Executable::getDurationInUnits() const {
     return durationInUnits;
 }
 
+/**
+ * @brief Declares that another executable of the same process must complete before this one.
+ * @param executableName Name of the executable this one depends on.
+ * @throw std::invalid_argument If the name is empty or names this executable.
+ */
+void Executable::addDependency(const std::string &executableName) {
+    if (executableName.empty()) throw std::invalid_argument("Dependency name for '" + name + "' cannot be empty");
+    if (executableName == name) throw std::invalid_argument("'" + name + "' cannot depend on itself");
+    dependencyNames.push_back(executableName);
+}
+
+/**
+ * @brief Retrieves the names of executables this one depends on.
+ * @return A constant reference to the vector of dependency names.
+ */
+const std::vector<std::string> &Executable::getDependencyNames() const {
+    return dependencyNames;
+}
+
+/**
+ * @brief Declares an artifact the entity reads, so that a change to it invalidates the entity.
+ * @param inputName Name of the artifact, such as a source file.
+ * @throw std::invalid_argument If the name is empty.
+ */
+void Executable::addInput(const std::string &inputName) {
+    if (inputName.empty()) throw std::invalid_argument("Input name for '" + name + "' cannot be empty");
+    inputNames.push_back(inputName);
+}
+
+/**
+ * @brief Retrieves the artifacts the entity reads.
+ * @return A constant reference to the vector of input names.
+ */
+const std::vector<std::string> &Executable::getInputNames() const {
+    return inputNames;
+}
+
+/**
+ * @brief Declares an artifact the entity produces, so that entities reading it are invalidated with it.
+ * @param outputName Name of the artifact, such as an object file.
+ * @throw std::invalid_argument If the name is empty.
+ */
+void Executable::addOutput(const std::string &outputName) {
+    if (outputName.empty()) throw std::invalid_argument("Output name for '" + name + "' cannot be empty");
+    outputNames.push_back(outputName);
+}
+
+/**
+ * @brief Retrieves the artifacts the entity produces.
+ * @return A constant reference to the vector of output names.
+ */
+const std::vector<std::string> &Executable::getOutputNames() const {
+    return outputNames;
+}
+
 /**
  * @brief Assigns required resources from a pool.
  * @param resourcePool The pool of available resources.
@@ -50,51 +125,192 @@ int Executable::getDurationInUnits() const {
  */
 void Executable::assignResources(const std::vector<std::unique_ptr<Resource> > &resourcePool) {
     assignedResources.clear();
+    holdSpanIds.clear();
     if (requiredResourcesNames.empty()) return;
 
-    for (const auto &resourceName: requiredResourcesNames) {
+    TraceRecorder *const trace = TraceRecorder::active();
+    if (trace) trace->begin(TraceRecorder::Category::Assign, name);
+    for (std::size_t requirement = 0; requirement < requiredResourcesNames.size(); ++requirement) {
+        if (isBorrowed(requirement)) continue;
+        const auto &resourceName = requiredResourcesNames[requirement];
         bool found = false;
         for (auto &resource: resourcePool) {
             if (resource->getName() == resourceName && resource->isAvailableForUse()) {
                 resource->allocate();
                 assignedResources.push_back(resource.get());
+                holdSpanIds.push_back(trace ? trace->newSpanId() : 0);
+                if (trace) trace->beginAsync(TraceRecorder::Category::Resource, resourceName, holdSpanIds.back());
                 found = true;
                 break;
             }
         }
         if (!found) {
             releaseResources();
+            if (trace) trace->end(TraceRecorder::Category::Assign, name);
             throw std::runtime_error("Resource '" + resourceName + "' not available for '" + name + "'");
         }
     }
+    if (trace) trace->end(TraceRecorder::Category::Assign, name);
 }
 
 /**
- * @brief Releases all assigned resources.
+ * @brief Assigns required resources from groups already resolved for each requirement.
+ * @param requirementGroups Candidate resources of each required name, in requirement order.
+ * @throw std::runtime_error If a group has no available resource or the groups do not match the requirements.
+ */
+void Executable::assignResources(const std::vector<const std::vector<Resource *> *> &requirementGroups) {
+    assignedResources.clear();
+    holdSpanIds.clear();
+    if (requirementGroups.size() != requiredResourcesNames.size()) {
+        throw std::runtime_error("Resolved requirements do not match the requirements of '" + name + "'");
+    }
+    if (requirementGroups.empty()) return;
+
+    TraceRecorder *const trace = TraceRecorder::active();
+    if (trace) trace->begin(TraceRecorder::Category::Assign, name);
+    for (std::size_t requirement = 0; requirement < requirementGroups.size(); ++requirement) {
+        if (isBorrowed(requirement)) continue;
+        Resource *chosen = nullptr;
+        if (requirementGroups[requirement]) {
+            for (auto *resource: *requirementGroups[requirement]) {
+                if (resource->isAvailableForUse()) {
+                    chosen = resource;
+                    break;
+                }
+            }
+        }
+        if (!chosen) {
+            releaseResources();
+            if (trace) trace->end(TraceRecorder::Category::Assign, name);
+            throw std::runtime_error("Resource '" + requiredResourcesNames[requirement] + "' not available for '" +
+                                     name + "'");
+        }
+        chosen->allocate();
+        assignedResources.push_back(chosen);
+        holdSpanIds.push_back(trace ? trace->newSpanId() : 0);
+        if (trace) {
+            trace->beginAsync(TraceRecorder::Category::Resource, requiredResourcesNames[requirement],
+                              holdSpanIds.back());
+        }
+    }
+    if (trace) trace->end(TraceRecorder::Category::Assign, name);
+}
+
+/**
+ * @brief Releases all assigned resources; borrowed resources stay with their lender.
  */
 void Executable::releaseResources() {
-    for (auto *resource: assignedResources) {
+    TraceRecorder *const trace = assignedResources.empty() ? nullptr : TraceRecorder::active();
+    if (trace) trace->begin(TraceRecorder::Category::Release, name);
+    for (std::size_t held = 0; held < assignedResources.size(); ++held) {
+        auto *resource = assignedResources[held];
         try {
             resource->release();
         } catch (const std::exception &e) {
             std::cerr << "Warning: Failed to release resource '" << resource->getName()
                     << "' in '" << name << "': " << e.what() << "\n";
         }
+        // Holds that began before tracing was installed have no span to end.
+        if (trace && held < holdSpanIds.size() && holdSpanIds[held] != 0) {
+            trace->endAsync(TraceRecorder::Category::Resource, resource->getName(), holdSpanIds[held]);
+        }
     }
     assignedResources.clear();
+    holdSpanIds.clear();
+    if (trace) trace->end(TraceRecorder::Category::Release, name);
+}
+
+/**
+ * @brief Borrows resources an enclosing process holds instead of allocating them from the pool.
+ * @param loans Names and resources the enclosing process lends.
+ */
+void Executable::borrowResources(const std::vector<std::pair<std::string, Resource *> > &loans) {
+    returnBorrowedResources();
+    if (loans.empty() || requiredResourcesNames.empty()) return;
+    borrowedResources.assign(requiredResourcesNames.size(), nullptr);
+    std::vector<bool> claimed(loans.size(), false);
+    for (std::size_t requirement = 0; requirement < requiredResourcesNames.size(); ++requirement) {
+        for (std::size_t loan = 0; loan < loans.size(); ++loan) {
+            if (claimed[loan] || loans[loan].first != requiredResourcesNames[requirement]) continue;
+            claimed[loan] = true;
+            borrowedResources[requirement] = loans[loan].second;
+            ++borrowedCount;
+            break;
+        }
+    }
+    if (borrowedCount == 0) borrowedResources.clear();
+}
+
+/**
+ * @brief Gives back every borrowed resource.
+ */
+void Executable::returnBorrowedResources() {
+    borrowedResources.clear();
+    borrowedCount = 0;
+}
+
+/**
+ * @brief Forgets every assigned and borrowed resource without releasing it, as when the resources' own
+ * state is restored from a snapshot.
+ */
+void Executable::forgetResources() {
+    assignedResources.clear();
+    holdSpanIds.clear();
+    returnBorrowedResources();
+}
+
+/**
+ * @brief Checks whether a requirement is met by a borrowed resource.
+ * @param requirement Position of the requirement.
+ * @return True if the requirement is borrowed.
+ */
+bool Executable::isBorrowed(const std::size_t requirement) const {
+    return borrowedCount != 0 && borrowedResources[requirement] != nullptr;
+}
+
+/**
+ * @brief Retrieves the number of borrowed requirements.
+ * @return The number of requirements met by borrowed resources.
+ */
+std::size_t Executable::getBorrowedCount() const {
+    return borrowedCount;
+}
+
+/**
+ * @brief Displays the usage of the assigned and borrowed resources, in requirement order.
+ */
+void Executable::useResources() const {
+    std::size_t allocated = 0;
+    for (std::size_t requirement = 0; requirement < requiredResourcesNames.size(); ++requirement) {
+        if (isBorrowed(requirement)) {
+            borrowedResources[requirement]->use();
+        } else if (allocated < assignedResources.size()) {
+            assignedResources[allocated++]->use();
+        }
+    }
+}
+
+/**
+ * @brief Retrieves the resources currently assigned to the entity.
+ * @return A constant reference to the assigned resources, in requirement order, without borrowed ones.
+ */
+const std::vector<Resource *> &Executable::getAssignedResources() const {
+    return assignedResources;
 }
 
 /**
  * @brief Checks if the entity can be executed with the given resource pool.
  * @param resourcePool The pool of available resources.
- * @return True if all required resources are available, false otherwise.
+ * @return True if all required resources that are not borrowed are available, false otherwise.
  */
 bool Executable::canExecute(const std::vector<std::unique_ptr<Resource> > &resourcePool) const {
     if (requiredResourcesNames.empty()) {
         std::cout << "No resources required for task " << name << "\n";
         return true;
     }
-    for (const auto &resourceName: requiredResourcesNames) {
+    for (std::size_t requirement = 0; requirement < requiredResourcesNames.size(); ++requirement) {
+        if (isBorrowed(requirement)) continue;
+        const auto &resourceName = requiredResourcesNames[requirement];
         if (std::none_of(resourcePool.begin(), resourcePool.end(),
                          [&resourceName](const std::unique_ptr<Resource> &resource) {
                              return resource->getName() == resourceName && resource->isAvailableForUse();
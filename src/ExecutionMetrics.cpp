@@ -0,0 +1,257 @@
+#include "ExecutionMetrics.h"
+#include "Json.h"
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Writes the summary of a histogram as a JSON object.
+     * @param output The stream to write to.
+     * @param histogram The histogram to summarise.
+     */
+    void writeHistogram(std::ostream &output, const ExecutionMetrics::Histogram &histogram) {
+        output << "{\"count\":" << histogram.count << ",\"sum_ns\":" << histogram.sum
+                << ",\"max_ns\":" << histogram.max << ",\"p50_ns\":" << histogram.percentile(0.5)
+                << ",\"p90_ns\":" << histogram.percentile(0.9) << ",\"p99_ns\":" << histogram.percentile(0.99)
+                << ",\"buckets\":[";
+        bool first = true;
+        for (std::size_t bucket = 0; bucket < histogram.buckets.size(); ++bucket) {
+            if (histogram.buckets[bucket] == 0) continue;
+            const std::uint64_t upperBound = bucket == 0 ? 0 : (std::uint64_t{1} << bucket) - 1;
+            output << (first ? "" : ",") << "[" << upperBound << "," << histogram.buckets[bucket] << "]";
+            first = false;
+        }
+        output << "]}";
+    }
+}
+
+/**
+ * @brief Records one sample.
+ * @param nanoseconds The latency to record.
+ */
+void ExecutionMetrics::Histogram::record(const std::uint64_t nanoseconds) {
+    std::size_t bucket = 0;
+    for (std::uint64_t remaining = nanoseconds; remaining != 0 && bucket < BucketCount - 1; remaining >>= 1) ++bucket;
+    if (bucket >= buckets.size()) buckets.resize(bucket + 1, 0);
+    ++buckets[bucket];
+    ++count;
+    sum += nanoseconds;
+    max = std::max(max, nanoseconds);
+}
+
+/**
+ * @brief Adds the samples of another histogram.
+ * @param other The histogram to add.
+ */
+void ExecutionMetrics::Histogram::merge(const Histogram &other) {
+    if (buckets.size() < other.buckets.size()) buckets.resize(other.buckets.size(), 0);
+    for (std::size_t bucket = 0; bucket < other.buckets.size(); ++bucket) buckets[bucket] += other.buckets[bucket];
+    count += other.count;
+    sum += other.sum;
+    max = std::max(max, other.max);
+}
+
+/**
+ * @brief Estimates a percentile as the upper bound of the bucket containing it.
+ * @param fraction The percentile as a fraction in [0, 1].
+ * @return The estimated latency in nanoseconds; 0 if the histogram is empty.
+ */
+std::uint64_t ExecutionMetrics::Histogram::percentile(const double fraction) const {
+    if (count == 0) return 0;
+    const auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) return bucket == 0 ? 0 : std::min(max, (std::uint64_t{1} << bucket) - 1);
+    }
+    return max;
+}
+
+/**
+ * @brief Constructs an empty set of metrics.
+ */
+ExecutionMetrics::ExecutionMetrics() = default;
+
+/**
+ * @brief Retrieves the counters of a task in the calling thread's shard.
+ * @param task Position of the task.
+ * @return The task counters.
+ */
+ExecutionMetrics::TaskCounters &ExecutionMetrics::taskCounters(const std::size_t task) {
+    auto &tasks = shards.local().data.tasks;
+    if (task >= tasks.size()) tasks.resize(task + 1);
+    return tasks[task];
+}
+
+/**
+ * @brief Retrieves the counters of a resource in the calling thread's shard.
+ * @param resource Position of the resource.
+ * @return The resource counters.
+ */
+ExecutionMetrics::ResourceCounters &ExecutionMetrics::resourceCounters(const std::size_t resource) {
+    auto &resources = shards.local().data.resources;
+    if (resource >= resources.size()) resources.resize(resource + 1);
+    return resources[resource];
+}
+
+/**
+ * @brief Records that a task started after waiting since the start of its process.
+ * @param task Position of the task.
+ * @param waitNanoseconds Time since the process started executing.
+ */
+void ExecutionMetrics::recordTaskStarted(const std::size_t task, const std::uint64_t waitNanoseconds) {
+    taskCounters(task).waitTime.record(waitNanoseconds);
+    shards.local().data.taskWait.record(waitNanoseconds);
+}
+
+/**
+ * @brief Records that a task completed.
+ * @param task Position of the task.
+ * @param runNanoseconds Time from resource assignment to release.
+ */
+void ExecutionMetrics::recordTaskCompleted(const std::size_t task, const std::uint64_t runNanoseconds) {
+    auto &counters = taskCounters(task);
+    ++counters.executions;
+    counters.runTime.record(runNanoseconds);
+    shards.local().data.taskRun.record(runNanoseconds);
+}
+
+/**
+ * @brief Records that a task was skipped.
+ * @param task Position of the task.
+ */
+void ExecutionMetrics::recordTaskSkipped(const std::size_t task) {
+    ++taskCounters(task).skips;
+}
+
+/**
+ * @brief Records that a task raised an error.
+ * @param task Position of the task.
+ */
+void ExecutionMetrics::recordTaskFailed(const std::size_t task) {
+    ++taskCounters(task).failures;
+}
+
+/**
+ * @brief Records a successful allocation of a resource.
+ * @param resource Position of the resource.
+ */
+void ExecutionMetrics::recordAcquisition(const std::size_t resource) {
+    ++resourceCounters(resource).acquisitions;
+}
+
+/**
+ * @brief Records that a requester found a resource unavailable.
+ * @param resource Position of the resource.
+ */
+void ExecutionMetrics::recordContention(const std::size_t resource) {
+    ++resourceCounters(resource).contentionFailures;
+}
+
+/**
+ * @brief Records how long a resource was held.
+ * @param resource Position of the resource.
+ * @param nanoseconds Time between allocation and release.
+ */
+void ExecutionMetrics::recordHold(const std::size_t resource, const std::uint64_t nanoseconds) {
+    resourceCounters(resource).holdTime.record(nanoseconds);
+}
+
+/**
+ * @brief Records one execution of the process.
+ * @param nanoseconds Duration of the execution.
+ */
+void ExecutionMetrics::recordProcessRun(const std::uint64_t nanoseconds) {
+    auto &data = shards.local().data;
+    ++data.processRuns;
+    data.processNanoseconds += nanoseconds;
+}
+
+/**
+ * @brief Merges the shards of all threads.
+ * @return The merged counters.
+ * @note Reads shards without synchronising with recording threads; call it once they are quiescent.
+ */
+ExecutionMetrics::Snapshot ExecutionMetrics::snapshot() const {
+    Snapshot merged;
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    shards.forEach([&](const Shard &shard) {
+        const auto &data = shard.data;
+        if (merged.tasks.size() < data.tasks.size()) merged.tasks.resize(data.tasks.size());
+        for (std::size_t task = 0; task < data.tasks.size(); ++task) {
+            auto &target = merged.tasks[task];
+            const auto &source = data.tasks[task];
+            target.executions += source.executions;
+            target.skips += source.skips;
+            target.failures += source.failures;
+            target.waitTime.merge(source.waitTime);
+            target.runTime.merge(source.runTime);
+        }
+        if (merged.resources.size() < data.resources.size()) merged.resources.resize(data.resources.size());
+        for (std::size_t resource = 0; resource < data.resources.size(); ++resource) {
+            merged.resources[resource].acquisitions += data.resources[resource].acquisitions;
+            merged.resources[resource].contentionFailures += data.resources[resource].contentionFailures;
+            merged.resources[resource].holdTime.merge(data.resources[resource].holdTime);
+        }
+        merged.taskWait.merge(data.taskWait);
+        merged.taskRun.merge(data.taskRun);
+        merged.processRuns += data.processRuns;
+        merged.processNanoseconds += data.processNanoseconds;
+    });
+    return merged;
+}
+
+/**
+ * @brief Discards all recorded values.
+ */
+void ExecutionMetrics::reset() {
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    shards.forEach([](Shard &shard) { shard.data = Snapshot{}; });
+}
+
+/**
+ * @brief Writes the merged metrics as a JSON object.
+ * @param output The stream to write to.
+ * @param processName Name of the measured process.
+ * @param taskNames Names of the tasks by position.
+ * @param resourceNames Names of the resources by position.
+ */
+void ExecutionMetrics::writeJson(std::ostream &output, const std::string &processName,
+                                 const std::vector<std::string> &taskNames,
+                                 const std::vector<std::string> &resourceNames) const {
+    const auto data = snapshot();
+    output << "{\"process\":" << Json::quote(processName) << ",\"runs\":" << data.processRuns
+            << ",\"run_ns\":" << data.processNanoseconds << ",\"task_wait\":";
+    writeHistogram(output, data.taskWait);
+    output << ",\"task_run\":";
+    writeHistogram(output, data.taskRun);
+
+    output << ",\"tasks\":[";
+    for (std::size_t task = 0; task < taskNames.size(); ++task) {
+        const auto counters = task < data.tasks.size() ? data.tasks[task] : TaskCounters{};
+        output << (task ? "," : "") << "{\"name\":" << Json::quote(taskNames[task])
+                << ",\"executions\":" << counters.executions << ",\"skips\":" << counters.skips
+                << ",\"failures\":" << counters.failures << ",\"wait_ns\":" << counters.waitTime.sum
+                << ",\"max_wait_ns\":" << counters.waitTime.max << ",\"run_ns\":" << counters.runTime.sum
+                << ",\"max_run_ns\":" << counters.runTime.max << ",\"wait\":";
+        writeHistogram(output, counters.waitTime);
+        output << ",\"run\":";
+        writeHistogram(output, counters.runTime);
+        output << "}";
+    }
+
+    output << "],\"resources\":[";
+    for (std::size_t resource = 0; resource < resourceNames.size(); ++resource) {
+        const auto counters = resource < data.resources.size() ? data.resources[resource] : ResourceCounters{};
+        const double busyRatio = data.processNanoseconds == 0
+                                     ? 0.0
+                                     : static_cast<double>(counters.holdTime.sum) /
+                                       static_cast<double>(data.processNanoseconds);
+        output << (resource ? "," : "") << "{\"name\":" << Json::quote(resourceNames[resource])
+                << ",\"acquisitions\":" << counters.acquisitions
+                << ",\"contention_failures\":" << counters.contentionFailures
+                << ",\"busy_ratio\":" << busyRatio << ",\"hold\":";
+        writeHistogram(output, counters.holdTime);
+        output << "}";
+    }
+    output << "]}";
+}
@@ -0,0 +1,206 @@
+#include "ExecutionPlan.h"
+#include "ConsumableResource.h"
+#include <algorithm>
+
+/**
+ * @brief Resolves the requirements and dependencies of a process.
+ * @param resourcePool The pool of the process.
+ * @param tasks The tasks of the process.
+ * @param ownRequirements The resource names the process itself requires.
+ * @param lentNames Names of the resources the process lends to its tasks, once per loan.
+ */
+ExecutionPlan::ExecutionPlan(const std::vector<std::unique_ptr<Resource> > &resourcePool,
+                             const std::vector<std::unique_ptr<Executable> > &tasks,
+                             const std::vector<std::string> &ownRequirements,
+                             const std::vector<std::string> &lentNames) {
+    // Groups are complete before any requirement points to them, so the pointers stay valid.
+    std::unordered_map<std::string, std::size_t> groupsByName;
+    std::vector<long long> supply;
+    for (const auto &resource: resourcePool) {
+        const auto inserted = groupsByName.emplace(resource->getName(), groups.size());
+        if (inserted.second) {
+            groups.emplace_back();
+            supply.push_back(0);
+        }
+        const auto group = inserted.first->second;
+        groups[group].push_back(resource.get());
+        supply[group] += resource->getResourceType() == Resource::Type::Consumable
+                             ? static_cast<const ConsumableResource &>(*resource).getRemainingCapacity()
+                             : 1;
+    }
+    // Names only the loans carry get an empty group, so tasks borrowing them resolve like the others.
+    loans.assign(groups.size(), 0);
+    for (const auto &name: lentNames) {
+        const auto inserted = groupsByName.emplace(name, groups.size());
+        if (inserted.second) {
+            groups.emplace_back();
+            supply.push_back(0);
+            loans.push_back(0);
+        }
+        ++loans[inserted.first->second];
+    }
+    resolveRequirements(ownRequirements, groupsByName, supply, ownStep, false);
+
+    // Task names are only indexed when some task declares dependencies. Tasks sharing a name are chained in
+    // position order, so each dependency stores a single position.
+    const bool hasDependencies = std::any_of(tasks.begin(), tasks.end(), [](const auto &task) {
+        return !task->getDependencyNames().empty();
+    });
+    std::unordered_map<std::string, std::size_t> tasksByName;
+    nextWithSameName.assign(tasks.size(), NoTask);
+    if (hasDependencies) {
+        tasksByName.reserve(tasks.size());
+        for (std::size_t index = tasks.size(); index-- > 0;) {
+            const auto inserted = tasksByName.emplace(tasks[index]->getName(), index);
+            if (!inserted.second) {
+                nextWithSameName[index] = inserted.first->second;
+                inserted.first->second = index;
+            }
+        }
+    }
+
+    steps.resize(tasks.size());
+    for (std::size_t index = 0; index < tasks.size(); ++index) {
+        auto &step = steps[index];
+        resolveRequirements(tasks[index]->getRequiredResourcesNames(), groupsByName, supply, step, true);
+        const auto &dependencyNames = tasks[index]->getDependencyNames();
+        step.dependencies.reserve(dependencyNames.size());
+        for (const auto &dependency: dependencyNames) {
+            const auto named = tasksByName.find(dependency);
+            if (named == tasksByName.end()) {
+                if (step.infeasibility.empty()) step.infeasibility = "depends on unknown task '" + dependency + "'";
+                step.dependencies.push_back(NoTask);
+                continue;
+            }
+            step.dependencies.push_back(named->second);
+        }
+    }
+
+    // A dependency whose tasks can all never run can never complete; flags spread until nothing changes.
+    const bool anyInfeasible = std::any_of(steps.begin(), steps.end(), [](const Step &step) {
+        return !step.infeasibility.empty();
+    });
+    for (bool changed = anyInfeasible; changed;) {
+        changed = false;
+        for (std::size_t index = 0; index < tasks.size(); ++index) {
+            auto &step = steps[index];
+            if (!step.infeasibility.empty()) continue;
+            const auto &dependencyNames = tasks[index]->getDependencyNames();
+            for (std::size_t dependency = 0; dependency < step.dependencies.size(); ++dependency) {
+                if (anyNamed(step.dependencies[dependency], [this](const std::size_t candidate) {
+                    return steps[candidate].infeasibility.empty();
+                })) {
+                    continue;
+                }
+                step.infeasibility = "depends on '" + dependencyNames[dependency] + "', which can never run";
+                changed = true;
+                break;
+            }
+        }
+    }
+    infeasibleCount = static_cast<std::size_t>(std::count_if(steps.begin(), steps.end(), [](const Step &step) {
+        return !step.infeasibility.empty();
+    }));
+}
+
+/**
+ * @brief Resolves a list of required names.
+ * @param names The required resource names.
+ * @param groupsByName Position of the group of each name.
+ * @param supply Units each group can supply.
+ * @param step Step receiving the requirements and, if they cannot be met, the reason.
+ * @param lending True to count the loans of the process, false to count the pool alone.
+ */
+void ExecutionPlan::resolveRequirements(const std::vector<std::string> &names,
+                                        const std::unordered_map<std::string, std::size_t> &groupsByName,
+                                        const std::vector<long long> &supply, Step &step, const bool lending) const {
+    step.requirements.reserve(names.size());
+    for (const auto &name: names) {
+        const auto group = groupsByName.find(name);
+        if (group == groupsByName.end() || (groups[group->second].empty() && !lending)) {
+            if (step.infeasibility.empty()) step.infeasibility = "requires missing resource '" + name + "'";
+            step.requirements.push_back(nullptr);
+            continue;
+        }
+        step.requirements.push_back(&groups[group->second]);
+    }
+    if (!step.infeasibility.empty()) return;
+    for (std::size_t requirement = 0; requirement < names.size(); ++requirement) {
+        const auto *group = step.requirements[requirement];
+        const auto demand = std::count(step.requirements.begin(), step.requirements.end(), group);
+        const auto position = static_cast<std::size_t>(group - groups.data());
+        const auto available = supply[position] + (lending ? loans[position] : 0);
+        if (demand > available) {
+            step.infeasibility = "requires " + std::to_string(demand) + " units of '" + names[requirement] +
+                                 "' but the pool" + (lending && loans[position] != 0 ? " and loans have " : " has ") +
+                                 std::to_string(available);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Retrieves the next task carrying the same name as a task.
+ * @param index Position of the task.
+ * @return Position of the next task with that name, or NoTask if it is the last one.
+ */
+std::size_t ExecutionPlan::getNextWithSameName(const std::size_t index) const {
+    return nextWithSameName[index];
+}
+
+/**
+ * @brief Retrieves the number of steps.
+ * @return The number of tasks the plan was built for.
+ */
+std::size_t ExecutionPlan::getStepCount() const {
+    return steps.size();
+}
+
+/**
+ * @brief Retrieves the resolved requirements of the process itself.
+ * @return The step of the process; its infeasibility tells whether the process can ever start.
+ */
+const ExecutionPlan::Step &ExecutionPlan::getOwnStep() const {
+    return ownStep;
+}
+
+/**
+ * @brief Retrieves the number of tasks that can never run.
+ * @return The number of flagged tasks.
+ */
+std::size_t ExecutionPlan::getInfeasibleCount() const {
+    return infeasibleCount;
+}
+
+/**
+ * @brief Checks whether every requirement of a step currently has an available resource.
+ * @param step The step to check.
+ * @return True if each required group has an available resource.
+ */
+bool ExecutionPlan::isSatisfied(const Step &step) {
+    return std::all_of(step.requirements.begin(), step.requirements.end(), [](const ResourceGroup *group) {
+        return group && std::any_of(group->begin(), group->end(), [](const Resource *resource) {
+            return resource->isAvailableForUse();
+        });
+    });
+}
+
+/**
+ * @brief Checks whether every requirement of a step that the task does not borrow has an available resource.
+ * @param step The step to check.
+ * @param task The task of the step, with its loans already borrowed.
+ * @return True if each required group that is not borrowed has an available resource.
+ */
+bool ExecutionPlan::isSatisfied(const Step &step, const Executable &task) {
+    if (task.getBorrowedCount() == 0) return isSatisfied(step);
+    for (std::size_t requirement = 0; requirement < step.requirements.size(); ++requirement) {
+        if (task.isBorrowed(requirement)) continue;
+        const auto *group = step.requirements[requirement];
+        if (!group || std::none_of(group->begin(), group->end(), [](const Resource *resource) {
+            return resource->isAvailableForUse();
+        })) {
+            return false;
+        }
+    }
+    return true;
+}
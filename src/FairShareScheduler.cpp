@@ -0,0 +1,197 @@
+#include "FairShareScheduler.h"
+#include "ConsumableResource.h"
+#include <algorithm>
+#include <unordered_set>
+
+/**
+ * @brief Prepares a simulation over the units a machine can serve right now.
+ * @param machine The machine the processes share.
+ * @param policy Which process starts its next task when several can.
+ */
+FairShareScheduler::FairShareScheduler(ResourceManager &machine, const Policy policy) : policy(policy) {
+    for (auto &count: machine.countAvailableUnits()) {
+        machineGroups.emplace(count.resourceName, offeredUnits.size());
+        offeredUnits.push_back(count.available);
+        consumableGroups.push_back(count.type == Resource::Type::Consumable);
+    }
+    machineGroupCount = offeredUnits.size();
+}
+
+/**
+ * @brief Adds the tasks of a process, resolving their requirements against its pool and the machine.
+ * @param process The process; its tasks are copied, so it need not outlive the scheduler.
+ */
+void FairShareScheduler::addProcess(const Process &process) {
+    // The names of the process's pool get groups of their own, past the machine's and other processes' groups.
+    std::unordered_map<std::string, std::size_t> ownGroups;
+    for (const auto &resource: process.getResourcePool()) {
+        const auto inserted = ownGroups.emplace(resource->getName(), offeredUnits.size());
+        if (inserted.second) {
+            offeredUnits.push_back(0);
+            consumableGroups.push_back(resource->getResourceType() == Resource::Type::Consumable);
+        }
+        auto &units = offeredUnits[inserted.first->second];
+        if (resource->getResourceType() == Resource::Type::Consumable) {
+            units += static_cast<const ConsumableResource &>(*resource).getRemainingCapacity();
+        } else if (resource->isAvailableForUse()) {
+            ++units;
+        }
+    }
+
+    const auto processIndex = tenants.size();
+    tenants.push_back({process.getName(), process.getShareWeight(), process.getTasks().size()});
+    std::vector<std::size_t> groups;
+    for (const auto &task: process.getTasks()) {
+        bool attainable = true;
+        groups.clear();
+        for (const auto &name: task->getRequiredResourcesNames()) {
+            const auto own = ownGroups.find(name);
+            if (own != ownGroups.end()) {
+                groups.push_back(own->second);
+                continue;
+            }
+            const auto shared = machineGroups.find(name);
+            if (shared == machineGroups.end()) {
+                attainable = false;
+                continue;
+            }
+            groups.push_back(shared->second);
+        }
+        std::sort(groups.begin(), groups.end());
+        for (auto first = groups.begin(); first != groups.end();) {
+            const auto last = std::upper_bound(first, groups.end(), *first);
+            const auto units = static_cast<long long>(last - first);
+            if (units > offeredUnits[*first]) attainable = false;
+            demands.emplace_back(*first, units);
+            first = last;
+        }
+        demandOffsets.push_back(demands.size());
+        taskInfos.push_back({task->getName(), task->getDependencyNames(), task->getDurationInUnits(), processIndex,
+                             attainable});
+    }
+}
+
+/**
+ * @brief Runs the simulation until every task that can start has completed.
+ * @return The outcome of the simulation.
+ */
+FairShareScheduler::Report FairShareScheduler::run() const {
+    Report report;
+    for (const auto &tenant: tenants) report.processes.push_back({tenant.name, tenant.weight});
+
+    // A task becomes ready once every distinct dependency name has a completed task of its own process.
+    std::vector<std::unordered_map<std::string, std::vector<std::size_t> > > dependents(tenants.size());
+    std::vector<std::unordered_set<std::string> > completedNames(tenants.size());
+    std::vector<std::size_t> unmetDependencies(taskInfos.size(), 0);
+    std::vector<std::deque<std::size_t> > ready(tenants.size());
+    std::vector<std::int64_t> readyTimes(taskInfos.size(), 0);
+    for (std::size_t task = 0; task < taskInfos.size(); ++task) {
+        auto names = taskInfos[task].dependencyNames;
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (const auto &name: names) dependents[taskInfos[task].process][name].push_back(task);
+        unmetDependencies[task] = names.size();
+        if (names.empty()) ready[taskInfos[task].process].push_back(task);
+    }
+
+    auto freeUnits = offeredUnits;
+    std::vector<std::vector<long long> > used(tenants.size(), std::vector<long long>(machineGroupCount, 0));
+    std::vector<double> shares(tenants.size(), 0.0);
+    const auto updateShare = [&](const std::size_t tenant) {
+        double share = 0;
+        for (std::size_t group = 0; group < machineGroupCount; ++group) {
+            if (offeredUnits[group] > 0) {
+                share = std::max(share, static_cast<double>(used[tenant][group]) / offeredUnits[group]);
+            }
+        }
+        shares[tenant] = share;
+        auto &peak = report.processes[tenant].peakShare;
+        peak = std::max(peak, share);
+    };
+    const auto fits = [&](const std::size_t task) {
+        for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+            if (demands[offset].second > freeUnits[demands[offset].first]) return false;
+        }
+        return true;
+    };
+    std::vector<Event> events;
+    std::uint64_t nextSequence = 0;
+    const auto isLater = [](const Event &left, const Event &right) {
+        return left.time != right.time ? left.time > right.time : left.sequence > right.sequence;
+    };
+    std::vector<double> latencySums(tenants.size(), 0.0);
+    std::int64_t time = 0;
+    while (true) {
+        // The policy picks one process at a time among those whose first ready task fits, until none fits.
+        while (true) {
+            std::size_t chosen = tenants.size();
+            for (std::size_t tenant = 0; tenant < tenants.size(); ++tenant) {
+                auto &queue = ready[tenant];
+                while (!queue.empty() && !taskInfos[queue.front()].attainable) queue.pop_front();
+                if (queue.empty() || !fits(queue.front())) continue;
+                if (chosen == tenants.size()) {
+                    chosen = tenant;
+                } else if (policy == Policy::DominantResource) {
+                    if (shares[tenant] / tenants[tenant].weight < shares[chosen] / tenants[chosen].weight) {
+                        chosen = tenant;
+                    }
+                } else if (readyTimes[queue.front()] < readyTimes[ready[chosen].front()]) {
+                    chosen = tenant;
+                }
+            }
+            if (chosen == tenants.size()) break;
+            const auto task = ready[chosen].front();
+            ready[chosen].pop_front();
+            for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+                const auto &[group, units] = demands[offset];
+                freeUnits[group] -= units;
+                if (group < machineGroupCount) used[chosen][group] += units;
+            }
+            updateShare(chosen);
+            events.push_back(Event{time + taskInfos[task].duration, nextSequence++, task});
+            std::push_heap(events.begin(), events.end(), isLater);
+        }
+        if (events.empty()) break;
+
+        time = events.front().time;
+        while (!events.empty() && events.front().time == time) {
+            std::pop_heap(events.begin(), events.end(), isLater);
+            const auto task = events.back().task;
+            events.pop_back();
+            const auto tenant = taskInfos[task].process;
+            for (auto offset = demandOffsets[task]; offset < demandOffsets[task + 1]; ++offset) {
+                const auto &[group, units] = demands[offset];
+                if (consumableGroups[group]) continue;
+                freeUnits[group] += units;
+                if (group < machineGroupCount) used[tenant][group] -= units;
+            }
+            updateShare(tenant);
+            auto &outcome = report.processes[tenant];
+            ++outcome.completed;
+            outcome.finishTime = time;
+            report.makespan = time;
+            const auto latency = time - readyTimes[task];
+            latencySums[tenant] += static_cast<double>(latency);
+            outcome.maxLatency = std::max(outcome.maxLatency, latency);
+            if (!completedNames[tenant].insert(taskInfos[task].name).second) continue;
+            const auto waiting = dependents[tenant].find(taskInfos[task].name);
+            if (waiting == dependents[tenant].end()) continue;
+            for (const auto dependent: waiting->second) {
+                if (--unmetDependencies[dependent] != 0) continue;
+                readyTimes[dependent] = time;
+                ready[tenant].push_back(dependent);
+            }
+        }
+    }
+
+    for (std::size_t tenant = 0; tenant < tenants.size(); ++tenant) {
+        auto &outcome = report.processes[tenant];
+        outcome.skipped = tenants[tenant].taskCount - outcome.completed;
+        if (outcome.completed == 0) continue;
+        outcome.meanLatency = latencySums[tenant] / static_cast<double>(outcome.completed);
+        if (outcome.finishTime > 0) {
+            outcome.throughput = static_cast<double>(outcome.completed) / static_cast<double>(outcome.finishTime);
+        }
+    }
+    return report;
+}
@@ -0,0 +1,39 @@
+#include "Json.h"
+#include <cstdio>
+
+/**
+ * @brief Escapes a string for inclusion in a JSON document.
+ * @param text The text to escape.
+ * @return The escaped text, without surrounding quotes.
+ */
+std::string Json::escape(const std::string &text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char character: text) {
+        switch (character) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(character));
+                    escaped += code;
+                } else {
+                    escaped += character;
+                }
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Quotes and escapes a string as a JSON string literal.
+ * @param text The text to quote.
+ * @return The JSON string literal.
+ */
+std::string Json::quote(const std::string &text) {
+    return "\"" + escape(text) + "\"";
+}
@@ -0,0 +1,180 @@
+#include "Pipeline.h"
+#include "Task.h"
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Constructs an empty channel.
+ * @param capacity Maximum number of queued items.
+ * @param producers Number of producers writing to the channel.
+ */
+Pipeline::Channel::Channel(const std::size_t capacity, const std::size_t producers)
+    : capacity(capacity), openProducers(producers) {}
+
+/**
+ * @brief Adds an item, waiting while the channel is full.
+ * @param item Position of the item.
+ */
+void Pipeline::Channel::push(const std::size_t item) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return items.size() < capacity; });
+        items.push_back(item);
+    }
+    changed.notify_all();
+}
+
+/**
+ * @brief Takes the oldest item, waiting until one arrives or every producer finished.
+ * @param item Receives the position of the item.
+ * @return False once every producer finished and the channel is empty.
+ */
+bool Pipeline::Channel::pop(std::size_t &item) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return !items.empty() || openProducers == 0; });
+        if (items.empty()) return false;
+        item = items.front();
+        items.pop_front();
+    }
+    changed.notify_all();
+    return true;
+}
+
+/**
+ * @brief Records that one producer finished writing.
+ */
+void Pipeline::Channel::finishProducer() {
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        --openProducers;
+    }
+    changed.notify_all();
+}
+
+/**
+ * @brief Constructs a pipeline over a resource pool.
+ * @param resourcePool Resources the stages share; nothing else may use them while the pipeline runs.
+ * @param stages Stages, in pipeline order.
+ * @param options Settings of the runs.
+ * @throw std::invalid_argument If there is no stage, a stage has no name, a non-positive duration or no
+ * worker, or the queue capacity is zero.
+ */
+Pipeline::Pipeline(const std::vector<std::unique_ptr<Resource> > &resourcePool, std::vector<Stage> stages,
+                   const Options options)
+    : resourcePool(resourcePool), stages(std::move(stages)), options(options) {
+    if (this->stages.empty()) throw std::invalid_argument("A pipeline needs at least one stage");
+    if (options.queueCapacity == 0) throw std::invalid_argument("Pipeline queues need a positive capacity");
+    for (const auto &stage: this->stages) {
+        if (stage.name.empty()) throw std::invalid_argument("Pipeline stage name cannot be empty");
+        if (stage.durationInUnits <= 0) {
+            throw std::invalid_argument("Duration of pipeline stage '" + stage.name + "' must be positive");
+        }
+        if (stage.parallelism == 0) {
+            throw std::invalid_argument("Pipeline stage '" + stage.name + "' needs at least one worker");
+        }
+    }
+}
+
+/**
+ * @brief Runs the items of one stage until its input channel is drained.
+ * @param stage Position of the stage.
+ * @param items The input items.
+ * @param input Channel the stage reads from.
+ * @param output Channel of the next stage, or nullptr for the last stage.
+ * @param loans The resources lent to every task.
+ * @param report Report receiving the completed and failed items; guarded by outputMutex.
+ */
+void Pipeline::runStage(const std::size_t stage, const std::vector<std::string> &items, Channel &input,
+                        Channel *output, const std::vector<std::pair<std::string, Resource *> > &loans,
+                        Report &report) {
+    const auto &templateStage = stages[stage];
+    std::size_t item = 0;
+    while (input.pop(item)) {
+        Task task(templateStage.name + "(" + items[item] + ")", templateStage.description + " " + items[item],
+                  templateStage.requiredResourcesNames, templateStage.durationInUnits);
+        if (!loans.empty()) task.borrowResources(loans);
+        bool acquired = false;
+        std::string failure;
+        {
+            // Resources held by running tasks come back; without any running task, they never will.
+            std::unique_lock<std::mutex> lock(poolMutex);
+            poolReleased.wait(lock, [this, &task] { return task.canExecute(resourcePool) || runningTasks == 0; });
+            if (task.canExecute(resourcePool)) {
+                try {
+                    task.assignResources(resourcePool);
+                    ++runningTasks;
+                    acquired = true;
+                } catch (const std::exception &e) {
+                    failure = e.what();
+                }
+            } else {
+                failure = "insufficient resources";
+            }
+        }
+        if (acquired) {
+            try {
+                const std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << "  ";
+                task.execute();
+            } catch (const std::exception &e) {
+                failure = e.what();
+            }
+            if (options.unitTime.count() > 0) {
+                std::this_thread::sleep_for(options.unitTime * templateStage.durationInUnits);
+            }
+            {
+                const std::lock_guard<std::mutex> lock(poolMutex);
+                task.releaseResources();
+                --runningTasks;
+            }
+            poolReleased.notify_all();
+        }
+
+        if (!failure.empty()) {
+            const std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << "  Task '" << task.getName() << "' skipped: " << failure << "\n";
+            ++report.failed;
+        } else if (output) {
+            output->push(item);
+        } else {
+            const std::lock_guard<std::mutex> lock(outputMutex);
+            ++report.completed;
+        }
+    }
+    if (output) output->finishProducer();
+}
+
+/**
+ * @brief Pushes every item through the stages and waits until all of them left the pipeline.
+ * @param items The input items, such as source file names.
+ * @param loans The resources the enclosing process lends to every task.
+ * @return The outcome of the run.
+ */
+Pipeline::Report Pipeline::run(const std::vector<std::string> &items,
+                               const std::vector<std::pair<std::string, Resource *> > &loans) {
+    const auto start = std::chrono::steady_clock::now();
+    Report report;
+    // Channel 0 is fed here; channel s + 1 is written by the workers of stage s.
+    std::vector<std::unique_ptr<Channel> > channels;
+    channels.push_back(std::make_unique<Channel>(options.queueCapacity, 1));
+    for (std::size_t stage = 0; stage + 1 < stages.size(); ++stage) {
+        channels.push_back(std::make_unique<Channel>(options.queueCapacity, stages[stage].parallelism));
+    }
+    std::vector<std::thread> workers;
+    for (std::size_t stage = 0; stage < stages.size(); ++stage) {
+        Channel *const output = stage + 1 < stages.size() ? channels[stage + 1].get() : nullptr;
+        for (std::size_t worker = 0; worker < stages[stage].parallelism; ++worker) {
+            workers.emplace_back([this, stage, &items, &channels, output, &loans, &report] {
+                runStage(stage, items, *channels[stage], output, loans, report);
+            });
+        }
+    }
+    for (std::size_t item = 0; item < items.size(); ++item) channels.front()->push(item);
+    channels.front()->finishProducer();
+    for (auto &worker: workers) worker.join();
+    report.elapsedNanoseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return report;
+}
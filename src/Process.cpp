@@ -1,5 +1,33 @@
 #include "Process.h"
+#include "CapacityPlan.h"
+#include "ConsumableResource.h"
+#include "ExecutionMetrics.h"
+#include "ExecutionPlan.h"
+#include "ResourceManager.h"
+#include "ResultCache.h"
+#include "TaskQueue.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Measures the nanoseconds between two time points.
+     * @param from The earlier time point.
+     * @param to The later time point.
+     * @return The elapsed nanoseconds.
+     */
+    std::uint64_t elapsedNanoseconds(const Clock::time_point from, const Clock::time_point to) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+    }
+}
 
 /**
  * @brief Constructs a Process to manage a sequence of tasks.
@@ -13,12 +41,19 @@ Process::Process(const std::string& name, const std::string& description,
                  const std::vector<std::string>& requiredResourcesNames, int durationInUnits)
     : Executable(name, description, requiredResourcesNames, durationInUnits) {}
 
+/**
+ * @brief Destroys the process, its resources and tasks.
+ */
+Process::~Process() = default;
+
 /**
  * @brief Adds a resource to the process's resource pool.
  * @param resource A unique pointer to the resource to add.
  */
 void Process::addResource(std::unique_ptr<Resource> resource) {
     resourcePool.push_back(std::move(resource));
+    executionPlan.reset();
+    if (resourceIndex && !resourceIndex->addResource(*resourcePool.back())) dropResourceIndex();
 }
 
 /**
@@ -27,6 +62,533 @@ void Process::addResource(std::unique_ptr<Resource> resource) {
  */
 void Process::addTask(std::unique_ptr<Executable> task) {
     tasks.push_back(std::move(task));
+    executionPlan.reset();
+    if (!resourceIndex) return;
+    ResourceIndex::Mask mask;
+    if (!resourceIndex->requirementMask(tasks.back()->getRequiredResourcesNames(), mask)) {
+        dropResourceIndex();
+        return;
+    }
+    requirementMasks.push_back(mask);
+}
+
+/**
+ * @brief Retrieves the number of tasks in the process's sequence.
+ * @return The number of tasks added to the process.
+ */
+std::size_t Process::getTaskCount() const {
+    return tasks.size();
+}
+
+/**
+ * @brief Retrieves the process's sequence of tasks.
+ * @return The tasks, in the order they were added.
+ */
+const std::vector<std::unique_ptr<Executable> > &Process::getTasks() const {
+    return tasks;
+}
+
+/**
+ * @brief Retrieves the process's resource pool.
+ * @return The resources, in the order they were added.
+ */
+const std::vector<std::unique_ptr<Resource> > &Process::getResourcePool() const {
+    return resourcePool;
+}
+
+/**
+ * @brief Selects how tasks' required resources are matched against the pool.
+ * @param matching The matching mode; Bitmask falls back to NameScan if the pool has too many names.
+ */
+void Process::setRequirementMatching(const RequirementMatching matching) {
+    if (matching == RequirementMatching::Bitmask) {
+        if (!resourceIndex) buildResourceIndex();
+    } else {
+        dropResourceIndex();
+    }
+}
+
+/**
+ * @brief Retrieves the matching mode in effect.
+ * @return Bitmask if a resource index is maintained, NameScan otherwise.
+ */
+Process::RequirementMatching Process::getRequirementMatching() const {
+    return resourceIndex ? RequirementMatching::Bitmask : RequirementMatching::NameScan;
+}
+
+/**
+ * @brief Builds the resource index and requirement masks, or drops them if the index overflows.
+ */
+void Process::buildResourceIndex() {
+    resourceIndex = std::make_unique<ResourceIndex>();
+    bool complete = resourceIndex->requirementMask(requiredResourcesNames, ownRequirementMask);
+    for (const auto& resource : resourcePool) {
+        complete = complete && resourceIndex->addResource(*resource);
+    }
+    requirementMasks.resize(tasks.size());
+    for (std::size_t index = 0; complete && index < tasks.size(); ++index) {
+        ResourceIndex::Mask mask;
+        complete = resourceIndex->requirementMask(tasks[index]->getRequiredResourcesNames(), mask);
+        requirementMasks.assign(index, mask);
+    }
+    if (!complete) dropResourceIndex();
+}
+
+/**
+ * @brief Detaches the pool from the resource index and discards the index and masks.
+ */
+void Process::dropResourceIndex() {
+    if (!resourceIndex) return;
+    for (const auto& resource : resourcePool) resource->removeAvailabilityListener(resourceIndex.get());
+    resourceIndex.reset();
+    requirementMasks.clear();
+}
+
+/**
+ * @brief Retrieves the number of mask words that can hold registered resource names.
+ * @return The number of leading words of a mask worth checking.
+ */
+std::size_t Process::maskWordCount() const {
+    return (resourceIndex->getGroupCount() + 63) / 64;
+}
+
+/**
+ * @brief Checks whether the pool currently satisfies a task's requirements.
+ * @param index Position of the task, with its loans already borrowed.
+ * @param lentMask Groups the process lends, counted as free in bitmask matching.
+ * @return True if every resource the task requires and does not borrow has an available unit in the pool.
+ */
+bool Process::canRunTask(const std::size_t index, const ResourceIndex::Mask& lentMask) const {
+    const auto& task = tasks[index];
+    // Tasks without requirements go through canExecute so they report it as before.
+    if (task->getRequiredResourcesNames().empty()) return task->canExecute(resourcePool);
+    if (resourceIndex) {
+        auto freeMask = resourceIndex->getFreeMask();
+        freeMask.setAll(lentMask);
+        return requirementMasks.isSatisfied(index, freeMask, maskWordCount());
+    }
+    if (executionPlan) return ExecutionPlan::isSatisfied(executionPlan->getStep(index), *task);
+    return task->canExecute(resourcePool);
+}
+
+/**
+ * @brief Checks whether the delegation mode lends resources of a type.
+ * @param type The resource type.
+ * @return True if resources of that type are lent to tasks.
+ */
+bool Process::lends(const Resource::Type type) const {
+    return runOptions.delegation == ResourceDelegation::All ||
+           (runOptions.delegation == ResourceDelegation::Usable && type == Resource::Type::Usable);
+}
+
+/**
+ * @brief Lists the resources the process holds and lends to its tasks.
+ * @return The required name and resource of each loan, in requirement order.
+ */
+std::vector<std::pair<std::string, Resource*> > Process::collectLoans() const {
+    std::vector<std::pair<std::string, Resource*> > loans;
+    if (runOptions.delegation == ResourceDelegation::None) return loans;
+    // Borrowed resources are lent on, so nested processes inherit them.
+    std::size_t allocated = 0;
+    for (std::size_t requirement = 0; requirement < requiredResourcesNames.size(); ++requirement) {
+        Resource* resource = nullptr;
+        if (isBorrowed(requirement)) {
+            resource = borrowedResources[requirement];
+        } else if (allocated < assignedResources.size()) {
+            resource = assignedResources[allocated++];
+        }
+        if (resource && lends(resource->getResourceType())) {
+            loans.emplace_back(requiredResourcesNames[requirement], resource);
+        }
+    }
+    return loans;
+}
+
+/**
+ * @brief Lists the names of the process's own requirements that it lends to its tasks.
+ * @return One name per loan, in requirement order; names the process cannot allocate are left out.
+ */
+std::vector<std::string> Process::collectLentNames() const {
+    // The process allocates its own requirements from its pool, so the pool tells which of them are lent.
+    // With a shared manager attached, the manager serves them instead.
+    std::vector<std::string> lentNames;
+    for (const auto& resourceName : requiredResourcesNames) {
+        Resource::Type type{};
+        if (resourceManager) {
+            if (!resourceManager->findResourceType(resourceName, type)) continue;
+        } else {
+            const auto resource = std::find_if(resourcePool.begin(), resourcePool.end(), [&resourceName](const auto& candidate) {
+                return candidate->getName() == resourceName;
+            });
+            if (resource == resourcePool.end()) continue;
+            type = (*resource)->getResourceType();
+        }
+        if (lends(type)) lentNames.push_back(resourceName);
+    }
+    return lentNames;
+}
+
+/**
+ * @brief Resolves the requirements and dependencies of the process and its tasks into an ExecutionPlan.
+ * @return The plan execute() follows, listing the tasks that can never run.
+ */
+const ExecutionPlan& Process::compile() {
+    executionPlan = std::make_unique<ExecutionPlan>(resourcePool, tasks, requiredResourcesNames, collectLentNames());
+    return *executionPlan;
+}
+
+/**
+ * @brief Retrieves the plan execute() follows.
+ * @return The current plan, or nullptr if the process is not compiled.
+ */
+const ExecutionPlan* Process::getExecutionPlan() const {
+    return executionPlan.get();
+}
+
+/**
+ * @brief Computes the smallest capacities with which the process and all its tasks can run without skips.
+ * @return The demand and minimum of every resource name of the pool, and the tasks no capacity lets run.
+ */
+CapacityPlan Process::planCapacities() const {
+    // Own requirements served by a shared manager are not drawn from the pool.
+    const auto ownRequirements = resourceManager ? std::vector<std::string>{} : requiredResourcesNames;
+    return CapacityPlan(resourcePool, tasks, name, ownRequirements, collectLentNames(),
+                        runOptions.pipelineStages, runOptions.pipelineInputs.size());
+}
+
+/**
+ * @brief Selects which of its own resources the process lends to its tasks.
+ * @param mode The delegation mode; the plan is discarded as the loans change what tasks can run.
+ */
+void Process::setResourceDelegation(const ResourceDelegation mode) {
+    if (mode != runOptions.delegation) executionPlan.reset();
+    runOptions.delegation = mode;
+}
+
+/**
+ * @brief Retrieves which of its own resources the process lends to its tasks.
+ * @return The delegation mode.
+ */
+Process::ResourceDelegation Process::getResourceDelegation() const {
+    return runOptions.delegation;
+}
+
+/**
+ * @brief Makes run() acquire the process's own requirements from a pool shared with other processes.
+ * @param manager The shared pool, or nullptr to allocate from the process's pool again.
+ */
+void Process::setResourceManager(std::shared_ptr<ResourceManager> manager) {
+    if (manager != resourceManager) executionPlan.reset();
+    resourceManager = std::move(manager);
+}
+
+/**
+ * @brief Retrieves the shared pool run() acquires the process's own resources from.
+ * @return The attached manager, or nullptr if none is attached.
+ */
+const std::shared_ptr<ResourceManager>& Process::getResourceManager() const {
+    return resourceManager;
+}
+
+/**
+ * @brief Makes execute() run the tasks other threads submit to a queue after the process's own tasks.
+ * @param queue The queue to drain, or nullptr to run the process's own tasks only.
+ */
+void Process::setSubmissionQueue(std::shared_ptr<TaskQueue> queue) {
+    submissionQueue = std::move(queue);
+}
+
+/**
+ * @brief Retrieves the queue execute() drains after the process's own tasks.
+ * @return The attached queue, or nullptr if none is attached.
+ */
+const std::shared_ptr<TaskQueue>& Process::getSubmissionQueue() const {
+    return submissionQueue;
+}
+
+/**
+ * @brief Makes sequential execution skip the tasks that already completed with the same declaration.
+ * @param cache The cache to consult, or nullptr to run every task.
+ */
+void Process::setResultCache(std::shared_ptr<ResultCache> cache) {
+    resultCache = std::move(cache);
+}
+
+/**
+ * @brief Retrieves the cache execute() consults.
+ * @return The attached cache, or nullptr if none is attached.
+ */
+const std::shared_ptr<ResultCache>& Process::getResultCache() const {
+    return resultCache;
+}
+
+/**
+ * @brief Makes execute() pull tasks from a generator after the process's own tasks, one at a time.
+ * @param source Generator returning the next task, or nullptr once exhausted; an empty function detaches it.
+ */
+void Process::setTaskSource(TaskSource source) {
+    taskSource = std::move(source);
+}
+
+/**
+ * @brief Appends a stage to the pipeline that execute() runs the pipeline inputs through.
+ * @param stage The stage.
+ * @throw std::invalid_argument If the stage has no name, a non-positive duration or no worker.
+ */
+void Process::addPipelineStage(Pipeline::Stage stage) {
+    if (stage.name.empty()) throw std::invalid_argument("Pipeline stage name cannot be empty");
+    if (stage.durationInUnits <= 0) {
+        throw std::invalid_argument("Duration of pipeline stage '" + stage.name + "' must be positive");
+    }
+    if (stage.parallelism == 0) {
+        throw std::invalid_argument("Pipeline stage '" + stage.name + "' needs at least one worker");
+    }
+    runOptions.pipelineStages.push_back(std::move(stage));
+}
+
+/**
+ * @brief Adds an item, such as a source file, to push through the pipeline stages.
+ * @param item The item.
+ */
+void Process::addPipelineInput(const std::string& item) {
+    runOptions.pipelineInputs.push_back(item);
+}
+
+/**
+ * @brief Sets the queue capacity and unit time of pipeline runs.
+ * @param options The pipeline settings.
+ * @throw std::invalid_argument If the queue capacity is zero.
+ */
+void Process::setPipelineOptions(const Pipeline::Options& options) {
+    if (options.queueCapacity == 0) throw std::invalid_argument("Pipeline queues need a positive capacity");
+    runOptions.pipelineOptions = options;
+}
+
+/**
+ * @brief Retrieves the number of stage tasks the pipeline instantiates per execution.
+ * @return The number of pipeline stages times the number of pipeline inputs.
+ */
+std::size_t Process::getPipelineTaskCount() const {
+    return runOptions.pipelineStages.size() * runOptions.pipelineInputs.size();
+}
+
+/**
+ * @brief Selects how execute() schedules the tasks.
+ * @param mode The scheduling mode.
+ */
+void Process::setScheduling(const Scheduling mode) {
+    runOptions.scheduling = mode;
+}
+
+/**
+ * @brief Retrieves how execute() schedules the tasks.
+ * @return The scheduling mode.
+ */
+Process::Scheduling Process::getScheduling() const {
+    return runOptions.scheduling;
+}
+
+/**
+ * @brief Selects which ready tasks event-driven runs start when they compete for resources.
+ * @param mode The admission policy.
+ */
+void Process::setAdmission(const EventDrivenScheduler::Admission mode) {
+    runOptions.admission = mode;
+}
+
+/**
+ * @brief Retrieves which ready tasks event-driven runs start when they compete for resources.
+ * @return The admission policy.
+ */
+EventDrivenScheduler::Admission Process::getAdmission() const {
+    return runOptions.admission;
+}
+
+/**
+ * @brief Sets the usable resource capacity, such as 3 GHz, that task durations are measured on.
+ * @param capacity The reference capacity, or zero to leave durations unscaled.
+ * @throw std::invalid_argument If capacity is negative.
+ */
+void Process::setReferenceCapacity(const int capacity) {
+    if (capacity < 0) throw std::invalid_argument("Reference capacity of '" + getName() + "' cannot be negative");
+    runOptions.referenceCapacity = capacity;
+}
+
+/**
+ * @brief Retrieves the usable resource capacity that task durations are measured on.
+ * @return The reference capacity, or zero if durations are not scaled.
+ */
+int Process::getReferenceCapacity() const {
+    return runOptions.referenceCapacity;
+}
+
+/**
+ * @brief Sets the weight of the process when it shares a machine with other processes.
+ * @param weight The weight.
+ * @throw std::invalid_argument If weight is not a positive finite number.
+ */
+void Process::setShareWeight(const double weight) {
+    if (!(weight > 0) || !std::isfinite(weight)) {
+        throw std::invalid_argument("Share weight of '" + getName() + "' must be a positive number");
+    }
+    runOptions.shareWeight = weight;
+}
+
+/**
+ * @brief Retrieves the weight of the process when it shares a machine with other processes.
+ * @return The weight, 1 unless set.
+ */
+double Process::getShareWeight() const {
+    return runOptions.shareWeight;
+}
+
+/**
+ * @brief Schedules a refill of a consumable resource for event-driven runs.
+ * @param resourceName Name of the consumable resource in the pool.
+ * @param units Units restored, up to the resource's total capacity.
+ * @param time Simulated time of the refill.
+ * @throw std::invalid_argument If units is not positive or time is negative.
+ */
+void Process::addReplenishment(const std::string& resourceName, const int units, const int time) {
+    if (units <= 0) throw std::invalid_argument("Replenishment of '" + resourceName + "' must be positive");
+    if (time < 0) throw std::invalid_argument("Replenishment time of '" + resourceName + "' cannot be negative");
+    runOptions.replenishments.push_back(EventDrivenScheduler::Replenishment{resourceName, units, time});
+}
+
+/**
+ * @brief Simulates the tasks over time with an EventDrivenScheduler, whatever the scheduling mode.
+ * @return The outcome of the simulation.
+ */
+EventDrivenScheduler::Report Process::simulate() const {
+    EventDrivenScheduler scheduler(resourcePool, tasks, runOptions.replenishments, runOptions.admission,
+                                   runOptions.referenceCapacity);
+    return scheduler.run();
+}
+
+/**
+ * @brief Attaches metrics that record the executions of this process.
+ * @param executionMetrics The metrics to record into, or nullptr to stop recording.
+ */
+void Process::setMetrics(std::shared_ptr<ExecutionMetrics> executionMetrics) {
+    metrics = std::move(executionMetrics);
+}
+
+/**
+ * @brief Retrieves the metrics attached to this process.
+ * @return The attached metrics, or nullptr if none are attached.
+ */
+const std::shared_ptr<ExecutionMetrics>& Process::getMetrics() const {
+    return metrics;
+}
+
+/**
+ * @brief Writes the attached metrics as JSON, labelled with this process's task and resource names.
+ * @param output The stream to write to.
+ * @throw std::logic_error If no metrics are attached.
+ */
+void Process::writeMetricsJson(std::ostream& output) const {
+    if (!metrics) throw std::logic_error("No metrics attached to process '" + name + "'");
+    std::vector<std::string> taskNames;
+    taskNames.reserve(tasks.size());
+    for (const auto& task : tasks) taskNames.push_back(task->getName());
+    std::vector<std::string> resourceNames;
+    resourceNames.reserve(resourcePool.size());
+    for (const auto& resource : resourcePool) resourceNames.push_back(resource->getName());
+    metrics->writeJson(output, name, taskNames, resourceNames);
+}
+
+/**
+ * @brief Records contention for every pool resource that kept an executable from running.
+ * @param executable The executable that could not acquire its resources.
+ */
+void Process::recordContention(const Executable& executable) const {
+    const auto& requiredNames = executable.getRequiredResourcesNames();
+    for (std::size_t requirement = 0; requirement < requiredNames.size(); ++requirement) {
+        if (executable.isBorrowed(requirement)) continue;
+        const auto& resourceName = requiredNames[requirement];
+        const bool anyAvailable = std::any_of(resourcePool.begin(), resourcePool.end(), [&resourceName](const auto& resource) {
+            return resource->getName() == resourceName && resource->isAvailableForUse();
+        });
+        if (anyAvailable) continue;
+        for (std::size_t position = 0; position < resourcePool.size(); ++position) {
+            if (resourcePool[position]->getName() == resourceName) metrics->recordContention(position);
+        }
+    }
+}
+
+/**
+ * @brief Runs a task that is not part of the plan, such as a pulled or submitted one, against the pool.
+ * @param task The task to run.
+ * @param loans The resources the process lends, borrowed by the task.
+ * @param origin How the task reached the process, used in messages.
+ */
+void Process::runDetachedTask(Executable& task, const std::vector<std::pair<std::string, Resource*>>& loans,
+                              const char* origin) const {
+    TraceRecorder *const trace = TraceRecorder::active();
+    bool traced = false;
+    try {
+        if (!task.getDependencyNames().empty()) {
+            std::cout << "  Task '" << task.getName() << "' skipped: " << origin << " tasks cannot have dependencies\n";
+            return;
+        }
+        const auto cacheKey = resultCache ? ResultCache::key(task) : ResultCache::Key{};
+        if (resultCache && resultCache->lookup(cacheKey)) {
+            std::cout << "  Task '" << task.getName() << "' up to date\n";
+            return;
+        }
+        if (!loans.empty()) task.borrowResources(loans);
+        if (task.canExecute(resourcePool)) {
+            if (trace) {
+                trace->begin(TraceRecorder::Category::Task, task.getName());
+                traced = true;
+            }
+            task.assignResources(resourcePool);
+            std::cout << "  ";
+            task.execute();
+            task.releaseResources();
+            if (resultCache) resultCache->store(cacheKey, task.getName());
+            if (traced) {
+                trace->end(TraceRecorder::Category::Task, task.getName());
+                traced = false;
+            }
+        } else {
+            std::cout << "  Task '" << task.getName() << "' skipped: insufficient resources\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "  Error in '" << task.getName() << "': " << e.what() << "\n";
+        if (traced) trace->end(TraceRecorder::Category::Task, task.getName());
+    }
+    if (!loans.empty()) task.returnBorrowedResources();
+}
+
+/**
+ * @brief Runs the tasks pulled from the task source, then those submitted to the queue until it is closed.
+ * @param loans The resources the process lends, borrowed by each task.
+ */
+void Process::runDetachedTasks(const std::vector<std::pair<std::string, Resource*>>& loans) const {
+    // Nothing refers to a pulled or submitted task once it ran, so each is freed before the next one arrives.
+    if (taskSource) {
+        while (auto task = taskSource()) runDetachedTask(*task, loans, "pulled");
+    }
+    if (submissionQueue) {
+        std::unique_ptr<Executable> task;
+        while (submissionQueue->pop(task)) {
+            runDetachedTask(*task, loans, "submitted");
+            task.reset();
+        }
+    }
+}
+
+/**
+ * @brief Pushes the pipeline inputs through the pipeline stages and reports the outcome.
+ * @param loans The resources the process lends, borrowed by every stage task.
+ */
+void Process::runPipeline(const std::vector<std::pair<std::string, Resource*>>& loans) const {
+    Pipeline pipeline(resourcePool, runOptions.pipelineStages, runOptions.pipelineOptions);
+    const auto report = pipeline.run(runOptions.pipelineInputs, loans);
+    std::cout << "  Pipeline: " << report.completed << " of " << runOptions.pipelineInputs.size()
+              << " inputs through " << runOptions.pipelineStages.size() << " stages (" << report.failed
+              << " failed)\n";
 }
 
 /**
@@ -34,32 +596,354 @@ void Process::addTask(std::unique_ptr<Executable> task) {
  * @throw std::runtime_error If resources are not properly assigned or tasks fail.
  */
 void Process::execute() const {
-    if (!requiredResourcesNames.empty() && assignedResources.size() != requiredResourcesNames.size()) {
+    if (!requiredResourcesNames.empty() && assignedResources.size() + borrowedCount != requiredResourcesNames.size()) {
         throw std::runtime_error("Resources not properly assigned for process '" + name + "'");
     }
+    const auto executeStart = Clock::now();
+    TraceRecorder *const trace = TraceRecorder::active();
+    if (trace) trace->begin(TraceRecorder::Category::Process, name);
     std::cout << "Executing process '" << name << ": " << description
               << " (Duration: " << durationInUnits << " units)\n";
-    if (!assignedResources.empty()) {
-        for (const auto* resource : assignedResources) {
-            resource->use();
+    useResources();
+
+    // Loans are collected once; tasks borrow them instead of allocating from the pool.
+    const auto loans = collectLoans();
+    ResourceIndex::Mask lentMask;
+    if (resourceIndex && !loans.empty()) {
+        std::vector<std::string> lentNames;
+        for (const auto& loan : loans) lentNames.push_back(loan.first);
+        resourceIndex->requirementMask(lentNames, lentMask);
+    }
+
+    if (runOptions.scheduling == Scheduling::EventDriven) {
+        // Simulated completions are not recorded, so rerunChanged() reruns every task after this run.
+        lastRunCompleted.clear();
+        if (!loans.empty()) {
+            for (const auto& task : tasks) task->borrowResources(loans);
+        }
+        const auto report = simulate();
+        lastSimulation = report;
+        if (!loans.empty()) {
+            for (const auto& task : tasks) task->returnBorrowedResources();
+        }
+        std::cout << "  Makespan: " << report.makespan << " units (" << report.completed << " completed, "
+                  << report.skipped << " skipped, " << report.failed << " failed, "
+                  << static_cast<int>(report.utilisation * 100 + 0.5) << "% usable utilisation)\n";
+        runDetachedTasks(loans);
+        if (!runOptions.pipelineStages.empty()) runPipeline(loans);
+        if (metrics) metrics->recordProcessRun(elapsedNanoseconds(executeStart, Clock::now()));
+        if (trace) trace->end(TraceRecorder::Category::Process, name);
+        return;
+    }
+
+    // Completed tasks are only tracked when some task declares dependencies: by position when compiled,
+    // by name otherwise.
+    const bool tracksDependencies = std::any_of(tasks.begin(), tasks.end(), [](const auto& task) {
+        return !task->getDependencyNames().empty();
+    });
+    std::unordered_set<std::string> completedTasks;
+    std::vector<char> completedSteps(tracksDependencies && executionPlan ? tasks.size() : 0, 0);
+    // Every completion is also recorded by position for rerunChanged().
+    lastRunCompleted.assign(tasks.size(), 0);
+    const auto markCompleted = [&](const std::size_t index) {
+        lastRunCompleted[index] = 1;
+        if (!tracksDependencies) return;
+        if (executionPlan) {
+            completedSteps[index] = 1;
+        } else {
+            completedTasks.insert(tasks[index]->getName());
+        }
+    };
+
+    // Cache keys fold in the keys of every earlier task carrying a dependency's name, when there are any.
+    std::unordered_map<std::string, ResultCache::Key> cacheKeysByName;
+
+    // Metrics identify resources by pool position; the lookup table is only built when recording.
+    std::unordered_map<const Resource*, std::size_t> poolPositions;
+    if (metrics) {
+        for (std::size_t position = 0; position < resourcePool.size(); ++position) {
+            poolPositions.emplace(resourcePool[position].get(), position);
         }
     }
 
-    for (const auto& task : tasks) {
+    // With bitmask matching, one batch finds every task the current free mask satisfies. Until a resource
+    // name gains availability the batch stays a superset of the runnable tasks, so tasks outside it are
+    // skipped without a check and tasks in it are rechecked against the live mask.
+    std::vector<std::size_t> readyTasks;
+    std::size_t nextReady = 0;
+    ResourceIndex::Mask batchFreeMask;
+    bool batchValid = false;
+
+    for (std::size_t index = 0; index < tasks.size(); ++index) {
+        const auto& task = tasks[index];
+        bool traced = false;
         try {
-            if (task->canExecute(resourcePool)) {
-                task->assignResources(resourcePool);
+            const ExecutionPlan::Step* step = executionPlan ? &executionPlan->getStep(index) : nullptr;
+            if (step && !step->infeasibility.empty()) {
+                std::cout << "  Task '" << task->getName() << "' skipped: " << step->infeasibility << "\n";
+                if (metrics) metrics->recordTaskSkipped(index);
+                continue;
+            }
+            if (tracksDependencies) {
+                const auto& dependencies = task->getDependencyNames();
+                auto pending = dependencies.end();
+                if (step) {
+                    for (std::size_t dependency = 0; dependency < step->dependencies.size(); ++dependency) {
+                        const bool completed = executionPlan->anyNamed(step->dependencies[dependency],
+                                                                       [&completedSteps](const std::size_t candidate) {
+                                                                           return completedSteps[candidate] != 0;
+                                                                       });
+                        if (!completed) {
+                            pending = dependencies.begin() + static_cast<std::ptrdiff_t>(dependency);
+                            break;
+                        }
+                    }
+                } else {
+                    pending = std::find_if(dependencies.begin(), dependencies.end(),
+                                           [&completedTasks](const std::string& dependency) {
+                                               return completedTasks.count(dependency) == 0;
+                                           });
+                }
+                if (pending != dependencies.end()) {
+                    std::cout << "  Task '" << task->getName() << "' skipped: dependency '" << *pending
+                              << "' not completed\n";
+                    if (metrics) metrics->recordTaskSkipped(index);
+                    continue;
+                }
+            }
+            ResultCache::Key cacheKey{};
+            if (resultCache) {
+                cacheKey = ResultCache::key(*task);
+                for (const auto& dependency : task->getDependencyNames()) {
+                    const auto dependencyKey = cacheKeysByName.find(dependency);
+                    if (dependencyKey != cacheKeysByName.end()) {
+                        cacheKey = ResultCache::combine(cacheKey, dependencyKey->second);
+                    }
+                }
+                if (tracksDependencies) {
+                    auto& nameKey = cacheKeysByName[task->getName()];
+                    nameKey = ResultCache::combine(nameKey, cacheKey);
+                }
+            }
+            if (!rerunSelection.empty() && !rerunSelection[index]) {
+                std::cout << "  Task '" << task->getName() << "' reused from the previous run\n";
+                markCompleted(index);
+                continue;
+            }
+            if (resultCache && resultCache->lookup(cacheKey)) {
+                std::cout << "  Task '" << task->getName() << "' up to date\n";
+                markCompleted(index);
+                continue;
+            }
+            if (!loans.empty()) task->borrowResources(loans);
+            bool runnable = false;
+            if (resourceIndex) {
+                auto freeMask = resourceIndex->getFreeMask();
+                freeMask.setAll(lentMask);
+                if (!batchValid || !batchFreeMask.containsAll(freeMask)) {
+                    batchFreeMask = freeMask;
+                    EligibilityKernel::selectReady(requirementMasks, index, batchFreeMask, maskWordCount(),
+                                                   readyTasks);
+                    nextReady = 0;
+                    batchValid = true;
+                }
+                while (nextReady < readyTasks.size() && readyTasks[nextReady] < index) ++nextReady;
+                runnable = nextReady < readyTasks.size() && readyTasks[nextReady] == index &&
+                           canRunTask(index, lentMask);
+            } else {
+                runnable = canRunTask(index, lentMask);
+            }
+            if (runnable) {
+                const auto taskStart = metrics ? Clock::now() : Clock::time_point{};
+                if (trace) {
+                    trace->begin(TraceRecorder::Category::Task, task->getName());
+                    traced = true;
+                }
+                if (step) {
+                    task->assignResources(step->requirements);
+                } else {
+                    task->assignResources(resourcePool);
+                }
+                if (metrics) {
+                    metrics->recordTaskStarted(index, elapsedNanoseconds(executeStart, taskStart));
+                    for (const auto* resource : task->getAssignedResources()) {
+                        metrics->recordAcquisition(poolPositions.at(resource));
+                    }
+                }
                 std::cout << "  ";
                 task->execute();
+                if (metrics) {
+                    const auto heldFor = elapsedNanoseconds(taskStart, Clock::now());
+                    for (const auto* resource : task->getAssignedResources()) {
+                        metrics->recordHold(poolPositions.at(resource), heldFor);
+                    }
+                    metrics->recordTaskCompleted(index, heldFor);
+                }
                 task->releaseResources();
+                if (resultCache) resultCache->store(cacheKey, task->getName());
+                if (traced) {
+                    trace->end(TraceRecorder::Category::Task, task->getName());
+                    traced = false;
+                }
+                markCompleted(index);
             } else {
                 std::cout << "  Task '" << task->getName() << "' skipped: insufficient resources\n";
+                if (metrics) {
+                    metrics->recordTaskSkipped(index);
+                    recordContention(*task);
+                }
             }
         } catch (const std::exception& e) {
             std::cerr << "  Error in '" << task->getName() << "': " << e.what() << "\n";
+            if (traced) trace->end(TraceRecorder::Category::Task, task->getName());
+            if (metrics) metrics->recordTaskFailed(index);
         }
+        if (!loans.empty()) task->returnBorrowedResources();
     }
+    runDetachedTasks(loans);
+    if (!runOptions.pipelineStages.empty()) runPipeline(loans);
 
+    if (metrics) {
+        // The process's own allocations from its pool are held for the whole execution.
+        const auto executedFor = elapsedNanoseconds(executeStart, Clock::now());
+        for (const auto* resource : assignedResources) {
+            const auto position = poolPositions.find(resource);
+            if (position == poolPositions.end()) continue;
+            metrics->recordAcquisition(position->second);
+            metrics->recordHold(position->second, executedFor);
+        }
+        metrics->recordProcessRun(executedFor);
+    }
+    if (trace) trace->end(TraceRecorder::Category::Process, name);
+}
+
+/**
+ * @brief Creates an independent copy of the process's definition, as cloneProcess() does.
+ * @return The copy.
+ */
+std::unique_ptr<Executable> Process::clone() const {
+    return cloneProcess();
+}
+
+/**
+ * @brief Creates an independent copy of the process's definition, optionally with other capacities.
+ * @param capacities Capacity of consumables and unit count of usable resources, by resource name.
+ * @return The copy.
+ * @throw std::invalid_argument If a name is not in the pool or a capacity is not positive.
+ */
+std::unique_ptr<Process> Process::cloneProcess(const std::map<std::string, int>& capacities) const {
+    for (const auto& [resourceName, capacity] : capacities) {
+        if (capacity <= 0) throw std::invalid_argument("Capacity for resource '" + resourceName + "' must be positive");
+        if (std::none_of(resourcePool.begin(), resourcePool.end(), [&resourceName](const auto& resource) {
+            return resource->getName() == resourceName;
+        })) {
+            throw std::invalid_argument("No resource '" + resourceName + "' in process '" + name + "'");
+        }
+    }
+    auto copy = std::make_unique<Process>(name, description, requiredResourcesNames, durationInUnits);
+    copy->copyDeclarationsFrom(*this);
+    std::unordered_set<std::string> resizedUsables;
+    for (const auto& resource : resourcePool) {
+        const auto capacity = capacities.find(resource->getName());
+        if (capacity == capacities.end()) {
+            copy->addResource(resource->clone());
+        } else if (resource->getResourceType() == Resource::Type::Consumable) {
+            copy->addResource(static_cast<const ConsumableResource&>(*resource).cloneWithCapacity(capacity->second));
+        } else if (resizedUsables.insert(capacity->first).second) {
+            for (int unit = 0; unit < capacity->second; ++unit) copy->addResource(resource->clone());
+        }
+    }
+    for (const auto& task : tasks) copy->addTask(task->clone());
+    copy->setRequirementMatching(getRequirementMatching());
+    copy->runOptions = runOptions;
+    return copy;
+}
+
+/**
+ * @brief Retrieves the outcome of the last event-driven execution.
+ * @return The report of the simulation, or nothing if the last run did not simulate.
+ */
+const std::optional<EventDrivenScheduler::Report>& Process::getLastSimulation() const {
+    return lastSimulation;
+}
+
+/**
+ * @brief Captures the state of the pool resources and of the tasks.
+ * @return The snapshot.
+ */
+Process::Snapshot Process::snapshot() const {
+    Snapshot snapshot;
+    snapshot.resources.reserve(resourcePool.size());
+    for (const auto& resource : resourcePool) snapshot.resources.push_back(resource->saveState());
+    snapshot.completedTasks = lastRunCompleted;
+    return snapshot;
+}
+
+/**
+ * @brief Puts back a state captured by snapshot(), so the next run starts from it.
+ * @param snapshot A snapshot of this process.
+ * @throw std::invalid_argument If the snapshot does not match the pool or the tasks of the process.
+ */
+void Process::restore(const Snapshot& snapshot) {
+    if (snapshot.resources.size() != resourcePool.size() || snapshot.completedTasks.size() > tasks.size()) {
+        throw std::invalid_argument("Snapshot does not match process '" + name + "'");
+    }
+    forgetResources();
+    for (const auto& task : tasks) task->forgetResources();
+    for (std::size_t position = 0; position < resourcePool.size(); ++position) {
+        resourcePool[position]->restoreState(snapshot.resources[position]);
+    }
+    lastRunCompleted = snapshot.completedTasks;
+}
+
+/**
+ * @brief Runs again only the tasks affected by changed inputs, reusing the previous run for the others.
+ * @param changedInputs Names of the artifacts that changed since the previous run.
+ * @return The number of tasks selected to run again.
+ */
+std::size_t Process::rerunChanged(const std::vector<std::string>& changedInputs) {
+    // Tasks only depend on earlier tasks, so one pass in order propagates every change downstream.
+    std::unordered_set<std::string> changedArtifacts(changedInputs.begin(), changedInputs.end());
+    std::unordered_set<std::string> dirtyNames;
+    std::vector<char> selection(tasks.size(), 0);
+    std::size_t dirtyCount = 0;
+    for (std::size_t index = 0; index < tasks.size(); ++index) {
+        const auto& task = tasks[index];
+        const auto& inputs = task->getInputNames();
+        const auto& dependencies = task->getDependencyNames();
+        const bool dirty = index >= lastRunCompleted.size() || lastRunCompleted[index] == 0 ||
+                           std::any_of(inputs.begin(), inputs.end(), [&changedArtifacts](const std::string& input) {
+                               return changedArtifacts.count(input) != 0;
+                           }) ||
+                           std::any_of(dependencies.begin(), dependencies.end(),
+                                       [&dirtyNames](const std::string& dependency) {
+                                           return dirtyNames.count(dependency) != 0;
+                                       });
+        if (!dirty) continue;
+        selection[index] = 1;
+        ++dirtyCount;
+        dirtyNames.insert(task->getName());
+        changedArtifacts.insert(task->getOutputNames().begin(), task->getOutputNames().end());
+    }
+    if (dirtyCount == 0) return 0;
+    rerunSelection = std::move(selection);
+    run();
+    rerunSelection.clear();
+    return dirtyCount;
+}
+
+/**
+ * @brief Lists the artifacts produced by the tasks that completed in the last sequential execution.
+ * @return The output names of the completed tasks, in task order.
+ */
+std::vector<std::string> Process::getProducedOutputs() const {
+    std::vector<std::string> produced;
+    for (std::size_t index = 0; index < lastRunCompleted.size() && index < tasks.size(); ++index) {
+        if (lastRunCompleted[index] == 0) continue;
+        const auto& outputs = tasks[index]->getOutputNames();
+        produced.insert(produced.end(), outputs.begin(), outputs.end());
+    }
+    return produced;
 }
 
 /**
@@ -67,15 +951,37 @@ void Process::execute() const {
  * @throw std::runtime_error If insufficient resources are available to start.
  */
 void Process::run() {
+    lastSimulation.reset();
     try {
-        if (requiredResourcesNames.empty() || canExecute(resourcePool)) {
+        if (!executionPlan) compile();
+        if (resourceManager) {
+            // The lease returns the shared resources even if execution throws.
+            auto lease = resourceManager->acquire(requiredResourcesNames);
+            assignedResources = lease.getResources();
+            try {
+                execute();
+            } catch (...) {
+                assignedResources.clear();
+                throw;
+            }
+            assignedResources.clear();
+            std::cout << "Process '" << name << "' completed.\n";
+            return;
+        }
+        const auto& ownStep = executionPlan->getOwnStep();
+        if (!ownStep.infeasibility.empty()) {
+            throw std::runtime_error("'" + name + "' can never start: it " + ownStep.infeasibility);
+        }
+        if (requiredResourcesNames.empty() || (resourceIndex ? resourceIndex->isSatisfied(ownRequirementMask)
+                                                             : ExecutionPlan::isSatisfied(ownStep))) {
             if (!requiredResourcesNames.empty()) {
-                assignResources(resourcePool);
+                assignResources(ownStep.requirements);
             }
             execute();
             releaseResources();
             std::cout << "Process '" << name << "' completed.\n";
         } else {
+            if (metrics) recordContention(*this);
             throw std::runtime_error("Insufficient resources in pool to start '" + name + "'");
         }
     } catch (const std::exception& e) {
@@ -1,4 +1,5 @@
 #include "Resource.h"
+#include <algorithm>
 
 /**
  * @brief Constructor for the Resource with the given name and type.
@@ -22,3 +23,49 @@ std::string Resource::getName() const { return name;}
  * @return The type of the resource (Consumable or Usable).
  */
 Resource::Type Resource::getResourceType() const { return resourceType; }
+
+/**
+ * @brief Updates the availability flag, notifying the listeners if it changed.
+ * @param available The new availability of the resource.
+ */
+void Resource::setAvailability(const bool available) {
+    if (isAvailable == available) return;
+    isAvailable = available;
+    for (const auto &[listener, tag]: availabilityListeners) listener->availabilityChanged(tag, available);
+}
+
+/**
+ * @brief Attaches an observer notified of availability changes.
+ * @param listener The observer; it must be detached before it is destroyed.
+ * @param tag Value passed back to the observer to identify this resource.
+ */
+void Resource::addAvailabilityListener(AvailabilityListener *listener, const std::size_t tag) {
+    availabilityListeners.emplace_back(listener, tag);
+}
+
+/**
+ * @brief Detaches an observer; detaching one that is not attached has no effect.
+ * @param listener The observer to detach.
+ */
+void Resource::removeAvailabilityListener(const AvailabilityListener *listener) {
+    availabilityListeners.erase(std::remove_if(availabilityListeners.begin(), availabilityListeners.end(),
+                                               [listener](const auto &entry) { return entry.first == listener; }),
+                                availabilityListeners.end());
+}
+
+/**
+ * @brief Captures the mutable state of the resource.
+ * @return The state, to be passed back to restoreState().
+ */
+Resource::State Resource::saveState() const {
+    return State{isAvailable, 0};
+}
+
+/**
+ * @brief Puts back a state captured by saveState(), notifying the listeners if availability changes.
+ * @param state The state to restore.
+ * @throw std::invalid_argument If the state does not fit the resource.
+ */
+void Resource::restoreState(const State &state) {
+    setAvailability(state.available);
+}
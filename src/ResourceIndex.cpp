@@ -0,0 +1,91 @@
+#include "ResourceIndex.h"
+
+/**
+ * @brief Retrieves the group of a name, registering it if it is new.
+ * @param name The resource name.
+ * @param group Receives the group of the name.
+ * @return False if the name is new and no group is left.
+ */
+bool ResourceIndex::registerName(const std::string &name, std::size_t &group) {
+    const auto existing = groupsByName.find(name);
+    if (existing != groupsByName.end()) {
+        group = existing->second;
+        return true;
+    }
+    if (availableCounts.size() == MaxGroups) {
+        overflowed = true;
+        return false;
+    }
+    group = availableCounts.size();
+    groupsByName.emplace(name, group);
+    availableCounts.push_back(0);
+    return true;
+}
+
+/**
+ * @brief Adds a resource to its name's group and starts observing its availability.
+ * @param resource The resource to observe; it must outlive the index or be detached first.
+ * @return False if the index overflowed; the resource is then not observed.
+ */
+bool ResourceIndex::addResource(Resource &resource) {
+    std::size_t group = 0;
+    if (!registerName(resource.getName(), group)) return false;
+    resource.addAvailabilityListener(this, group);
+    if (resource.isAvailableForUse()) availabilityChanged(group, true);
+    return true;
+}
+
+/**
+ * @brief Builds the mask of a list of required resource names.
+ * @param names The required resource names.
+ * @param mask Receives the groups of the names.
+ * @return False if the index overflowed.
+ */
+bool ResourceIndex::requirementMask(const std::vector<std::string> &names, Mask &mask) {
+    mask = Mask{};
+    for (const auto &name: names) {
+        std::size_t group = 0;
+        if (!registerName(name, group)) return false;
+        mask.set(group);
+    }
+    return true;
+}
+
+/**
+ * @brief Retrieves the groups that currently have an available resource.
+ * @return The live free mask.
+ */
+const ResourceIndex::Mask &ResourceIndex::getFreeMask() const {
+    return freeMask;
+}
+
+/**
+ * @brief Retrieves the number of distinct names registered so far.
+ * @return The number of groups in use; only bits below it can be set.
+ */
+std::size_t ResourceIndex::getGroupCount() const {
+    return availableCounts.size();
+}
+
+/**
+ * @brief Checks whether more distinct names were registered than a mask can hold.
+ * @return True if the index can no longer answer requirement checks.
+ */
+bool ResourceIndex::isOverflowed() const {
+    return overflowed;
+}
+
+/**
+ * @brief Updates the available count and free bit of a resource's group.
+ * @param tag The group of the resource.
+ * @param available True if the resource became available, false if it became unavailable.
+ */
+void ResourceIndex::availabilityChanged(const std::size_t tag, const bool available) {
+    auto &count = availableCounts[tag];
+    count += available ? 1 : -1;
+    if (count > 0) {
+        freeMask.set(tag);
+    } else {
+        freeMask.reset(tag);
+    }
+}
@@ -0,0 +1,257 @@
+#include "ResourceManager.h"
+#include "ConsumableResource.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a lease over resources the manager already allocated.
+ * @param manager The manager the resources return to, or nullptr for an empty lease.
+ * @param resources The resources, in requirement order.
+ */
+ResourceManager::Lease::Lease(ResourceManager *manager, std::vector<Resource *> resources)
+    : manager(manager), resources(std::move(resources)) {}
+
+/**
+ * @brief Releases the resources still held.
+ */
+ResourceManager::Lease::~Lease() {
+    release();
+}
+
+/**
+ * @brief Takes over the resources of another lease.
+ * @param other The lease to move from; it no longer holds anything.
+ */
+ResourceManager::Lease::Lease(Lease &&other) noexcept
+    : manager(other.manager), resources(std::move(other.resources)) {
+    other.manager = nullptr;
+    other.resources.clear();
+}
+
+/**
+ * @brief Releases the resources held, then takes over those of another lease.
+ * @param other The lease to move from; it no longer holds anything.
+ * @return This lease.
+ */
+ResourceManager::Lease &ResourceManager::Lease::operator=(Lease &&other) noexcept {
+    if (this != &other) {
+        release();
+        manager = other.manager;
+        resources = std::move(other.resources);
+        other.manager = nullptr;
+        other.resources.clear();
+    }
+    return *this;
+}
+
+/**
+ * @brief Retrieves the resources held.
+ * @return The resources, in requirement order; empty once released.
+ */
+const std::vector<Resource *> &ResourceManager::Lease::getResources() const {
+    return resources;
+}
+
+/**
+ * @brief Returns the resources to the manager before the lease is destroyed.
+ */
+void ResourceManager::Lease::release() {
+    if (manager && !resources.empty()) manager->release(resources);
+    manager = nullptr;
+    resources.clear();
+}
+
+/**
+ * @brief Constructs an empty manager.
+ * @param shardCount Number of shards the names are spread over.
+ * @throw std::invalid_argument If shardCount is zero.
+ */
+ResourceManager::ResourceManager(const std::size_t shardCount) : shards(shardCount) {
+    if (shardCount == 0) throw std::invalid_argument("A resource manager needs at least one shard");
+}
+
+/**
+ * @brief Retrieves the shard of a name.
+ * @param name The resource name.
+ * @return Position of the shard holding the resources of that name.
+ */
+std::size_t ResourceManager::shardOf(const std::string &name) const {
+    return std::hash<std::string>{}(name) % shards.size();
+}
+
+/**
+ * @brief Adds a resource to the group of its name.
+ * @param resource The resource; the manager takes ownership.
+ */
+void ResourceManager::addResource(std::unique_ptr<Resource> resource) {
+    auto &shard = shards[shardOf(resource->getName())];
+    {
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.groups[resource->getName()].push_back(std::move(resource));
+        ++shard.releaseCount;
+    }
+    shard.released.notify_all();
+}
+
+/**
+ * @brief Allocates a resource for every name if all of them can be served right now.
+ * @param names The required resource names.
+ * @param resources Receives the allocated resources, in requirement order, on success.
+ * @param blockedShard Receives the shard of the first name that could not be served.
+ * @param seenReleases Receives the release count of that shard when it was checked.
+ * @return True if the resources were allocated.
+ * @throw std::invalid_argument If a name is unknown or required more often than its group can ever supply.
+ */
+bool ResourceManager::tryAllocate(const std::vector<std::string> &names, std::vector<Resource *> &resources,
+                                  std::size_t &blockedShard, std::uint64_t &seenReleases) {
+    // Shards are always locked in increasing order, so two acquisitions never wait on each other's locks.
+    std::vector<std::size_t> nameShards;
+    nameShards.reserve(names.size());
+    for (const auto &name: names) nameShards.push_back(shardOf(name));
+    auto lockOrder = nameShards;
+    std::sort(lockOrder.begin(), lockOrder.end());
+    lockOrder.erase(std::unique(lockOrder.begin(), lockOrder.end()), lockOrder.end());
+    std::vector<std::unique_lock<std::mutex> > locks;
+    locks.reserve(lockOrder.size());
+    for (const auto shard: lockOrder) locks.emplace_back(shards[shard].mutex);
+
+    // Resources are chosen before any is allocated: a consumable unit cannot be given back once taken.
+    std::vector<Resource *> chosen;
+    chosen.reserve(names.size());
+    for (std::size_t requirement = 0; requirement < names.size(); ++requirement) {
+        const auto &name = names[requirement];
+        auto &shard = shards[nameShards[requirement]];
+        const auto group = shard.groups.find(name);
+        if (group == shard.groups.end()) throw std::invalid_argument("Unknown shared resource '" + name + "'");
+
+        Resource *candidate = nullptr;
+        long long supply = 0;
+        for (const auto &resource: group->second) {
+            const auto alreadyChosen = std::count(chosen.begin(), chosen.end(), resource.get());
+            if (resource->getResourceType() == Resource::Type::Consumable) {
+                const auto remaining = static_cast<const ConsumableResource &>(*resource).getRemainingCapacity();
+                supply += remaining;
+                if (!candidate && remaining > alreadyChosen) candidate = resource.get();
+            } else {
+                ++supply;
+                if (!candidate && alreadyChosen == 0 && resource->isAvailableForUse()) candidate = resource.get();
+            }
+        }
+        if (candidate) {
+            chosen.push_back(candidate);
+            continue;
+        }
+        const auto demand = std::count(names.begin(), names.end(), name);
+        if (demand > supply) {
+            throw std::invalid_argument("Shared resource '" + name + "' can supply " + std::to_string(supply) +
+                                        " of the " + std::to_string(demand) + " units required");
+        }
+        blockedShard = nameShards[requirement];
+        seenReleases = shard.releaseCount;
+        return false;
+    }
+    for (auto *resource: chosen) resource->allocate();
+    resources = std::move(chosen);
+    return true;
+}
+
+/**
+ * @brief Releases resources and wakes the acquisitions waiting on their shards.
+ * @param resources The resources to release.
+ */
+void ResourceManager::release(const std::vector<Resource *> &resources) {
+    for (auto *resource: resources) {
+        auto &shard = shards[shardOf(resource->getName())];
+        {
+            const std::lock_guard<std::mutex> lock(shard.mutex);
+            resource->release();
+            ++shard.releaseCount;
+        }
+        shard.released.notify_all();
+    }
+}
+
+/**
+ * @brief Waits until every required name can be served, then allocates one resource per name.
+ * @param names The required resource names; a name required twice takes two units.
+ * @return A lease holding the resources.
+ * @throw std::invalid_argument If a name is unknown or required more often than its group can ever supply.
+ */
+ResourceManager::Lease ResourceManager::acquire(const std::vector<std::string> &names) {
+    std::vector<Resource *> resources;
+    std::size_t blockedShard = 0;
+    std::uint64_t seenReleases = 0;
+    while (!tryAllocate(names, resources, blockedShard, seenReleases)) {
+        auto &shard = shards[blockedShard];
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        shard.released.wait(lock, [&shard, seenReleases] { return shard.releaseCount != seenReleases; });
+    }
+    return Lease(this, std::move(resources));
+}
+
+/**
+ * @brief Allocates one resource per name only if all of them can be served right now.
+ * @param names The required resource names; a name required twice takes two units.
+ * @param lease Receives the lease on success.
+ * @return True if the resources were allocated.
+ * @throw std::invalid_argument If a name is unknown or required more often than its group can ever supply.
+ */
+bool ResourceManager::tryAcquire(const std::vector<std::string> &names, Lease &lease) {
+    std::vector<Resource *> resources;
+    std::size_t blockedShard = 0;
+    std::uint64_t seenReleases = 0;
+    if (!tryAllocate(names, resources, blockedShard, seenReleases)) return false;
+    lease = Lease(this, std::move(resources));
+    return true;
+}
+
+/**
+ * @brief Looks up the type of the resources carrying a name.
+ * @param name The resource name.
+ * @param type Receives the type of the first resource with that name.
+ * @return False if no resource carries the name.
+ */
+bool ResourceManager::findResourceType(const std::string &name, Resource::Type &type) {
+    auto &shard = shards[shardOf(name)];
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto group = shard.groups.find(name);
+    if (group == shard.groups.end() || group->second.empty()) return false;
+    type = group->second.front()->getResourceType();
+    return true;
+}
+
+/**
+ * @brief Counts the units every name can serve right now, locking one shard at a time.
+ * @return The unit count of each name, sorted by name.
+ */
+std::vector<ResourceManager::UnitCount> ResourceManager::countAvailableUnits() {
+    std::vector<UnitCount> counts;
+    for (auto &shard: shards) {
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto &[name, resources]: shard.groups) {
+            if (resources.empty()) continue;
+            UnitCount count{name, resources.front()->getResourceType()};
+            for (const auto &resource: resources) {
+                if (resource->getResourceType() == Resource::Type::Consumable) {
+                    count.available += static_cast<const ConsumableResource &>(*resource).getRemainingCapacity();
+                } else if (resource->isAvailableForUse()) {
+                    ++count.available;
+                }
+            }
+            counts.push_back(std::move(count));
+        }
+    }
+    std::sort(counts.begin(), counts.end(), [](const UnitCount &left, const UnitCount &right) {
+        return left.resourceName < right.resourceName;
+    });
+    return counts;
+}
+
+/**
+ * @brief Retrieves the number of shards.
+ * @return The number of shards the names are spread over.
+ */
+std::size_t ResourceManager::getShardCount() const {
+    return shards.size();
+}
@@ -0,0 +1,162 @@
+#include "ResultCache.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    constexpr ResultCache::Key fnvOffsetBasis = 14695981039346656037ULL; ///< FNV-1a 64-bit offset basis.
+    constexpr ResultCache::Key fnvPrime = 1099511628211ULL; ///< FNV-1a 64-bit prime.
+    const char *const fileHeader = "cpp-oop-review result cache 1"; ///< First line of every cache file.
+
+    /**
+     * @brief Hashes a field into a running FNV-1a hash, followed by a separator so field boundaries count.
+     * @param hash The running hash.
+     * @param field The field to hash.
+     * @return The updated hash.
+     */
+    ResultCache::Key hashField(ResultCache::Key hash, const std::string &field) {
+        for (const char byte: field) {
+            hash ^= static_cast<unsigned char>(byte);
+            hash *= fnvPrime;
+        }
+        hash ^= 0xffU;
+        return hash * fnvPrime;
+    }
+
+    /**
+     * @brief Hashes a count into a running FNV-1a hash, one byte at a time.
+     * @param hash The running hash.
+     * @param count The count to hash.
+     * @return The updated hash.
+     */
+    ResultCache::Key hashCount(ResultCache::Key hash, const std::uint64_t count) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            hash ^= (count >> shift) & 0xffU;
+            hash *= fnvPrime;
+        }
+        return hash;
+    }
+}
+
+/**
+ * @brief Computes the key of an executable from its name, description, requirements, artifacts and duration.
+ * @param executable The executable to hash.
+ * @return The FNV-1a hash of the executable's declaration.
+ */
+ResultCache::Key ResultCache::key(const Executable &executable) {
+    Key hash = hashField(fnvOffsetBasis, executable.getName());
+    hash = hashField(hash, executable.getDescription());
+    const auto &requirements = executable.getRequiredResourcesNames();
+    hash = hashCount(hash, requirements.size());
+    for (const auto &requirement: requirements) hash = hashField(hash, requirement);
+    hash = hashCount(hash, executable.getInputNames().size());
+    for (const auto &input: executable.getInputNames()) hash = hashField(hash, input);
+    hash = hashCount(hash, executable.getOutputNames().size());
+    for (const auto &output: executable.getOutputNames()) hash = hashField(hash, output);
+    return hashCount(hash, static_cast<std::uint64_t>(executable.getDurationInUnits()));
+}
+
+/**
+ * @brief Folds the key of a dependency into the key of the task depending on it.
+ * @param key The key of the dependent task.
+ * @param dependencyKey The key of the dependency.
+ * @return The combined key.
+ */
+ResultCache::Key ResultCache::combine(const Key key, const Key dependencyKey) {
+    return hashCount(key, dependencyKey);
+}
+
+/**
+ * @brief Checks whether a task with the given key already completed, counting a hit or a miss.
+ * @param key The key of the task.
+ * @return True if the key is stored.
+ */
+bool ResultCache::lookup(const Key key) {
+    bool found;
+    {
+        const std::lock_guard<std::mutex> lock(entriesMutex);
+        found = entries.count(key) != 0;
+    }
+    (found ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+/**
+ * @brief Records that a task completed.
+ * @param key The key of the task.
+ * @param taskName Name of the task, kept to make the stored file readable.
+ */
+void ResultCache::store(const Key key, const std::string &taskName) {
+    const std::lock_guard<std::mutex> lock(entriesMutex);
+    entries.emplace(key, taskName);
+}
+
+/**
+ * @brief Retrieves the number of lookups that found their key.
+ * @return The number of hits.
+ */
+std::uint64_t ResultCache::getHits() const {
+    return hits.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the number of lookups that did not find their key.
+ * @return The number of misses.
+ */
+std::uint64_t ResultCache::getMisses() const {
+    return misses.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the number of stored entries.
+ * @return The number of completed tasks remembered.
+ */
+std::size_t ResultCache::size() const {
+    const std::lock_guard<std::mutex> lock(entriesMutex);
+    return entries.size();
+}
+
+/**
+ * @brief Adds the entries of a cache file; a missing file leaves the cache unchanged.
+ * @param path The file to read.
+ * @throw std::runtime_error If the file exists but is not a cache file or has a malformed line.
+ */
+void ResultCache::load(const std::string &path) {
+    std::ifstream input(path);
+    if (!input) return;
+    std::string line;
+    if (!std::getline(input, line) || line != fileHeader) {
+        throw std::runtime_error("'" + path + "' is not a result cache file");
+    }
+    std::unordered_map<Key, std::string> loaded;
+    int lineNumber = 1;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        if (line.empty()) continue;
+        std::istringstream fields(line);
+        Key key = 0;
+        std::string taskName;
+        if (!(fields >> std::hex >> key) || !std::getline(fields >> std::ws, taskName) || taskName.empty()) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": malformed cache entry");
+        }
+        loaded.emplace(key, taskName);
+    }
+    const std::lock_guard<std::mutex> lock(entriesMutex);
+    entries.insert(loaded.begin(), loaded.end());
+}
+
+/**
+ * @brief Writes all entries to a cache file, replacing it.
+ * @param path The file to write.
+ * @throw std::runtime_error If the file cannot be written.
+ */
+void ResultCache::save(const std::string &path) const {
+    std::ofstream output(path);
+    if (!output) throw std::runtime_error("Cannot write result cache '" + path + "'");
+    output << fileHeader << "\n";
+    const std::lock_guard<std::mutex> lock(entriesMutex);
+    for (const auto &[key, taskName]: entries) {
+        output << std::hex << key << std::dec << " " << taskName << "\n";
+    }
+    if (!output) throw std::runtime_error("Cannot write result cache '" + path + "'");
+}
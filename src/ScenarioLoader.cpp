@@ -0,0 +1,196 @@
+#include "ScenarioLoader.h"
+#include "ConsumableResource.h"
+#include "ResourceManager.h"
+#include "Task.h"
+#include "UsableResource.h"
+#include "WorkloadGenerator.h"
+#include <fstream>
+#include <stdexcept>
+
+/**
+ * @brief Loads all processes declared in a scenario file.
+ * @param path Path of the scenario file.
+ * @return The processes in declaration order.
+ * @throw std::runtime_error If the file cannot be opened or contains an invalid directive.
+ */
+std::vector<std::unique_ptr<Process> > ScenarioLoader::loadFile(const std::string &path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("Cannot open scenario file '" + path + "'");
+    }
+    return loadStream(input, path);
+}
+
+/**
+ * @brief Loads all processes declared in a scenario stream.
+ * @param input The stream to read directives from.
+ * @param sourceName Name used to identify the source in error messages.
+ * @return The processes in declaration order.
+ * @throw std::runtime_error If the stream contains an invalid directive.
+ */
+std::vector<std::unique_ptr<Process> > ScenarioLoader::loadStream(std::istream &input, const std::string &sourceName) {
+    std::vector<std::unique_ptr<Process> > processes;
+    std::shared_ptr<ResourceManager> sharedResources;
+    Executable *lastTask = nullptr;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        try {
+            const auto tokens = tokenize(line);
+            if (tokens.empty()) continue;
+            const auto &directive = tokens[0];
+
+            if (directive == "process" || directive == "task") {
+                if (tokens.size() < 4) {
+                    throw std::runtime_error("'" + directive + "' expects a name, a description and a duration");
+                }
+                const std::vector<std::string> requirements(tokens.begin() + 4, tokens.end());
+                const int duration = parsePositive(tokens[3], "duration");
+                if (directive == "process") {
+                    processes.push_back(std::make_unique<Process>(tokens[1], tokens[2], requirements, duration));
+                    lastTask = nullptr;
+                } else {
+                    if (processes.empty()) throw std::runtime_error("'task' declared before any 'process'");
+                    auto task = std::make_unique<Task>(tokens[1], tokens[2], requirements, duration);
+                    lastTask = task.get();
+                    processes.back()->addTask(std::move(task));
+                }
+            } else if (directive == "after") {
+                if (lastTask == nullptr) throw std::runtime_error("'after' must follow a 'task'");
+                for (auto dependency = tokens.begin() + 1; dependency != tokens.end(); ++dependency) {
+                    lastTask->addDependency(*dependency);
+                }
+            } else if (directive == "reads" || directive == "writes") {
+                if (lastTask == nullptr) throw std::runtime_error("'" + directive + "' must follow a 'task'");
+                for (auto artifact = tokens.begin() + 1; artifact != tokens.end(); ++artifact) {
+                    if (directive == "reads") {
+                        lastTask->addInput(*artifact);
+                    } else {
+                        lastTask->addOutput(*artifact);
+                    }
+                }
+            } else if (directive == "stage") {
+                if (tokens.size() < 5) {
+                    throw std::runtime_error("'stage' expects a name, a description, a duration and a parallelism");
+                }
+                if (processes.empty()) throw std::runtime_error("'stage' declared before any 'process'");
+                Pipeline::Stage stage;
+                stage.name = tokens[1];
+                stage.description = tokens[2];
+                stage.durationInUnits = parsePositive(tokens[3], "duration");
+                stage.parallelism = static_cast<std::size_t>(parsePositive(tokens[4], "parallelism"));
+                stage.requiredResourcesNames.assign(tokens.begin() + 5, tokens.end());
+                processes.back()->addPipelineStage(std::move(stage));
+            } else if (directive == "input") {
+                if (tokens.size() < 2) throw std::runtime_error("'input' expects at least one item");
+                if (processes.empty()) throw std::runtime_error("'input' declared before any 'process'");
+                for (auto item = tokens.begin() + 1; item != tokens.end(); ++item) {
+                    processes.back()->addPipelineInput(*item);
+                }
+            } else if (directive == "replenish") {
+                if (tokens.size() != 4) throw std::runtime_error("'replenish' expects a name, units and a time");
+                if (processes.empty()) throw std::runtime_error("'replenish' declared before any 'process'");
+                const int time = tokens[3] == "0" ? 0 : parsePositive(tokens[3], "time");
+                processes.back()->addReplenishment(tokens[1], parsePositive(tokens[2], "units"), time);
+            } else if (directive == "weight") {
+                if (tokens.size() != 2) throw std::runtime_error("'weight' expects a weight");
+                if (processes.empty()) throw std::runtime_error("'weight' declared before any 'process'");
+                processes.back()->setShareWeight(parsePositive(tokens[1], "weight"));
+            } else if (directive == "generate") {
+                if (tokens.size() < 2) throw std::runtime_error("'generate' expects a process name");
+                WorkloadOptions options;
+                for (auto option = tokens.begin() + 2; option != tokens.end(); ++option) {
+                    const auto separator = option->find('=');
+                    if (separator == std::string::npos) {
+                        throw std::runtime_error("Workload option '" + *option + "' must have the form key=value");
+                    }
+                    options.set(option->substr(0, separator), option->substr(separator + 1));
+                }
+                processes.push_back(WorkloadGenerator(options).generate(tokens[1]));
+                lastTask = nullptr;
+            } else if (directive == "usable" || directive == "consumable") {
+                if (tokens.size() != 3) {
+                    throw std::runtime_error("'" + directive + "' expects a name and a capacity");
+                }
+                if (processes.empty()) throw std::runtime_error("'" + directive + "' declared before any 'process'");
+                const int capacity = parsePositive(tokens[2], "capacity");
+                if (directive == "usable") {
+                    processes.back()->addResource(std::make_unique<UsableResource>(tokens[1], capacity));
+                } else {
+                    processes.back()->addResource(std::make_unique<ConsumableResource>(tokens[1], capacity));
+                }
+            } else if (directive == "shared") {
+                if (tokens.size() != 4 || (tokens[1] != "usable" && tokens[1] != "consumable")) {
+                    throw std::runtime_error("'shared' expects usable or consumable, a name and a capacity");
+                }
+                const int capacity = parsePositive(tokens[3], "capacity");
+                if (!sharedResources) sharedResources = std::make_shared<ResourceManager>();
+                if (tokens[1] == "usable") {
+                    sharedResources->addResource(std::make_unique<UsableResource>(tokens[2], capacity));
+                } else {
+                    sharedResources->addResource(std::make_unique<ConsumableResource>(tokens[2], capacity));
+                }
+            } else {
+                throw std::runtime_error("Unknown directive '" + directive + "'");
+            }
+        } catch (const std::exception &e) {
+            throw std::runtime_error(sourceName + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    // Shared resources belong to the whole file, wherever they are declared.
+    if (sharedResources) {
+        for (const auto &process: processes) process->setResourceManager(sharedResources);
+    }
+    return processes;
+}
+
+/**
+ * @brief Splits a scenario line into tokens, honouring double quotes and '#' comments.
+ * @param line The line to split.
+ * @return The tokens of the line; empty for blank or comment-only lines.
+ * @throw std::runtime_error If a quoted token is not terminated.
+ */
+std::vector<std::string> ScenarioLoader::tokenize(const std::string &line) {
+    std::vector<std::string> tokens;
+    std::size_t position = 0;
+    while (position < line.size()) {
+        const char current = line[position];
+        if (current == ' ' || current == '\t' || current == '\r') {
+            ++position;
+        } else if (current == '#') {
+            break;
+        } else if (current == '"') {
+            const auto closing = line.find('"', position + 1);
+            if (closing == std::string::npos) throw std::runtime_error("Unterminated quoted token");
+            tokens.push_back(line.substr(position + 1, closing - position - 1));
+            position = closing + 1;
+        } else {
+            const auto end = line.find_first_of(" \t\r", position);
+            tokens.push_back(line.substr(position, end == std::string::npos ? std::string::npos : end - position));
+            position = end == std::string::npos ? line.size() : end;
+        }
+    }
+    return tokens;
+}
+
+/**
+ * @brief Parses a positive integer token.
+ * @param token The token to parse.
+ * @param what Description of the value used in error messages.
+ * @return The parsed value.
+ * @throw std::runtime_error If the token is not a positive integer.
+ */
+int ScenarioLoader::parsePositive(const std::string &token, const std::string &what) {
+    std::size_t consumed = 0;
+    int value = 0;
+    try {
+        value = std::stoi(token, &consumed);
+    } catch (const std::exception &) {
+        consumed = 0;
+    }
+    if (consumed != token.size() || value <= 0) {
+        throw std::runtime_error("Invalid " + what + " '" + token + "': expected a positive integer");
+    }
+    return value;
+}
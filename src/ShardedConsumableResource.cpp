@@ -0,0 +1,179 @@
+#include "ShardedConsumableResource.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a sharded consumable resource.
+ * @param name Name of the resource.
+ * @param capacity Total capacity of the resource.
+ * @param batchSize Units a thread takes from the global capacity when its quota runs dry.
+ * @throw std::invalid_argument If capacity or batchSize is not positive.
+ */
+ShardedConsumableResource::ShardedConsumableResource(const std::string &name, const int capacity,
+                                                     const int batchSize)
+    : ConsumableResource(name, capacity), batchSize(batchSize) {
+    if (batchSize <= 0) {
+        throw std::invalid_argument("Refill batch of resource '" + name + "' must be positive");
+    }
+}
+
+/**
+ * @brief Takes one unit from a quota if it has any.
+ * @param quota The quota to take from.
+ * @return True if a unit was taken.
+ */
+bool ShardedConsumableResource::takeUnit(std::atomic<int> &quota) {
+    int units = quota.load(std::memory_order_relaxed);
+    while (units > 0) {
+        if (quota.compare_exchange_weak(units, units - 1, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Moves up to a batch of units from the global capacity to a shard and takes one of them.
+ * @param shard The shard to refill.
+ * @return True if a unit was taken.
+ */
+bool ShardedConsumableResource::refill(Shard &shard) {
+    int available = remainingCapacity.load(std::memory_order_relaxed);
+    while (available > 0) {
+        const int batch = std::min(available, batchSize);
+        if (remainingCapacity.compare_exchange_weak(available, available - batch, std::memory_order_relaxed)) {
+            if (batch > 1) shard.quota.fetch_add(batch - 1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Moves half the quota of another shard to a shard and takes one unit of it.
+ * @param shard The shard that ran dry.
+ * @return True if a unit was taken.
+ */
+bool ShardedConsumableResource::steal(Shard &shard) {
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    bool taken = false;
+    shards.forEach([&](Shard &victim) {
+        if (taken || &victim == &shard) return;
+        int units = victim.quota.load(std::memory_order_relaxed);
+        while (units > 0) {
+            const int stolen = (units + 1) / 2;
+            if (victim.quota.compare_exchange_weak(units, units - stolen, std::memory_order_relaxed)) {
+                if (stolen > 1) shard.quota.fetch_add(stolen - 1, std::memory_order_relaxed);
+                taken = true;
+                return;
+            }
+        }
+    });
+    return taken;
+}
+
+/**
+ * @brief Adds up the global capacity and every quota.
+ * @return The remaining capacity; the caller holds the lock of the shards.
+ */
+int ShardedConsumableResource::countRemaining() const {
+    int remaining = remainingCapacity.load(std::memory_order_relaxed);
+    shards.forEach([&](const Shard &shard) { remaining += shard.quota.load(std::memory_order_relaxed); });
+    return remaining;
+}
+
+/**
+ * @brief Checks if any unit remains, in the calling thread's quota, the global capacity or another quota.
+ * @return True if a unit can be allocated.
+ */
+bool ShardedConsumableResource::isAvailableForUse() const {
+    if (remainingCapacity.load(std::memory_order_relaxed) > 0) return true;
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    return countRemaining() > 0;
+}
+
+/**
+ * @brief Allocates one unit from the calling thread's quota, refilling or stealing when it is empty.
+ * @throw std::runtime_error If no unit remains anywhere.
+ */
+void ShardedConsumableResource::allocate() {
+    auto &shard = shards.local();
+    if (!takeUnit(shard.quota) && !refill(shard) && !steal(shard)) {
+        throw std::runtime_error("No remaining capacity for consumable resource '" + name + "'");
+    }
+    // Only a thread left with nothing local or global can have taken the last unit; the others skip the lock.
+    if (shard.quota.load(std::memory_order_relaxed) == 0 && remainingCapacity.load(std::memory_order_relaxed) == 0) {
+        const std::lock_guard<std::mutex> lock(shards.getMutex());
+        if (countRemaining() == 0) setAvailability(false);
+    }
+}
+
+/**
+ * @brief Releases the resource; as with any consumable, capacity is not restored.
+ */
+void ShardedConsumableResource::release() {}
+
+/**
+ * @brief Displays the resource usage details, including remaining capacity.
+ */
+void ShardedConsumableResource::use() const {
+    std::cout << "    Using consumable resource '" << name << "' (remaining: " << getRemainingCapacity() << "/"
+              << totalCapacity << " MB)\n";
+}
+
+/**
+ * @brief Retrieves the remaining capacity of the resource.
+ * @return The global capacity plus every thread's quota.
+ */
+int ShardedConsumableResource::getRemainingCapacity() const {
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    return countRemaining();
+}
+
+/**
+ * @brief Restores capacity to the global capacity, up to the total capacity of the resource.
+ * @param units The number of units to restore.
+ * @throw std::invalid_argument If units is not positive.
+ */
+void ShardedConsumableResource::replenish(const int units) {
+    if (units <= 0) {
+        throw std::invalid_argument("Replenishment of resource '" + name + "' must be positive");
+    }
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    const int missing = totalCapacity - countRemaining();
+    remainingCapacity.fetch_add(std::min(units, missing), std::memory_order_relaxed);
+    setAvailability(countRemaining() > 0);
+}
+
+/**
+ * @brief Captures the availability and the remaining capacity, global and in every thread's quota.
+ * @return The state, to be passed back to restoreState().
+ */
+Resource::State ShardedConsumableResource::saveState() const {
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    return State{isAvailable, countRemaining()};
+}
+
+/**
+ * @brief Puts back a state captured by saveState(), moving every unit to the global capacity.
+ * @param state The state to restore.
+ * @throw std::invalid_argument If the remaining capacity is negative or above the total capacity.
+ */
+void ShardedConsumableResource::restoreState(const State &state) {
+    if (state.units < 0 || state.units > totalCapacity) {
+        throw std::invalid_argument("Cannot restore " + std::to_string(state.units) + " units of resource '" + name + "'");
+    }
+    const std::lock_guard<std::mutex> lock(shards.getMutex());
+    shards.forEach([](Shard &shard) { shard.quota.store(0, std::memory_order_relaxed); });
+    remainingCapacity.store(state.units, std::memory_order_relaxed);
+    setAvailability(state.available);
+}
+
+/**
+ * @brief Creates a sharded resource of the same name and batch size with another capacity, fully available.
+ * @param capacity Total capacity of the new resource.
+ * @return The new resource.
+ * @throw std::invalid_argument If the capacity is not positive.
+ */
+std::unique_ptr<ConsumableResource> ShardedConsumableResource::cloneWithCapacity(const int capacity) const {
+    return std::make_unique<ShardedConsumableResource>(name, capacity, batchSize);
+}
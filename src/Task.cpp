@@ -18,12 +18,20 @@ Task::Task(const std::string& name, const std::string& description,
  * @throw std::runtime_error If resources are not properly assigned.
  */
 void Task::execute() const {
-    if (assignedResources.size() != requiredResourcesNames.size()) {
+    if (assignedResources.size() + borrowedCount != requiredResourcesNames.size()) {
         throw std::runtime_error("Resources not properly assigned for task '" + name + "'");
     }
     std::cout << "Executing task '" << name << ": " << description
     << " (Duration: " << durationInUnits << " units)\n";
-    for (const auto* resource : assignedResources) {
-        resource->use();
-    }
+    useResources();
+}
+
+/**
+ * @brief Creates an independent copy of the task's definition, without assigned or borrowed resources.
+ * @return The copy.
+ */
+std::unique_ptr<Executable> Task::clone() const {
+    auto copy = std::make_unique<Task>(name, description, requiredResourcesNames, durationInUnits);
+    copy->copyDeclarationsFrom(*this);
+    return copy;
 }
@@ -0,0 +1,256 @@
+#include "TaskQueue.h"
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Constructs an empty queue.
+ * @param capacity Minimum number of tasks the queue holds; rounded up to a power of two.
+ * @param backpressure What push() does when the queue is full.
+ * @throw std::invalid_argument If capacity is zero.
+ */
+TaskQueue::TaskQueue(const std::size_t capacity, const Backpressure backpressure) : backpressure(backpressure) {
+    if (capacity == 0) throw std::invalid_argument("A task queue needs a positive capacity");
+    std::size_t size = 1;
+    while (size < capacity) size <<= 1;
+    cells = std::make_unique<Cell[]>(size);
+    for (std::size_t position = 0; position < size; ++position) {
+        cells[position].sequence.store(position, std::memory_order_relaxed);
+    }
+    positionMask = size - 1;
+}
+
+/**
+ * @brief Destroys the queue and the tasks still queued.
+ */
+TaskQueue::~TaskQueue() {
+    while (Executable *task = tryDequeue()) delete task;
+}
+
+/**
+ * @brief Stores a task in the next free cell if there is one.
+ * @param task The task; the queue owns it on success.
+ * @return False if the queue is full.
+ */
+bool TaskQueue::tryEnqueue(Executable *task) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = cells[position & positionMask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto lap = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (lap == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.task = task;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (lap < 0) {
+            // The cell still holds the task of the previous lap.
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Takes the task of the oldest filled cell if there is one.
+ * @return The task, now owned by the caller, or nullptr if the queue is empty.
+ */
+Executable *TaskQueue::tryDequeue() {
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = cells[position & positionMask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto lap = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+        if (lap == 0) {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                Executable *task = cell.task;
+                cell.sequence.store(position + positionMask + 1, std::memory_order_release);
+                return task;
+            }
+        } else if (lap < 0) {
+            // The cell has not been filled for this lap yet.
+            return nullptr;
+        } else {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether the next cell producers claim is free, without claiming it.
+ * @return True if a push may succeed.
+ */
+bool TaskQueue::hasRoom() const {
+    const std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    const std::size_t sequence = cells[position & positionMask].sequence.load(std::memory_order_acquire);
+    return static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position) >= 0;
+}
+
+/**
+ * @brief Checks whether the next cell consumers claim holds a task, without claiming it.
+ * @return True if a pop may succeed.
+ */
+bool TaskQueue::hasTask() const {
+    const std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    const std::size_t sequence = cells[position & positionMask].sequence.load(std::memory_order_acquire);
+    return static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1) >= 0;
+}
+
+/**
+ * @brief Wakes parked consumers, if any, after a task arrived or a push ended.
+ */
+void TaskQueue::wakeConsumers() {
+    // Pairs with the fence of a parking consumer: either it sees this change, or this sees it parking.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parkedConsumers.load(std::memory_order_relaxed) == 0) return;
+    // Taking the lock waits out a consumer between its last check and its wait, so it cannot miss the notify.
+    { const std::lock_guard<std::mutex> lock(parkingMutex); }
+    notEmpty.notify_all();
+}
+
+/**
+ * @brief Wakes parked producers, if any, after a cell freed up.
+ */
+void TaskQueue::wakeProducers() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parkedProducers.load(std::memory_order_relaxed) == 0) return;
+    { const std::lock_guard<std::mutex> lock(parkingMutex); }
+    notFull.notify_one();
+}
+
+/**
+ * @brief Checks whether consumers can stop waiting: the queue is closed and no push can still land.
+ * @return True if no task will arrive anymore.
+ */
+bool TaskQueue::isDrained() const {
+    return closed.load() && activePushes.load() == 0;
+}
+
+/**
+ * @brief Submits a task, applying the backpressure policy if the queue is full.
+ * @param task The task; null once queued or dropped, still set if rejected.
+ * @return True if the task was queued, false if it was dropped.
+ * @throw std::invalid_argument If task is null.
+ * @throw std::runtime_error If the queue is full under the Reject policy.
+ * @throw std::logic_error If the queue is closed, including while a Block push waits.
+ */
+bool TaskQueue::push(std::unique_ptr<Executable> &task) {
+    if (!task) throw std::invalid_argument("Cannot submit a null task");
+    // Consumers seeing the queue closed wait for the pushes already past the closed check to land; the
+    // sequentially consistent counter and flag ensure one side always sees the other. Every push ends by
+    // waking parked consumers, which may be waiting for the task or for the last push of a closed queue.
+    activePushes.fetch_add(1);
+    const auto finish = [this] {
+        activePushes.fetch_sub(1);
+        wakeConsumers();
+    };
+    for (int attempt = 0;; ++attempt) {
+        if (closed.load()) {
+            finish();
+            throw std::logic_error("Cannot submit task '" + task->getName() + "' to a closed queue");
+        }
+        if (tryEnqueue(task.get())) {
+            task.release();
+            finish();
+            return true;
+        }
+        switch (backpressure) {
+            case Backpressure::Block:
+                if (attempt < SpinCount) {
+                    std::this_thread::yield();
+                } else {
+                    std::unique_lock<std::mutex> lock(parkingMutex);
+                    parkedProducers.fetch_add(1);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    notFull.wait(lock, [this] { return closed.load() || hasRoom(); });
+                    parkedProducers.fetch_sub(1);
+                }
+                break;
+            case Backpressure::Drop:
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                task.reset();
+                finish();
+                return false;
+            case Backpressure::Reject:
+                finish();
+                throw std::runtime_error("Task queue is full; task '" + task->getName() + "' rejected");
+        }
+    }
+}
+
+/**
+ * @brief Takes the oldest task without waiting.
+ * @param task Receives the task on success.
+ * @return False if the queue is empty.
+ */
+bool TaskQueue::tryPop(std::unique_ptr<Executable> &task) {
+    Executable *dequeued = tryDequeue();
+    if (!dequeued) return false;
+    task.reset(dequeued);
+    wakeProducers();
+    return true;
+}
+
+/**
+ * @brief Takes the oldest task, waiting until one arrives or the queue is closed.
+ * @param task Receives the task on success.
+ * @return False once the queue is closed and empty.
+ */
+bool TaskQueue::pop(std::unique_ptr<Executable> &task) {
+    for (int attempt = 0;; ++attempt) {
+        if (tryPop(task)) return true;
+        if (isDrained()) return tryPop(task);
+        if (attempt < SpinCount) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(parkingMutex);
+        parkedConsumers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        notEmpty.wait(lock, [this] { return hasTask() || isDrained(); });
+        parkedConsumers.fetch_sub(1);
+    }
+}
+
+/**
+ * @brief Stops accepting tasks; consumers drain the tasks already queued.
+ */
+void TaskQueue::close() {
+    closed.store(true);
+    { const std::lock_guard<std::mutex> lock(parkingMutex); }
+    notEmpty.notify_all();
+    notFull.notify_all();
+}
+
+/**
+ * @brief Checks whether the queue was closed.
+ * @return True if no more tasks are accepted.
+ */
+bool TaskQueue::isClosed() const {
+    return closed.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Retrieves the number of tasks the queue holds.
+ * @return The capacity, a power of two.
+ */
+std::size_t TaskQueue::getCapacity() const {
+    return positionMask + 1;
+}
+
+/**
+ * @brief Retrieves the policy applied when the queue is full.
+ * @return The backpressure policy.
+ */
+TaskQueue::Backpressure TaskQueue::getBackpressure() const {
+    return backpressure;
+}
+
+/**
+ * @brief Retrieves the number of tasks discarded under the Drop policy.
+ * @return The number of dropped tasks.
+ */
+std::uint64_t TaskQueue::getDroppedCount() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
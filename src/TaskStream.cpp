@@ -0,0 +1,70 @@
+#include "TaskStream.h"
+#include "ScenarioLoader.h"
+#include "Task.h"
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @brief Reads task directives until the stream ends or the queue is closed, submitting them, then closes
+ * the queue.
+ * @param input The stream to read directives from, such as standard input or a pipe.
+ * @param sourceName Name used to identify the source in error and progress messages.
+ * @param queue The queue the running process drains.
+ * @param progress Stream receiving a throughput line every reportInterval, or nullptr for none.
+ * @param reportInterval Time between progress lines.
+ * @return The counts of the stream.
+ */
+TaskStream::Totals TaskStream::submit(std::istream &input, const std::string &sourceName, TaskQueue &queue,
+                                      std::ostream *progress, const std::chrono::steady_clock::duration reportInterval) {
+    using Clock = std::chrono::steady_clock;
+    Totals totals;
+    auto lastReport = Clock::now();
+    std::uint64_t submittedAtLastReport = 0;
+    std::string line;
+    int lineNumber = 0;
+    // The service closes the queue itself if it stops early; reading then stops too.
+    while (!queue.isClosed() && std::getline(input, line)) {
+        ++lineNumber;
+        try {
+            const auto tokens = ScenarioLoader::tokenize(line);
+            if (tokens.empty()) continue;
+            if (tokens[0] != "task") throw std::runtime_error("Only 'task' directives can be streamed");
+            if (tokens.size() < 4) throw std::runtime_error("'task' expects a name, a description and a duration");
+            const std::vector<std::string> requirements(tokens.begin() + 4, tokens.end());
+            std::unique_ptr<Executable> task = std::make_unique<Task>(
+                tokens[1], tokens[2], requirements, ScenarioLoader::parsePositive(tokens[3], "duration"));
+            try {
+                if (queue.push(task)) {
+                    ++totals.submitted;
+                } else {
+                    ++totals.dropped;
+                }
+            } catch (const std::logic_error &) {
+                // Closed while this task waited for room.
+                break;
+            } catch (const std::runtime_error &) {
+                // Rejected: the service keeps reading, as a full queue under Reject is an expected outcome.
+                ++totals.dropped;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << sourceName << ":" << lineNumber << ": " << e.what() << "\n";
+            ++totals.invalid;
+        }
+
+        if (progress) {
+            const auto now = Clock::now();
+            if (now - lastReport >= reportInterval) {
+                const double seconds = std::chrono::duration<double>(now - lastReport).count();
+                *progress << sourceName << ": " << totals.submitted << " tasks streamed ("
+                          << std::fixed << std::setprecision(1)
+                          << static_cast<double>(totals.submitted - submittedAtLastReport) / seconds
+                          << " tasks/s)\n";
+                lastReport = now;
+                submittedAtLastReport = totals.submitted;
+            }
+        }
+    }
+    queue.close();
+    return totals;
+}
@@ -0,0 +1,195 @@
+#include "TraceRecorder.h"
+#include "Json.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+std::atomic<TraceRecorder *> TraceRecorder::activeRecorder{nullptr};
+
+namespace {
+    /**
+     * @brief Names a category as it appears in the trace.
+     * @param category The category to name.
+     * @return The category name.
+     */
+    const char *categoryName(const TraceRecorder::Category category) {
+        switch (category) {
+            case TraceRecorder::Category::Process: return "process";
+            case TraceRecorder::Category::Task: return "task";
+            case TraceRecorder::Category::Assign: return "assign";
+            case TraceRecorder::Category::Release: return "release";
+            case TraceRecorder::Category::Resource: return "resource";
+        }
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Constructs a recorder.
+ * @param eventsPerThread Number of events each recording thread can hold.
+ * @throw std::invalid_argument If the capacity is zero.
+ */
+TraceRecorder::TraceRecorder(const std::size_t eventsPerThread)
+    : eventsPerThread(eventsPerThread), origin(std::chrono::steady_clock::now()) {
+    if (eventsPerThread == 0) throw std::invalid_argument("Trace buffers must hold at least one event");
+}
+
+/**
+ * @brief Uninstalls the recorder if it is still active.
+ */
+TraceRecorder::~TraceRecorder() {
+    TraceRecorder *self = this;
+    activeRecorder.compare_exchange_strong(self, nullptr);
+}
+
+/**
+ * @brief Installs the recorder that instrumentation reports to.
+ * @param recorder The recorder to install, or nullptr to disable tracing.
+ */
+void TraceRecorder::install(TraceRecorder *recorder) {
+    activeRecorder.store(recorder, std::memory_order_release);
+}
+
+/**
+ * @brief Retrieves the calling thread's buffer, allocating it on first use.
+ * @return The buffer of the calling thread.
+ */
+TraceRecorder::ThreadBuffer &TraceRecorder::localBuffer() {
+    return buffers.local([this](ThreadBuffer &buffer, const std::size_t bufferCount) {
+        buffer.threadId = static_cast<std::uint32_t>(bufferCount);
+        buffer.events.reserve(eventsPerThread);
+    });
+}
+
+/**
+ * @brief Appends an event to the calling thread's buffer.
+ * @param category Activity the event belongs to.
+ * @param phase Chrome trace phase of the event.
+ * @param name Name of the event.
+ * @param spanId Identifier pairing asynchronous events; 0 for synchronous spans.
+ */
+void TraceRecorder::record(const Category category, const char phase, const std::string &name,
+                           const std::uint64_t spanId) {
+    auto &buffer = localBuffer();
+    if (buffer.events.size() == eventsPerThread) {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.events.emplace_back();
+    auto &event = buffer.events.back();
+    const auto length = std::min(name.size(), NameLength);
+    std::memcpy(event.name, name.data(), length);
+    event.name[length] = '\0';
+    event.category = category;
+    event.phase = phase;
+    event.timestampNanoseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+    event.spanId = spanId;
+}
+
+/**
+ * @brief Records the beginning of a span on the calling thread.
+ * @param category Activity the span belongs to.
+ * @param name Name of the span.
+ */
+void TraceRecorder::begin(const Category category, const std::string &name) {
+    record(category, 'B', name, 0);
+}
+
+/**
+ * @brief Records the end of the innermost open span on the calling thread.
+ * @param category Activity the span belongs to.
+ * @param name Name of the span.
+ */
+void TraceRecorder::end(const Category category, const std::string &name) {
+    record(category, 'E', name, 0);
+}
+
+/**
+ * @brief Issues an identifier for an asynchronous span, unique among the spans of this recorder.
+ * @return A fresh, non-zero identifier.
+ * @note Overlapping spans of one resource, such as several holds of a consumable, each need their own.
+ */
+std::uint64_t TraceRecorder::newSpanId() {
+    return lastSpanId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * @brief Records the beginning of an asynchronous span, such as a resource being held.
+ * @param category Activity the span belongs to.
+ * @param name Name of the span.
+ * @param spanId Identifier shared with the matching end event.
+ */
+void TraceRecorder::beginAsync(const Category category, const std::string &name, const std::uint64_t spanId) {
+    record(category, 'b', name, spanId);
+}
+
+/**
+ * @brief Records the end of an asynchronous span.
+ * @param category Activity the span belongs to.
+ * @param name Name of the span.
+ * @param spanId Identifier shared with the matching begin event.
+ */
+void TraceRecorder::endAsync(const Category category, const std::string &name, const std::uint64_t spanId) {
+    record(category, 'e', name, spanId);
+}
+
+/**
+ * @brief Counts the recorded events of all threads.
+ * @return The number of recorded events.
+ */
+std::size_t TraceRecorder::getEventCount() const {
+    const std::lock_guard<std::mutex> lock(buffers.getMutex());
+    std::size_t count = 0;
+    buffers.forEach([&](const ThreadBuffer &buffer) { count += buffer.events.size(); });
+    return count;
+}
+
+/**
+ * @brief Counts the events discarded because a thread buffer was full.
+ * @return The number of dropped events.
+ */
+std::uint64_t TraceRecorder::getDroppedEventCount() const {
+    const std::lock_guard<std::mutex> lock(buffers.getMutex());
+    std::uint64_t dropped = 0;
+    buffers.forEach([&](const ThreadBuffer &buffer) { dropped += buffer.dropped; });
+    return dropped;
+}
+
+/**
+ * @brief Writes all recorded events in Chrome trace event format.
+ * @param output The stream to write to.
+ * @note Call it once recording threads are quiescent.
+ */
+void TraceRecorder::writeChromeTrace(std::ostream &output) const {
+    const std::lock_guard<std::mutex> lock(buffers.getMutex());
+    std::vector<const ThreadBuffer *> ordered;
+    buffers.forEach([&](const ThreadBuffer &buffer) { ordered.push_back(&buffer); });
+    std::sort(ordered.begin(), ordered.end(), [](const ThreadBuffer *left, const ThreadBuffer *right) {
+        return left->threadId < right->threadId;
+    });
+
+    const auto flags = output.flags();
+    output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto *buffer: ordered) {
+        output << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << buffer->threadId << ",\"args\":{\"name\":\"worker " << buffer->threadId << "\"}}";
+        first = false;
+        for (const auto &event: buffer->events) {
+            output << ",{\"name\":" << Json::quote(event.name) << ",\"cat\":\"" << categoryName(event.category)
+                    << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << std::fixed << std::setprecision(3)
+                    << static_cast<double>(event.timestampNanoseconds) / 1000.0 << ",\"pid\":1,\"tid\":"
+                    << buffer->threadId;
+            if (event.phase == 'b' || event.phase == 'e') output << ",\"id\":\"0x" << std::hex << event.spanId << std::dec << "\"";
+            output << "}";
+        }
+        if (buffer->dropped > 0) {
+            output << ",{\"name\":\"dropped events\",\"ph\":\"C\",\"ts\":0,\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"args\":{\"dropped\":" << buffer->dropped << "}}";
+        }
+    }
+    output << "]}\n";
+    output.flags(flags);
+}
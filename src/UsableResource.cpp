@@ -23,6 +23,14 @@ bool UsableResource::isAvailableForUse() const {
     return isAvailable;
 }
 
+/**
+ * @brief Retrieves the capacity of the resource.
+ * @return The capacity (e.g., GHz).
+ */
+int UsableResource::getCapacity() const {
+    return capacity;
+}
+
 /**
  * @brief Allocates the resource, marking it as unavailable.
  * @throw std::runtime_error If the resource is already allocated.
@@ -31,7 +39,7 @@ void UsableResource::allocate() {
     if (!isAvailable) {
         throw std::runtime_error("Usable resource '" + name + "' is already allocated");
     }
-    isAvailable = false;
+    setAvailability(false);
 }
 
 /**
@@ -41,7 +49,7 @@ void UsableResource::release() {
     if (isAvailable) {
         std::cerr << "Warning: Attempted to release already free usable resource '" << name << "'\n";
     }
-    isAvailable = true;
+    setAvailability(true);
 }
 
 /**
@@ -51,3 +59,12 @@ void UsableResource::use() const {
     std::cout << "    Using usable resource '" << name << "' (capacity: " << capacity << " GHz)\n";
 }
 
+/**
+ * @brief Creates an independent copy of the resource in its current state, without its listeners.
+ * @return The copy.
+ */
+std::unique_ptr<Resource> UsableResource::clone() const {
+    auto copy = std::make_unique<UsableResource>(name, capacity);
+    copy->restoreState(saveState());
+    return copy;
+}
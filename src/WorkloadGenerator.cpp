@@ -0,0 +1,217 @@
+#include "WorkloadGenerator.h"
+#include "ConsumableResource.h"
+#include "Task.h"
+#include "UsableResource.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Parses a non-negative integer option value.
+     * @param key The option the value belongs to.
+     * @param value The value to parse.
+     * @return The parsed value.
+     * @throw std::invalid_argument If the value is not a non-negative integer.
+     */
+    unsigned long long parseCount(const std::string &key, const std::string &value) {
+        std::size_t consumed = 0;
+        unsigned long long parsed = 0;
+        try {
+            parsed = std::stoull(value, &consumed);
+        } catch (const std::exception &) {
+            consumed = 0;
+        }
+        if (value.empty() || value[0] == '-' || consumed != value.size()) {
+            throw std::invalid_argument("Workload option '" + key + "' expects a non-negative integer, got '" + value + "'");
+        }
+        return parsed;
+    }
+
+    /**
+     * @brief Parses a non-negative option value that must fit in an int, such as a capacity or a duration.
+     * @param key The option the value belongs to.
+     * @param value The value to parse.
+     * @return The parsed value.
+     * @throw std::invalid_argument If the value is not a non-negative integer or exceeds the range of int.
+     */
+    int parseInt(const std::string &key, const std::string &value) {
+        const auto parsed = parseCount(key, value);
+        if (parsed > static_cast<unsigned long long>(std::numeric_limits<int>::max())) {
+            throw std::invalid_argument("Workload option '" + key + "' expects an integer of at most " +
+                                        std::to_string(std::numeric_limits<int>::max()) + ", got '" + value + "'");
+        }
+        return static_cast<int>(parsed);
+    }
+
+    /**
+     * @brief Parses a real option value.
+     * @param key The option the value belongs to.
+     * @param value The value to parse.
+     * @return The parsed value.
+     * @throw std::invalid_argument If the value is not a number.
+     */
+    double parseReal(const std::string &key, const std::string &value) {
+        std::size_t consumed = 0;
+        double parsed = 0;
+        try {
+            parsed = std::stod(value, &consumed);
+        } catch (const std::exception &) {
+            consumed = 0;
+        }
+        if (value.empty() || consumed != value.size()) {
+            throw std::invalid_argument("Workload option '" + key + "' expects a number, got '" + value + "'");
+        }
+        return parsed;
+    }
+
+    /**
+     * @brief Draws an integer uniformly from [0, bound).
+     * @param engine The random engine.
+     * @param bound Exclusive upper bound; must be positive.
+     * @return The drawn value.
+     */
+    std::size_t drawBelow(std::mt19937_64 &engine, const std::size_t bound) {
+        return static_cast<std::size_t>(engine() % bound);
+    }
+}
+
+/**
+ * @brief Sets an option from its textual form, as used by scenario files.
+ * @param key Option name: tasks, fanout, usable, consumable, usable-capacity, consumable-capacity,
+ *            durations, min-duration, max-duration, mean-duration, shape, max-dependencies, window or seed.
+ * @param value Option value.
+ * @throw std::invalid_argument If the key is unknown or the value is invalid.
+ */
+void WorkloadOptions::set(const std::string &key, const std::string &value) {
+    if (key == "tasks") taskCount = parseCount(key, value);
+    else if (key == "fanout") requirementFanOut = parseCount(key, value);
+    else if (key == "usable") usableResourceCount = parseCount(key, value);
+    else if (key == "consumable") consumableResourceCount = parseCount(key, value);
+    else if (key == "usable-capacity") usableCapacity = parseInt(key, value);
+    else if (key == "consumable-capacity") consumableCapacity = parseInt(key, value);
+    else if (key == "min-duration") minimumDuration = parseInt(key, value);
+    else if (key == "max-duration") maximumDuration = parseInt(key, value);
+    else if (key == "mean-duration") meanDuration = parseReal(key, value);
+    else if (key == "max-dependencies") maxDependencies = parseCount(key, value);
+    else if (key == "window") dependencyWindow = parseCount(key, value);
+    else if (key == "seed") seed = parseCount(key, value);
+    else if (key == "durations") {
+        if (value == "constant") durationDistribution = DurationDistribution::Constant;
+        else if (value == "uniform") durationDistribution = DurationDistribution::Uniform;
+        else if (value == "exponential") durationDistribution = DurationDistribution::Exponential;
+        else throw std::invalid_argument("Unknown duration distribution '" + value + "'");
+    } else if (key == "shape") {
+        if (value == "chain") shape = Shape::Chain;
+        else if (value == "wide") shape = Shape::Wide;
+        else if (value == "random") shape = Shape::Random;
+        else throw std::invalid_argument("Unknown workload shape '" + value + "'");
+    } else {
+        throw std::invalid_argument("Unknown workload option '" + key + "'");
+    }
+}
+
+/**
+ * @brief Checks that the options describe a workload that can be generated.
+ * @throw std::invalid_argument If a count, capacity or duration bound is out of range.
+ */
+void WorkloadOptions::validate() const {
+    if (taskCount == 0) throw std::invalid_argument("Workload must contain at least one task");
+    if (requirementFanOut > usableResourceCount + consumableResourceCount) {
+        throw std::invalid_argument("Requirement fan-out exceeds the number of generated resources");
+    }
+    if (usableCapacity <= 0 || consumableCapacity <= 0) {
+        throw std::invalid_argument("Generated resource capacities must be positive");
+    }
+    if (minimumDuration <= 0 || maximumDuration < minimumDuration) {
+        throw std::invalid_argument("Duration bounds must satisfy 0 < minimum <= maximum");
+    }
+    if (durationDistribution == DurationDistribution::Exponential && meanDuration <= 0) {
+        throw std::invalid_argument("Mean duration must be positive");
+    }
+}
+
+/**
+ * @brief Constructs a generator for the given parameters.
+ * @param options Parameters of the generated workloads.
+ * @throw std::invalid_argument If the options are invalid.
+ */
+WorkloadGenerator::WorkloadGenerator(WorkloadOptions options) : options(std::move(options)) {
+    this->options.validate();
+}
+
+/**
+ * @brief Retrieves the parameters of the generated workloads.
+ * @return The workload options.
+ */
+const WorkloadOptions &WorkloadGenerator::getOptions() const {
+    return options;
+}
+
+/**
+ * @brief Generates a process with the configured resources and tasks.
+ * @param processName Name of the generated process.
+ * @return The generated process.
+ */
+std::unique_ptr<Process> WorkloadGenerator::generate(const std::string &processName) const {
+    auto process = std::make_unique<Process>(processName, "Synthetic workload", std::vector<std::string>{},
+                                             options.minimumDuration);
+    std::vector<std::string> resourceNames;
+    for (std::size_t index = 0; index < options.usableResourceCount; ++index) {
+        resourceNames.push_back("CPU" + std::to_string(index));
+        process->addResource(std::make_unique<UsableResource>(resourceNames.back(), options.usableCapacity));
+    }
+    for (std::size_t index = 0; index < options.consumableResourceCount; ++index) {
+        resourceNames.push_back("Memory" + std::to_string(index));
+        process->addResource(std::make_unique<ConsumableResource>(resourceNames.back(), options.consumableCapacity));
+    }
+
+    std::mt19937_64 engine(options.seed);
+    std::vector<std::size_t> resourceOrder(resourceNames.size());
+    for (std::size_t index = 0; index < resourceOrder.size(); ++index) resourceOrder[index] = index;
+    std::vector<std::string> requirements;
+    std::vector<std::size_t> dependencies;
+    const auto span = static_cast<std::size_t>(options.maximumDuration - options.minimumDuration) + 1;
+
+    for (std::size_t taskIndex = 0; taskIndex < options.taskCount; ++taskIndex) {
+        // Partial Fisher-Yates shuffle: the first fan-out entries are a uniform sample without repetition.
+        requirements.clear();
+        for (std::size_t slot = 0; slot < options.requirementFanOut; ++slot) {
+            std::swap(resourceOrder[slot], resourceOrder[slot + drawBelow(engine, resourceOrder.size() - slot)]);
+            requirements.push_back(resourceNames[resourceOrder[slot]]);
+        }
+
+        int duration = options.minimumDuration;
+        if (options.durationDistribution == WorkloadOptions::DurationDistribution::Uniform) {
+            duration += static_cast<int>(drawBelow(engine, span));
+        } else if (options.durationDistribution == WorkloadOptions::DurationDistribution::Exponential) {
+            const double uniform = static_cast<double>(engine() >> 11) * 0x1.0p-53;
+            const double tail = -options.meanDuration * std::log1p(-uniform);
+            duration = static_cast<int>(std::min<double>(options.maximumDuration, duration + std::floor(tail)));
+        }
+
+        auto task = std::make_unique<Task>("T" + std::to_string(taskIndex), "Synthetic task", requirements, duration);
+        if (taskIndex > 0) {
+            dependencies.clear();
+            if (options.shape == WorkloadOptions::Shape::Chain) {
+                dependencies.push_back(taskIndex - 1);
+            } else if (options.shape == WorkloadOptions::Shape::Wide) {
+                dependencies.push_back(0);
+            } else if (options.maxDependencies > 0) {
+                const std::size_t window = std::min(taskIndex, std::max<std::size_t>(options.dependencyWindow, 1));
+                const std::size_t wanted = std::min(window, 1 + drawBelow(engine, options.maxDependencies));
+                while (dependencies.size() < wanted) {
+                    const std::size_t candidate = taskIndex - 1 - drawBelow(engine, window);
+                    if (std::find(dependencies.begin(), dependencies.end(), candidate) == dependencies.end()) {
+                        dependencies.push_back(candidate);
+                    }
+                }
+            }
+            for (const auto dependency: dependencies) task->addDependency("T" + std::to_string(dependency));
+        }
+        process->addTask(std::move(task));
+    }
+    return process;
+}
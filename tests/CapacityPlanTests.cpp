@@ -0,0 +1,84 @@
+/**
+ * @file CapacityPlanTests.cpp
+ * @brief Tests of the static capacity plan against simulations of the capacities around it.
+ */
+
+#include "Test.h"
+#include "CapacityPlan.h"
+#include "CapacitySweep.h"
+#include <map>
+
+namespace {
+    /// @brief Tasks holding up to two CPUs at once and consuming five units of memory in total.
+    const char *const SizedScenario = R"(
+process Sized "Capacity planning" 1
+usable CPU 3
+consumable Memory 10
+task Wide "Holds two CPUs" 2 CPU CPU Memory Memory
+task Narrow "Holds one CPU" 1 CPU Memory
+task Last "Runs after Wide" 1 CPU Memory Memory
+after Wide
+)";
+
+    /**
+     * @brief Checks the demand and minimum of every resource name, worked out from the declarations.
+     */
+    void CapacityPlanComputesMinimums() {
+        const auto process = test::loadProcess(SizedScenario);
+        const auto plan = process->planCapacities();
+        CHECK(plan.getObstacles().empty());
+        CHECK(!plan.isSufficient());
+        CHECK((plan.getCapacities() == std::map<std::string, int>{{"CPU", 2}, {"Memory", 5}}));
+
+        const auto sized = process->cloneProcess(plan.getCapacities());
+        const auto sizedPlan = sized->planCapacities();
+        CHECK(sizedPlan.isSufficient());
+        CHECK(sizedPlan.getObstacles().empty());
+    }
+
+    TEST(CapacityPlanComputesMinimums);
+
+    /**
+     * @brief Checks that tasks no capacity lets run are reported with their reason, and their dependents too.
+     */
+    void CapacityPlanReportsObstacles() {
+        const auto process = test::loadProcess(R"(
+process Blocked "Missing resource" 1
+usable CPU 3
+task Render "Needs a GPU" 1 GPU
+task Publish "Runs after Render" 1 CPU
+after Render
+task Report "Runs" 1 CPU
+)");
+        const auto plan = process->planCapacities();
+        CHECK_EQUAL(std::size_t{2}, plan.getObstacles().size());
+        CHECK_EQUAL(std::string("Render"), plan.getObstacles()[0].executableName);
+        CHECK_EQUAL(std::string("Publish"), plan.getObstacles()[1].executableName);
+        CHECK((plan.getCapacities() == std::map<std::string, int>{{"CPU", 1}}));
+    }
+
+    TEST(CapacityPlanReportsObstacles);
+
+    /**
+     * @brief Checks that a sweep of event-driven runs completes every task exactly from the planned minimums up.
+     */
+    void CapacityPlanMatchesSweep() {
+        const auto process = test::loadProcess(SizedScenario);
+        const auto minimums = process->planCapacities().getCapacities();
+        CapacitySweep sweep(*process);
+        sweep.addDimension("CPU", {1, 2, 3});
+        sweep.addDimension("Memory", {3, 4, 5, 6});
+        const test::CapturedOutput output;
+        // One worker thread, as the captured output is not synchronised.
+        const auto results = sweep.runGrid(1);
+        CHECK_EQUAL(std::size_t{12}, results.size());
+        for (const auto &result: results) {
+            const bool planned = result.capacities.at("CPU") >= minimums.at("CPU") &&
+                                 result.capacities.at("Memory") >= minimums.at("Memory");
+            const bool complete = result.started && result.report.skipped == 0 && result.report.completed == 3;
+            CHECK_EQUAL(planned, complete);
+        }
+    }
+
+    TEST(CapacityPlanMatchesSweep);
+}
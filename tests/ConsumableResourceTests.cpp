@@ -0,0 +1,69 @@
+/**
+ * @file ConsumableResourceTests.cpp
+ * @brief Tests of consumable resources allocated from several threads at once.
+ */
+
+#include "Test.h"
+#include "ConsumableResource.h"
+#include "ShardedConsumableResource.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Allocates from a resource on several threads until it runs out.
+     * @param resource The resource.
+     * @param threadCount Number of allocating threads.
+     * @return The number of units the threads allocated together.
+     */
+    int allocateUntilDepleted(ConsumableResource &resource, const int threadCount) {
+        std::atomic<int> allocated{0};
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < threadCount; ++thread) {
+            threads.emplace_back([&resource, &allocated] {
+                try {
+                    while (true) {
+                        resource.allocate();
+                        allocated.fetch_add(1);
+                    }
+                } catch (const std::runtime_error &) {
+                    // Depleted.
+                }
+            });
+        }
+        for (auto &thread: threads) thread.join();
+        return allocated.load();
+    }
+
+    /**
+     * @brief Checks that concurrent allocations hand out every unit exactly once and leave none.
+     *
+     * Threads only race for a unit when few remain, so the check is repeated on many small resources.
+     */
+    void ConsumableConcurrentAllocationsTakeEachUnitOnce() {
+        for (int round = 0; round < 200; ++round) {
+            ConsumableResource resource("Memory", 64);
+            CHECK_EQUAL(64, allocateUntilDepleted(resource, 4));
+            CHECK_EQUAL(0, resource.getRemainingCapacity());
+            CHECK(!resource.isAvailableForUse());
+        }
+    }
+
+    TEST(ConsumableConcurrentAllocationsTakeEachUnitOnce);
+
+    /**
+     * @brief Checks the same for the sharded consumable, whose units move between thread quotas.
+     */
+    void ConsumableShardedAllocationsTakeEachUnitOnce() {
+        for (int round = 0; round < 200; ++round) {
+            ShardedConsumableResource resource("Memory", 64, 8);
+            CHECK_EQUAL(64, allocateUntilDepleted(resource, 4));
+            CHECK_EQUAL(0, resource.getRemainingCapacity());
+            CHECK(!resource.isAvailableForUse());
+        }
+    }
+
+    TEST(ConsumableShardedAllocationsTakeEachUnitOnce);
+}
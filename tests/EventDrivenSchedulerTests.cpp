@@ -0,0 +1,189 @@
+/**
+ * @file EventDrivenSchedulerTests.cpp
+ * @brief Tests of event-driven simulations on small scenarios whose schedules are worked out by hand.
+ */
+
+#include "Test.h"
+#include <vector>
+
+namespace {
+    using Admission = EventDrivenScheduler::Admission;
+
+    /// @brief Every admission policy.
+    const std::vector<Admission> AllAdmissions{
+        Admission::FirstCome, Admission::FirstFitDecreasing, Admission::BestFit, Admission::DominantResource,
+        Admission::Backfill, Admission::EarliestFinish
+    };
+
+    /**
+     * @brief Loads a scenario and simulates it with an admission policy, its output captured.
+     * @param scenario Scenario directives declaring one process.
+     * @param admission The admission policy.
+     * @return The outcome of the simulation.
+     */
+    EventDrivenScheduler::Report simulate(const std::string &scenario, const Admission admission) {
+        auto process = test::loadProcess(scenario);
+        process->setScheduling(Process::Scheduling::EventDriven);
+        process->setAdmission(admission);
+        const test::CapturedOutput output;
+        process->run();
+        test::check(process->getLastSimulation().has_value(), "the run simulated", __FILE__, __LINE__);
+        return *process->getLastSimulation();
+    }
+
+    /**
+     * @brief Checks that dependent tasks wait for each other while independent ones overlap.
+     *
+     * On two CPUs, A and B run over [0, 2) and [0, 3); C, after A, runs over [2, 4) and D, after B and C, over
+     * [4, 5). The CPUs are held for 2 + 3 + 2 + 1 of the 2 × 5 available units.
+     */
+    void EventDrivenOverlapsIndependentTasks() {
+        const auto report = simulate(R"(
+process Overlap "Dependencies and overlap" 1
+usable CPU 3
+usable CPU 3
+task A "First branch" 2 CPU
+task B "Second branch" 3 CPU
+task C "After A" 2 CPU
+after A
+task D "Joins both branches" 1 CPU
+after B C
+)", Admission::FirstCome);
+        CHECK_EQUAL(std::int64_t{5}, report.makespan);
+        CHECK_EQUAL(std::size_t{4}, report.completed);
+        CHECK_EQUAL(std::size_t{0}, report.skipped);
+        CHECK_EQUAL(0.8, report.utilisation);
+    }
+
+    TEST(EventDrivenOverlapsIndependentTasks);
+
+    /**
+     * @brief Checks the makespan of every admission where backfilling alone delays the wide task's neighbour.
+     *
+     * On two CPUs, first-come starts Long (4 units) and Short (5 units) at 0 and Wide, needing both CPUs, at 5.
+     * The packing admissions start Wide first, then Long and Short at 2. HEFT ranks Short, Long, Wide by
+     * duration. Backfilling reserves both CPUs for Wide at 4, when Long completes; Short would hold one past
+     * then, so it waits for Wide and runs over [6, 11).
+     */
+    void EventDrivenAdmissionsOnHandCheckedScenario() {
+        const std::string scenario = R"(
+process Admissions "Wide task between narrow ones" 1
+usable CPU 3
+usable CPU 3
+task Long "Narrow" 4 CPU
+task Wide "Needs both CPUs" 2 CPU CPU
+task Short "Narrow" 5 CPU
+)";
+        const std::vector<std::pair<Admission, std::int64_t> > expected{
+            {Admission::FirstCome, 7}, {Admission::FirstFitDecreasing, 7}, {Admission::BestFit, 7},
+            {Admission::DominantResource, 7}, {Admission::Backfill, 11}, {Admission::EarliestFinish, 7}
+        };
+        for (const auto &[admission, makespan]: expected) {
+            const auto report = simulate(scenario, admission);
+            CHECK_EQUAL(makespan, report.makespan);
+            CHECK_EQUAL(std::size_t{3}, report.completed);
+        }
+    }
+
+    TEST(EventDrivenAdmissionsOnHandCheckedScenario);
+
+    /**
+     * @brief Checks that a task waiting for several units of a consumable starts once a refill tops it up.
+     *
+     * A takes the CPU and 3 of the 4 units of Memory over [0, 2). B then has the CPU but needs 2 units with 1
+     * left; Memory never ran out, so only the refill at 5 can wake B, which runs over [5, 7).
+     */
+    void EventDrivenRefillWakesWaiters() {
+        const std::string scenario = R"(
+process Refill "Refill of a consumable that never ran out" 1
+usable CPU 3
+consumable Memory 4
+replenish Memory 3 5
+task A "Takes three units" 2 CPU Memory Memory Memory
+task B "Takes two units" 2 CPU Memory Memory
+)";
+        for (const auto admission: AllAdmissions) {
+            const auto report = simulate(scenario, admission);
+            CHECK_EQUAL(std::int64_t{7}, report.makespan);
+            CHECK_EQUAL(std::size_t{2}, report.completed);
+            CHECK_EQUAL(std::size_t{0}, report.skipped);
+        }
+    }
+
+    TEST(EventDrivenRefillWakesWaiters);
+
+    /**
+     * @brief Checks that tasks no event can serve are reported as skipped, with their dependents.
+     *
+     * First is also the longest, so every admission, HEFT's upward ranks included, starts it before Second.
+     */
+    void EventDrivenSkipsUnservedTasks() {
+        const std::string scenario = R"(
+process Starved "Memory runs out" 1
+usable CPU 3
+consumable Memory 2
+task First "Takes both units" 3 CPU Memory Memory
+task Second "Finds no memory" 1 CPU Memory
+task Third "Follows Second" 1 CPU
+after Second
+)";
+        for (const auto admission: AllAdmissions) {
+            const auto report = simulate(scenario, admission);
+            CHECK_EQUAL(std::int64_t{3}, report.makespan);
+            CHECK_EQUAL(std::size_t{1}, report.completed);
+            CHECK_EQUAL(std::size_t{2}, report.skipped);
+        }
+    }
+
+    TEST(EventDrivenSkipsUnservedTasks);
+
+    /**
+     * @brief Checks that a reference capacity scales durations to the speed of the assigned processor.
+     *
+     * Measured on 3 GHz, a 4-unit task takes 2 units on a 6 GHz processor and, rounded up, 6 units on a 2 GHz
+     * one. HEFT places the single task on the fastest processor.
+     */
+    void EventDrivenScalesDurationsToCapacity() {
+        auto process = test::loadProcess(R"(
+process Scaled "Mixed processor speeds" 1
+usable CPU 2
+usable CPU 6
+task Only "Runs anywhere" 4 CPU
+)");
+        process->setScheduling(Process::Scheduling::EventDriven);
+        process->setAdmission(Admission::EarliestFinish);
+        process->setReferenceCapacity(3);
+        const test::CapturedOutput output;
+        process->run();
+        CHECK_EQUAL(std::int64_t{2}, process->getLastSimulation()->makespan);
+    }
+
+    TEST(EventDrivenScalesDurationsToCapacity);
+
+    /**
+     * @brief Checks that backfilling weighs a task at the pace of the slowest free processor it may be given.
+     *
+     * Measured on 3 GHz, A takes the 3 GHz CPU over [0, 4), and Hold, needing both CPUs, is reserved for 4. B
+     * fits on the free 1 GHz CPU, but would hold it until 9, so it waits. Hold runs at the 1 GHz pace over
+     * [4, 7), and B on the 3 GHz CPU over [7, 10).
+     */
+    void EventDrivenBackfillScalesDurations() {
+        auto process = test::loadProcess(R"(
+process Backfilled "Backfilling on mixed processor speeds" 1
+usable CPU 3
+usable CPU 1
+task A "Narrow" 4 CPU
+task Hold "Needs both CPUs" 1 CPU CPU
+task B "Narrow" 3 CPU
+)");
+        process->setScheduling(Process::Scheduling::EventDriven);
+        process->setAdmission(Admission::Backfill);
+        process->setReferenceCapacity(3);
+        const test::CapturedOutput output;
+        process->run();
+        CHECK(output.contains("[t=4] Executing task 'Hold"));
+        CHECK_EQUAL(std::int64_t{10}, process->getLastSimulation()->makespan);
+    }
+
+    TEST(EventDrivenBackfillScalesDurations);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file FairShareSchedulerTests.cpp
+ * @brief Tests of processes sharing the processors of one machine under each fair-share policy.
+ */
+
+#include "Test.h"
+#include "FairShareScheduler.h"
+#include "UsableResource.h"
+
+namespace {
+    /**
+     * @brief Simulates a greedy process and a light one sharing a machine of two CPUs.
+     *
+     * Greedy, added first, has four 2-unit tasks and Light one; neither has a CPU of its own.
+     * @param policy Which process starts its next task when several can.
+     * @return The outcome of the simulation.
+     */
+    FairShareScheduler::Report shareTwoCpus(const FairShareScheduler::Policy policy) {
+        ResourceManager machine;
+        machine.addResource(std::make_unique<UsableResource>("CPU", 3));
+        machine.addResource(std::make_unique<UsableResource>("CPU", 3));
+        const auto greedy = test::loadProcess(R"(
+process Greedy "Many tasks" 1
+task G1 "Greedy" 2 CPU
+task G2 "Greedy" 2 CPU
+task G3 "Greedy" 2 CPU
+task G4 "Greedy" 2 CPU
+)");
+        const auto light = test::loadProcess(R"(
+process Light "One task" 1
+task L1 "Light" 2 CPU
+)");
+        FairShareScheduler scheduler(machine, policy);
+        scheduler.addProcess(*greedy);
+        scheduler.addProcess(*light);
+        return scheduler.run();
+    }
+
+    /**
+     * @brief Checks that first-come lets the greedy process take both CPUs until its tasks have all started.
+     *
+     * Greedy runs G1 and G2 over [0, 2) and G3 and G4 over [2, 4), so Light runs over [4, 6).
+     */
+    void FairShareFirstComeFavoursGreedy() {
+        const auto report = shareTwoCpus(FairShareScheduler::Policy::FirstCome);
+        CHECK_EQUAL(std::int64_t{6}, report.makespan);
+        CHECK_EQUAL(std::size_t{2}, report.processes.size());
+        CHECK_EQUAL(std::int64_t{4}, report.processes[0].finishTime);
+        CHECK_EQUAL(std::int64_t{6}, report.processes[1].finishTime);
+        CHECK_EQUAL(std::size_t{4}, report.processes[0].completed);
+        CHECK_EQUAL(std::size_t{1}, report.processes[1].completed);
+    }
+
+    TEST(FairShareFirstComeFavoursGreedy);
+
+    /**
+     * @brief Checks that dominant resource fairness starts the light process's task alongside the greedy one.
+     *
+     * Greedy, tied at a zero share and added first, starts G1 at 0; Light, with the smaller share, starts L1 next
+     * and completes at 2. Greedy then runs G2 and G3 over [2, 4) and G4 over [4, 6).
+     */
+    void FairShareDominantResourceServesLight() {
+        const auto report = shareTwoCpus(FairShareScheduler::Policy::DominantResource);
+        CHECK_EQUAL(std::int64_t{6}, report.makespan);
+        CHECK_EQUAL(std::int64_t{6}, report.processes[0].finishTime);
+        CHECK_EQUAL(std::int64_t{2}, report.processes[1].finishTime);
+        CHECK_EQUAL(0.5, report.processes[1].peakShare);
+    }
+
+    TEST(FairShareDominantResourceServesLight);
+}
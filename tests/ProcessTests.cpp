@@ -0,0 +1,261 @@
+/**
+ * @file ProcessTests.cpp
+ * @brief Tests of sequential process execution: matching, plans, caching, incremental reruns and snapshots.
+ */
+
+#include "Test.h"
+#include "ExecutionPlan.h"
+#include "ResultCache.h"
+#include "Task.h"
+#include <string>
+#include <vector>
+
+namespace {
+    /// @brief Tasks that complete, lack a resource, run out of memory or follow a skipped task.
+    const char *const MixedScenario = R"(
+process Mixed "Mixed outcomes" 1
+usable CPU 3
+consumable Memory 2
+task Compile "Completes" 1 CPU Memory
+task Link "Completes after Compile" 1 CPU Memory
+after Compile
+task Render "Lacks a GPU" 1 GPU
+task Package "Finds no memory left" 1 CPU Memory
+task Publish "Follows a skipped task" 1 CPU
+after Render
+task Report "Completes" 1 CPU
+)";
+
+    /// @brief Sources compiled into objects, linked and packaged, with a task of its own on the side.
+    const char *const BuildScenario = R"(
+process Build "Incremental build" 1
+usable CPU 3
+task CompileMain "Compiles main.c" 1 CPU
+reads main.c
+writes main.o
+task CompileUtil "Compiles util.c" 1 CPU
+reads util.c
+writes util.o
+task Link "Links the objects" 1 CPU
+reads main.o util.o
+writes app
+task Document "Builds the manual" 1 CPU
+reads manual.md
+task Package "Packages the application" 1 CPU
+after Link
+)";
+
+    /**
+     * @brief Lists the tasks a captured simulation output reports executing.
+     * @param output The captured output.
+     * @return The names of the tasks that executed, in execution order.
+     */
+    std::vector<std::string> executedTasks(const test::CapturedOutput &output) {
+        const std::string text = output.text();
+        const std::string marker = "Executing task '";
+        std::vector<std::string> executed;
+        for (auto start = text.find(marker); start != std::string::npos; start = text.find(marker, start)) {
+            start += marker.size();
+            executed.push_back(text.substr(start, text.find(':', start) - start));
+        }
+        return executed;
+    }
+
+    /**
+     * @brief Runs a process with its output captured.
+     * @param process The process.
+     * @return The names of the tasks that executed, in execution order.
+     */
+    std::vector<std::string> runQuietly(Process &process) {
+        const test::CapturedOutput output;
+        process.run();
+        return executedTasks(output);
+    }
+
+    /**
+     * @brief Checks that name scans and bitmask matching complete the same tasks, and the expected ones.
+     */
+    void MatchingNamesAndBitmaskAgree() {
+        const std::vector<std::string> expected{"Compile", "Link", "Report"};
+        auto byName = test::loadProcess(MixedScenario);
+        byName->setRequirementMatching(Process::RequirementMatching::NameScan);
+        CHECK(runQuietly(*byName) == expected);
+
+        auto byMask = test::loadProcess(MixedScenario);
+        byMask->setRequirementMatching(Process::RequirementMatching::Bitmask);
+        CHECK(byMask->getRequirementMatching() == Process::RequirementMatching::Bitmask);
+        CHECK(runQuietly(*byMask) == expected);
+    }
+
+    TEST(MatchingNamesAndBitmaskAgree);
+
+    /**
+     * @brief Checks that uncompiled runs, which look dependencies up by name, agree with compiled ones.
+     */
+    void MatchingUncompiledAgreesWithPlan() {
+        auto process = test::loadProcess(MixedScenario);
+        const test::CapturedOutput output;
+        process->execute();
+        CHECK(process->getExecutionPlan() == nullptr);
+        CHECK((executedTasks(output) == std::vector<std::string>{"Compile", "Link", "Report"}));
+    }
+
+    TEST(MatchingUncompiledAgreesWithPlan);
+
+    /**
+     * @brief Checks the reason the plan gives for every task that can never run.
+     */
+    void ExecutionPlanReportsInfeasibility() {
+        const auto process = test::loadProcess(R"(
+process Plan "Infeasible tasks" 1
+usable CPU 3
+task Runs "Feasible" 1 CPU
+task NeedsGpu "Missing resource" 1 GPU
+task NeedsTwo "Too few units" 1 CPU CPU
+task AfterGpu "Follows an infeasible task" 1 CPU
+after NeedsGpu
+task AfterNothing "Follows an unknown task" 1 CPU
+after Nothing
+)");
+        const auto &plan = process->compile();
+        CHECK_EQUAL(std::size_t{5}, plan.getStepCount());
+        CHECK_EQUAL(std::size_t{4}, plan.getInfeasibleCount());
+        CHECK_EQUAL(std::string(), plan.getStep(0).infeasibility);
+        CHECK_EQUAL(std::string("requires missing resource 'GPU'"), plan.getStep(1).infeasibility);
+        CHECK_EQUAL(std::string("requires 2 units of 'CPU' but the pool has 1"), plan.getStep(2).infeasibility);
+        CHECK_EQUAL(std::string("depends on 'NeedsGpu', which can never run"), plan.getStep(3).infeasibility);
+        CHECK_EQUAL(std::string("depends on unknown task 'Nothing'"), plan.getStep(4).infeasibility);
+
+        const test::CapturedOutput output;
+        process->execute();
+        CHECK(output.contains("Task 'NeedsTwo' skipped: requires 2 units of 'CPU' but the pool has 1"));
+        CHECK((executedTasks(output) == std::vector<std::string>{"Runs"}));
+    }
+
+    TEST(ExecutionPlanReportsInfeasibility);
+
+    /**
+     * @brief Checks that adding a task discards the plan, so the next run resolves it again.
+     */
+    void ExecutionPlanDiscardedByChanges() {
+        auto process = test::loadProcess(BuildScenario);
+        process->compile();
+        CHECK(process->getExecutionPlan() != nullptr);
+        process->addTask(std::make_unique<Task>("Extra", "Added later", std::vector<std::string>{"CPU"}, 1));
+        CHECK(process->getExecutionPlan() == nullptr);
+        CHECK_EQUAL(std::size_t{6}, runQuietly(*process).size());
+        CHECK(process->getExecutionPlan() != nullptr);
+    }
+
+    TEST(ExecutionPlanDiscardedByChanges);
+
+    /**
+     * @brief Checks that a warm cache reports every unchanged task as up to date instead of running it.
+     */
+    void ResultCacheSkipsCompletedTasks() {
+        auto process = test::loadProcess(BuildScenario);
+        const auto cache = std::make_shared<ResultCache>();
+        process->setResultCache(cache);
+        CHECK_EQUAL(std::size_t{5}, runQuietly(*process).size());
+        CHECK_EQUAL(std::uint64_t{0}, cache->getHits());
+        CHECK_EQUAL(std::uint64_t{5}, cache->getMisses());
+        CHECK_EQUAL(std::size_t{5}, cache->size());
+
+        const test::CapturedOutput output;
+        process->run();
+        CHECK_EQUAL(std::uint64_t{5}, cache->getHits());
+        CHECK(output.contains("Task 'Link' up to date"));
+        CHECK(output.contains("Task 'Package' up to date"));
+        CHECK(executedTasks(output).empty());
+    }
+
+    TEST(ResultCacheSkipsCompletedTasks);
+
+    /**
+     * @brief Checks that a changed declaration misses the cache, and so do the tasks depending on it.
+     */
+    void ResultCacheKeysFollowDependencies() {
+        const auto cache = std::make_shared<ResultCache>();
+        auto original = test::loadProcess(BuildScenario);
+        original->setResultCache(cache);
+        runQuietly(*original);
+
+        std::string scenario = BuildScenario;
+        const std::string linkDuration = "\"Links the objects\" 1";
+        scenario.replace(scenario.find(linkDuration), linkDuration.size(), "\"Links the objects\" 2");
+        auto changed = test::loadProcess(scenario);
+        changed->setResultCache(cache);
+        runQuietly(*changed);
+        // CompileMain, CompileUtil and Document hit; the changed Link and Package, which depends on it, miss.
+        CHECK_EQUAL(std::uint64_t{3}, cache->getHits());
+        CHECK_EQUAL(std::uint64_t{7}, cache->getMisses());
+    }
+
+    TEST(ResultCacheKeysFollowDependencies);
+
+    /**
+     * @brief Checks the tasks rerunChanged() selects for changed inputs, and that it reuses the others.
+     */
+    void RerunSelectsDirtyTasks() {
+        auto process = test::loadProcess(BuildScenario);
+        {
+            const test::CapturedOutput output;
+            CHECK_EQUAL(std::size_t{5}, process->rerunChanged({"util.c"}));
+        }
+        {
+            // util.c dirties CompileUtil, Link reads its util.o, and Package depends on Link.
+            const test::CapturedOutput output;
+            CHECK_EQUAL(std::size_t{3}, process->rerunChanged({"util.c"}));
+            CHECK(output.contains("Task 'CompileMain' reused from the previous run"));
+            CHECK(output.contains("Task 'Document' reused from the previous run"));
+            CHECK((executedTasks(output) == std::vector<std::string>{"CompileUtil", "Link", "Package"}));
+        }
+        const test::CapturedOutput output;
+        CHECK_EQUAL(std::size_t{1}, process->rerunChanged({"manual.md"}));
+        CHECK_EQUAL(std::size_t{0}, process->rerunChanged({"unrelated.txt"}));
+        CHECK_EQUAL(std::size_t{4}, process->rerunChanged({"main.c", "util.c"}));
+        CHECK((process->getProducedOutputs() == std::vector<std::string>{"main.o", "util.o", "app"}));
+    }
+
+    TEST(RerunSelectsDirtyTasks);
+
+    /**
+     * @brief Checks that restoring a snapshot puts back consumed units, so a second run repeats the first.
+     */
+    void SnapshotRestoresConsumedUnits() {
+        auto process = test::loadProcess(R"(
+process Twice "Runs twice" 1
+usable CPU 3
+consumable Memory 2
+task First "Consumes memory" 1 CPU Memory
+task Second "Consumes memory" 1 CPU Memory
+)");
+        const std::vector<std::string> both{"First", "Second"};
+        process->compile();
+        const auto initial = process->snapshot();
+        CHECK(runQuietly(*process) == both);
+        CHECK((process->snapshot().completedTasks == std::vector<char>{1, 1}));
+        CHECK(runQuietly(*process).empty());
+
+        process->restore(initial);
+        CHECK(process->getExecutionPlan() != nullptr);
+        CHECK(runQuietly(*process) == both);
+        const auto afterRun = process->snapshot();
+        process->restore(initial);
+        process->restore(afterRun);
+        CHECK(runQuietly(*process).empty());
+    }
+
+    TEST(SnapshotRestoresConsumedUnits);
+
+    /**
+     * @brief Checks that a snapshot of another process is refused.
+     */
+    void SnapshotRejectsOtherProcess() {
+        auto process = test::loadProcess(BuildScenario);
+        const auto other = test::loadProcess(MixedScenario);
+        CHECK_THROWS(process->restore(other->snapshot()), std::invalid_argument);
+    }
+
+    TEST(SnapshotRejectsOtherProcess);
+}
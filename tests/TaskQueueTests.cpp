@@ -0,0 +1,198 @@
+/**
+ * @file TaskQueueTests.cpp
+ * @brief Tests of the TaskQueue ring: ordering, backpressure policies and closing.
+ */
+
+#include "Test.h"
+#include "Task.h"
+#include "TaskQueue.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    /// @brief How long a test lets another thread run into a wait before checking it is still waiting.
+    constexpr std::chrono::milliseconds SettleTime{50};
+
+    /**
+     * @brief Builds a task to submit.
+     * @param name Name of the task.
+     * @return The task.
+     */
+    std::unique_ptr<Executable> makeTask(const std::string &name) {
+        return std::make_unique<Task>(name, "Submitted task", std::vector<std::string>{"CPU"}, 1);
+    }
+
+    /**
+     * @brief Fills a queue to its capacity with tasks named after their position.
+     * @param queue The queue, empty.
+     */
+    void fill(TaskQueue &queue) {
+        for (std::size_t index = 0; index < queue.getCapacity(); ++index) {
+            auto task = makeTask("Task" + std::to_string(index));
+            test::check(queue.push(task), "push into a queue with room", __FILE__, __LINE__);
+        }
+    }
+
+    /**
+     * @brief Checks that the capacity rounds up to a power of two and tasks come out in submission order.
+     */
+    void TaskQueueKeepsSubmissionOrder() {
+        TaskQueue queue(3);
+        CHECK_EQUAL(std::size_t{4}, queue.getCapacity());
+        fill(queue);
+        std::unique_ptr<Executable> task;
+        for (std::size_t index = 0; index < queue.getCapacity(); ++index) {
+            CHECK(queue.tryPop(task));
+            CHECK_EQUAL("Task" + std::to_string(index), task->getName());
+        }
+        CHECK(!queue.tryPop(task));
+    }
+
+    TEST(TaskQueueKeepsSubmissionOrder);
+
+    /**
+     * @brief Checks that a full Reject queue throws and leaves the task with the caller.
+     */
+    void TaskQueueRejectsWhenFull() {
+        TaskQueue queue(2, TaskQueue::Backpressure::Reject);
+        fill(queue);
+        auto task = makeTask("Rejected");
+        CHECK_THROWS(queue.push(task), std::runtime_error);
+        CHECK(task != nullptr);
+        CHECK_EQUAL(std::uint64_t{0}, queue.getDroppedCount());
+    }
+
+    TEST(TaskQueueRejectsWhenFull);
+
+    /**
+     * @brief Checks that a full Drop queue discards the task and counts it.
+     */
+    void TaskQueueDropsWhenFull() {
+        TaskQueue queue(2, TaskQueue::Backpressure::Drop);
+        fill(queue);
+        auto task = makeTask("Dropped");
+        CHECK(!queue.push(task));
+        CHECK(task == nullptr);
+        CHECK_EQUAL(std::uint64_t{1}, queue.getDroppedCount());
+    }
+
+    TEST(TaskQueueDropsWhenFull);
+
+    /**
+     * @brief Checks that a full Block queue holds the producer back until a consumer frees a cell.
+     */
+    void TaskQueueBlocksWhenFull() {
+        TaskQueue queue(2, TaskQueue::Backpressure::Block);
+        fill(queue);
+        std::atomic<bool> pushed{false};
+        std::thread producer([&queue, &pushed] {
+            auto task = makeTask("Blocked");
+            pushed = queue.push(task);
+        });
+        std::this_thread::sleep_for(SettleTime);
+        CHECK(!pushed);
+        std::unique_ptr<Executable> task;
+        CHECK(queue.tryPop(task));
+        producer.join();
+        CHECK(pushed);
+        for (const auto *name: {"Task1", "Blocked"}) {
+            CHECK(queue.tryPop(task));
+            CHECK_EQUAL(std::string(name), task->getName());
+        }
+    }
+
+    TEST(TaskQueueBlocksWhenFull);
+
+    /**
+     * @brief Checks that closing refuses new tasks, wakes a blocked producer and lets consumers drain the rest.
+     */
+    void TaskQueueCloseDrainsQueuedTasks() {
+        TaskQueue queue(2, TaskQueue::Backpressure::Block);
+        fill(queue);
+        std::atomic<bool> refused{false};
+        std::thread producer([&queue, &refused] {
+            auto task = makeTask("Blocked");
+            try {
+                queue.push(task);
+            } catch (const std::logic_error &) {
+                refused = true;
+            }
+        });
+        std::this_thread::sleep_for(SettleTime);
+        queue.close();
+        producer.join();
+        CHECK(refused);
+        CHECK(queue.isClosed());
+
+        auto late = makeTask("Late");
+        CHECK_THROWS(queue.push(late), std::logic_error);
+        std::unique_ptr<Executable> task;
+        CHECK(queue.pop(task));
+        CHECK_EQUAL(std::string("Task0"), task->getName());
+        CHECK(queue.pop(task));
+        CHECK_EQUAL(std::string("Task1"), task->getName());
+        CHECK(!queue.pop(task));
+    }
+
+    TEST(TaskQueueCloseDrainsQueuedTasks);
+
+    /**
+     * @brief Checks that a consumer waiting on an empty queue receives a task pushed later, then returns on close.
+     */
+    void TaskQueuePopWaitsForTasks() {
+        TaskQueue queue(4);
+        std::atomic<int> received{0};
+        std::atomic<bool> finished{false};
+        std::thread consumer([&queue, &received, &finished] {
+            std::unique_ptr<Executable> task;
+            while (queue.pop(task)) ++received;
+            finished = true;
+        });
+        std::this_thread::sleep_for(SettleTime);
+        CHECK(!finished);
+        auto task = makeTask("Late");
+        CHECK(queue.push(task));
+        std::this_thread::sleep_for(SettleTime);
+        CHECK_EQUAL(1, received.load());
+        CHECK(!finished);
+        queue.close();
+        consumer.join();
+        CHECK(finished);
+    }
+
+    TEST(TaskQueuePopWaitsForTasks);
+
+    /**
+     * @brief Checks that tasks from several producers all reach several consumers exactly once.
+     */
+    void TaskQueueDeliversEveryTaskOnce() {
+        constexpr int ProducerCount = 4;
+        constexpr int TasksPerProducer = 2000;
+        TaskQueue queue(8);
+        std::atomic<int> received{0};
+        std::vector<std::thread> consumers;
+        for (int consumer = 0; consumer < 2; ++consumer) {
+            consumers.emplace_back([&queue, &received] {
+                std::unique_ptr<Executable> task;
+                while (queue.pop(task)) ++received;
+            });
+        }
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < ProducerCount; ++producer) {
+            producers.emplace_back([&queue] {
+                for (int index = 0; index < TasksPerProducer; ++index) {
+                    auto task = makeTask("Task");
+                    queue.push(task);
+                }
+            });
+        }
+        for (auto &producer: producers) producer.join();
+        queue.close();
+        for (auto &consumer: consumers) consumer.join();
+        CHECK_EQUAL(ProducerCount * TasksPerProducer, received.load());
+    }
+
+    TEST(TaskQueueDeliversEveryTaskOnce);
+}
@@ -0,0 +1,143 @@
+#include "Test.h"
+#include "ScenarioLoader.h"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace test {
+    namespace {
+        /**
+         * @brief A registered test function.
+         */
+        struct Registration {
+            std::string name; ///< Name of the test function.
+            std::function<void()> function; ///< The test function.
+        };
+
+        /**
+         * @brief Retrieves the registry of tests.
+         * @return The registered tests in registration order.
+         */
+        std::vector<Registration> &registry() {
+            static std::vector<Registration> registrations;
+            return registrations;
+        }
+    }
+
+    /**
+     * @brief Constructs a failure.
+     * @param message Location and description of the failed check.
+     */
+    Failure::Failure(const std::string &message) : std::runtime_error(message) {}
+
+    /**
+     * @brief Starts capturing std::cout.
+     */
+    CapturedOutput::CapturedOutput() : previous(std::cout.rdbuf(buffer.rdbuf())) {}
+
+    /**
+     * @brief Stops capturing and restores std::cout.
+     */
+    CapturedOutput::~CapturedOutput() {
+        std::cout.rdbuf(previous);
+    }
+
+    /**
+     * @brief Retrieves the output captured so far.
+     * @return The captured text.
+     */
+    std::string CapturedOutput::text() const {
+        return buffer.str();
+    }
+
+    /**
+     * @brief Checks whether the captured output contains a text.
+     * @param fragment The text to look for.
+     * @return True if it occurs in the captured output.
+     */
+    bool CapturedOutput::contains(const std::string &fragment) const {
+        return buffer.str().find(fragment) != std::string::npos;
+    }
+
+    /**
+     * @brief Registers a test function.
+     * @param name Name of the test.
+     * @param function The test function.
+     * @return True, so the registration can initialise a static.
+     */
+    bool registerTest(const std::string &name, std::function<void()> function) {
+        registry().push_back(Registration{name, std::move(function)});
+        return true;
+    }
+
+    /**
+     * @brief Runs all registered tests matching the command-line filter.
+     * @param argc Number of command-line arguments.
+     * @param argv Command-line arguments: --filter SUBSTRING.
+     * @return 0 if every test passed, 1 on invalid arguments or a failing test.
+     */
+    int runRegistered(const int argc, char *argv[]) {
+        std::string filter;
+        for (int index = 1; index < argc; ++index) {
+            const std::string argument = argv[index];
+            if (argument == "--filter" && index + 1 < argc) {
+                filter = argv[++index];
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--filter SUBSTRING]\n";
+                return 1;
+            }
+        }
+
+        std::size_t run = 0;
+        std::size_t failed = 0;
+        for (const auto &registration: registry()) {
+            if (!filter.empty() && registration.name.find(filter) == std::string::npos) continue;
+            ++run;
+            try {
+                registration.function();
+                std::cout << "[  OK  ] " << registration.name << "\n";
+            } catch (const std::exception &e) {
+                ++failed;
+                std::cout << "[ FAIL ] " << registration.name << ": " << e.what() << "\n";
+            }
+        }
+        std::cout << run - failed << " of " << run << " tests passed\n";
+        return failed == 0 && run > 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Throws a Failure if a condition does not hold.
+     * @param condition The checked condition.
+     * @param expression Source text of the condition.
+     * @param file Source file of the check.
+     * @param line Source line of the check.
+     * @throw Failure If condition is false.
+     */
+    void check(const bool condition, const char *expression, const char *file, const int line) {
+        if (!condition) throw Failure(std::string(file) + ":" + std::to_string(line) + ": " + expression);
+    }
+
+    /**
+     * @brief Loads the single process a scenario text declares.
+     * @param scenario Scenario directives, one per line.
+     * @return The process.
+     * @throw Failure If the scenario does not declare exactly one process.
+     */
+    std::unique_ptr<Process> loadProcess(const std::string &scenario) {
+        std::istringstream input(scenario);
+        auto processes = ScenarioLoader::loadStream(input, "test scenario");
+        if (processes.size() != 1) throw Failure("Test scenario declares " + std::to_string(processes.size()) +
+                                                 " processes instead of one");
+        return std::move(processes.front());
+    }
+}
+
+/**
+ * @brief Entry point of the test executable.
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments (see test::runRegistered).
+ * @return 0 if every test passed, 1 otherwise.
+ */
+int main(const int argc, char *argv[]) {
+    return test::runRegistered(argc, argv);
+}
@@ -0,0 +1,140 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include "Process.h"
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Minimal test harness in the manner of the benchmark one.
+ *
+ * Tests are functions without arguments that register themselves with the TEST macro. A failing CHECK throws a
+ * Failure, which ends the test; the runner reports every test and exits with 1 if any failed. Tests build their
+ * processes from scenario text, so they exercise the same declarations as scenario files.
+ */
+namespace test {
+    /**
+     * @brief Raised by a failing check, ending the test that made it.
+     */
+    class Failure : public std::runtime_error {
+    public:
+        /**
+         * @brief Constructs a failure.
+         * @param message Location and description of the failed check.
+         */
+        explicit Failure(const std::string &message);
+    };
+
+    /**
+     * @brief Redirects std::cout into a buffer while it lives, so tests can silence or inspect simulation output.
+     */
+    class CapturedOutput {
+    private:
+        std::ostringstream buffer; ///< Output written since construction.
+        std::streambuf *previous; ///< Buffer std::cout wrote to before, put back on destruction.
+    public:
+        /**
+         * @brief Starts capturing std::cout.
+         */
+        CapturedOutput();
+
+        /**
+         * @brief Stops capturing and restores std::cout.
+         */
+        ~CapturedOutput();
+
+        CapturedOutput(const CapturedOutput &) = delete;
+        CapturedOutput &operator=(const CapturedOutput &) = delete;
+
+        /**
+         * @brief Retrieves the output captured so far.
+         * @return The captured text.
+         */
+        [[nodiscard]] std::string text() const;
+
+        /**
+         * @brief Checks whether the captured output contains a text.
+         * @param fragment The text to look for.
+         * @return True if it occurs in the captured output.
+         */
+        [[nodiscard]] bool contains(const std::string &fragment) const;
+    };
+
+    /**
+     * @brief Registers a test function.
+     * @param name Name of the test.
+     * @param function The test function.
+     * @return True, so the registration can initialise a static.
+     */
+    bool registerTest(const std::string &name, std::function<void()> function);
+
+    /**
+     * @brief Runs all registered tests matching the command-line filter.
+     * @param argc Number of command-line arguments.
+     * @param argv Command-line arguments: --filter SUBSTRING.
+     * @return 0 if every test passed, 1 on invalid arguments or a failing test.
+     */
+    int runRegistered(int argc, char *argv[]);
+
+    /**
+     * @brief Throws a Failure if a condition does not hold.
+     * @param condition The checked condition.
+     * @param expression Source text of the condition.
+     * @param file Source file of the check.
+     * @param line Source line of the check.
+     * @throw Failure If condition is false.
+     */
+    void check(bool condition, const char *expression, const char *file, int line);
+
+    /**
+     * @brief Throws a Failure showing both values if they differ.
+     * @param expected The expected value.
+     * @param actual The actual value.
+     * @param expression Source text of the actual value.
+     * @param file Source file of the check.
+     * @param line Source line of the check.
+     * @throw Failure If the values differ.
+     */
+    template<typename Expected, typename Actual>
+    void checkEqual(const Expected &expected, const Actual &actual, const char *expression, const char *file,
+                    const int line) {
+        if (expected == actual) return;
+        std::ostringstream message;
+        message << file << ":" << line << ": " << expression << " is " << actual << ", expected " << expected;
+        throw Failure(message.str());
+    }
+
+    /**
+     * @brief Loads the single process a scenario text declares.
+     * @param scenario Scenario directives, one per line.
+     * @return The process.
+     * @throw Failure If the scenario does not declare exactly one process.
+     */
+    std::unique_ptr<Process> loadProcess(const std::string &scenario);
+}
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+/// @brief Registers a test function.
+#define TEST(function) \
+    static const bool TEST_CONCAT(testRegistration, __LINE__) = test::registerTest(#function, function)
+
+/// @brief Ends the test with a failure if the condition does not hold.
+#define CHECK(condition) test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+/// @brief Ends the test with a failure showing both values if actual differs from expected.
+#define CHECK_EQUAL(expected, actual) test::checkEqual((expected), (actual), #actual, __FILE__, __LINE__)
+
+/// @brief Ends the test with a failure unless the statement throws the given exception type.
+#define CHECK_THROWS(statement, Exception) \
+    do { \
+        bool thrown = false; \
+        try { statement; } catch (const Exception &) { thrown = true; } \
+        test::check(thrown, #statement " throws " #Exception, __FILE__, __LINE__); \
+    } while (false)
+
+#endif //TEST_H